@@ -7,8 +7,16 @@
       "sources": [
         "src/cpp/faiss_index.cpp",
         "src/cpp/faiss_binary_index.cpp",
+        "src/cpp/faiss_replica_set.cpp",
+        "src/cpp/faiss_sharded_index.cpp",
         "src/cpp/napi_bindings.cpp",
-        "src/cpp/napi_binary_bindings.cpp"
+        "src/cpp/napi_binary_bindings.cpp",
+        "src/cpp/vector_file_reader.cpp",
+        "src/cpp/ingest_pipeline.cpp",
+        "src/cpp/vector_kernels.cpp",
+        "src/cpp/napi_utility_bindings.cpp",
+        "src/cpp/distance_kernels.cpp",
+        "src/cpp/executor.cpp"
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")",
@@ -35,7 +43,9 @@
             "OTHER_CPLUSPLUSFLAGS": [
               "-std=c++17",
               "-fexceptions",
-              "-frtti"
+              "-frtti",
+              "-Xpreprocessor",
+              "-fopenmp"
             ],
             "OTHER_LDFLAGS": [
               "-headerpad_max_install_names"
@@ -48,8 +58,11 @@
             "-L/usr/local/opt/faiss/lib",
             "-L/opt/homebrew/opt/openblas/lib",
             "-L/usr/local/opt/openblas/lib",
+            "-L/opt/homebrew/opt/libomp/lib",
+            "-L/usr/local/opt/libomp/lib",
             "-lfaiss",
             "-lopenblas",
+            "-lomp",
           ],
           "ldflags": [
             "-L/opt/homebrew/lib",
@@ -62,6 +75,8 @@
             "-Wl,-rpath,/usr/local/opt/faiss/lib",
             "-Wl,-rpath,/opt/homebrew/opt/openblas/lib",
             "-Wl,-rpath,/usr/local/opt/openblas/lib",
+            "-Wl,-rpath,/opt/homebrew/opt/libomp/lib",
+            "-Wl,-rpath,/usr/local/opt/libomp/lib",
             "-headerpad_max_install_names"
           ]
         }],
@@ -125,7 +140,8 @@
               "ExceptionHandling": 1,
               "AdditionalOptions": [
                 "/std:c++17",
-                "/EHsc"
+                "/EHsc",
+                "/openmp:llvm"
               ]
             }
           },
@@ -145,7 +161,8 @@
           ],
           "cflags_cc": [
             "/std:c++17",
-            "/EHsc"
+            "/EHsc",
+            "/openmp:llvm"
           ],
           "conditions": [
             ["target_arch=='x64'", {
@@ -0,0 +1,80 @@
+/**
+ * Concurrent Search Benchmark
+ *
+ * Measures search throughput (QPS) on a single index while 1..32 searches are
+ * in flight at once. Reads share the index lock, so throughput should scale
+ * with the libuv pool size until the CPU is saturated. Each level runs once
+ * with one worker per search and once with search coalescing enabled, which
+ * merges concurrent queries into a single batched FAISS call.
+ *
+ * Usage:
+ *   UV_THREADPOOL_SIZE=16 node examples/concurrent-search-benchmark.js
+ */
+
+const { FaissIndex } = require('../src/js/index');
+
+const DIMS = 768;
+const VECTOR_COUNT = 20000;
+const QUERIES_PER_LEVEL = 2000;
+const K = 10;
+const CONCURRENCY_LEVELS = [1, 2, 4, 8, 16, 32];
+
+function randomVectors(count, dims) {
+  const vectors = new Float32Array(count * dims);
+  for (let i = 0; i < vectors.length; i++) {
+    vectors[i] = Math.random();
+  }
+  return vectors;
+}
+
+async function runLevel(index, queries, concurrency) {
+  let next = 0;
+
+  async function client() {
+    while (next < QUERIES_PER_LEVEL) {
+      const q = next++;
+      await index.search(queries.subarray(q * DIMS, (q + 1) * DIMS), K);
+    }
+  }
+
+  const start = process.hrtime.bigint();
+  await Promise.all(Array.from({ length: concurrency }, client));
+  const elapsedMs = Number(process.hrtime.bigint() - start) / 1e6;
+  return (QUERIES_PER_LEVEL / elapsedMs) * 1000;
+}
+
+async function main() {
+  console.log('Concurrent Search Benchmark');
+  console.log('='.repeat(60));
+  console.log(`UV_THREADPOOL_SIZE: ${process.env.UV_THREADPOOL_SIZE || '4 (default)'}`);
+  console.log(`Index: FLAT_L2, ${VECTOR_COUNT} vectors, ${DIMS}d, k=${K}\n`);
+
+  const index = new FaissIndex({ type: 'FLAT_L2', dims: DIMS });
+  await index.add(randomVectors(VECTOR_COUNT, DIMS));
+  const queries = randomVectors(QUERIES_PER_LEVEL, DIMS);
+
+  // Warm up caches and the thread pool
+  await runLevel(index, queries, 4);
+
+  for (const coalesce of [false, { maxBatchSize: 64, windowMs: 1 }]) {
+    index.setSearchCoalescing(coalesce);
+    console.log(coalesce ? `\nCoalesced (${JSON.stringify(coalesce)}):` : 'Per-query workers:');
+
+    let baseline = null;
+    for (const concurrency of CONCURRENCY_LEVELS) {
+      const qps = await runLevel(index, queries, concurrency);
+      baseline = baseline || qps;
+      console.log(
+        `  concurrency ${String(concurrency).padStart(2)}: ` +
+        `${qps.toFixed(0).padStart(8)} QPS  (${(qps / baseline).toFixed(2)}x)`
+      );
+    }
+  }
+
+  index.dispose();
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,95 @@
+/**
+ * Vector Validation Benchmark
+ *
+ * Compares the addon's vectorized NaN/Infinity scan and L2 normalization with
+ * the plain JS loops they replace, on a searchBatch-sized input of 10k 768-d
+ * queries. Also reports how long searchBatch holds the event loop before it is
+ * queued, with validation on the calling thread and with validateInWorker.
+ *
+ * Usage:
+ *   node examples/validation-benchmark.js
+ */
+
+const { FaissIndex, validateVectors, normalizeVectors } = require('../src/js/index');
+const native = require('../src/js/native');
+
+const DIMS = 768;
+const COUNT = 10000;
+const ROUNDS = 20;
+
+function randomVectors(count, dims) {
+  const vectors = new Float32Array(count * dims);
+  for (let i = 0; i < vectors.length; i++) {
+    vectors[i] = Math.random() - 0.5;
+  }
+  return vectors;
+}
+
+function jsFindNonFinite(vectors) {
+  for (let i = 0; i < vectors.length; i++) {
+    if (!Number.isFinite(vectors[i])) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+function jsNormalize(vectors, dims) {
+  const normalized = new Float32Array(vectors.length);
+  for (let offset = 0; offset < vectors.length; offset += dims) {
+    let norm = 0;
+    for (let j = 0; j < dims; j++) {
+      norm += vectors[offset + j] * vectors[offset + j];
+    }
+    norm = Math.sqrt(norm);
+    for (let j = 0; norm > 0 && j < dims; j++) {
+      normalized[offset + j] = vectors[offset + j] / norm;
+    }
+  }
+  return normalized;
+}
+
+function time(fn) {
+  fn();
+  const start = process.hrtime.bigint();
+  for (let i = 0; i < ROUNDS; i++) {
+    fn();
+  }
+  return Number(process.hrtime.bigint() - start) / 1e6 / ROUNDS;
+}
+
+function report(label, jsMs, nativeMs) {
+  console.log(`${label.padEnd(28)} js ${jsMs.toFixed(2).padStart(8)} ms   native ${nativeMs.toFixed(2).padStart(8)} ms   ${(jsMs / nativeMs).toFixed(1)}x`);
+}
+
+async function main() {
+  console.log('Vector Validation Benchmark');
+  console.log('='.repeat(60));
+  console.log(`Input: ${COUNT} vectors, ${DIMS}d (${(COUNT * DIMS / 1e6).toFixed(1)}M floats)`);
+  console.log(`Kernels: ${native.vectorKernels.simdLevel()}\n`);
+
+  const vectors = randomVectors(COUNT, DIMS);
+  const { vectorKernels } = native;
+
+  report('finite check', time(() => jsFindNonFinite(vectors)), time(() => vectorKernels.findNonFinite(vectors)));
+  report('normalize', time(() => jsNormalize(vectors, DIMS)), time(() => normalizeVectors(vectors, DIMS)));
+  console.log(`${'validateVectors report'.padEnd(28)} ${time(() => validateVectors(vectors, DIMS)).toFixed(2)} ms`);
+
+  const index = new FaissIndex({ type: 'FLAT_L2', dims: DIMS });
+  await index.add(randomVectors(100, DIMS));
+  const pending = [];
+  console.log('\nsearchBatch time on the calling thread before the promise is returned:');
+  for (const validateInWorker of [false, true]) {
+    const ms = time(() => {
+      pending.push(index.searchBatch(vectors, 1, { validateInWorker, borrow: true }));
+    });
+    console.log(`  validateInWorker=${validateInWorker}: ${ms.toFixed(2)} ms`);
+  }
+  await Promise.all(pending);
+  index.dispose();
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
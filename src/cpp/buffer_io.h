@@ -0,0 +1,44 @@
+#ifndef FAISS_NODE_BUFFER_IO_H
+#define FAISS_NODE_BUFFER_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <faiss/impl/io.h>
+
+/**
+ * Non-owning FAISS reader over a caller-provided byte range.
+ * Unlike faiss::VectorIOReader it does not copy the serialized index first,
+ * so deserializing holds one copy of the bytes instead of two.
+ * The memory must stay valid and unchanged until read_index returns.
+ */
+struct BufferIOReader : faiss::IOReader {
+    BufferIOReader(const uint8_t* data, size_t length)
+        : data_(data), length_(length) {}
+
+    size_t operator()(void* ptr, size_t size, size_t nitems) override {
+        if (size == 0 || position_ >= length_) {
+            return 0;
+        }
+
+        size_t available = (length_ - position_) / size;
+        if (available < nitems) {
+            nitems = available;
+        }
+
+        size_t bytes = size * nitems;
+        if (bytes > 0) {
+            memcpy(ptr, data_ + position_, bytes);
+            position_ += bytes;
+        }
+        return nitems;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t length_;
+    size_t position_ = 0;
+};
+
+#endif // FAISS_NODE_BUFFER_IO_H
@@ -0,0 +1,115 @@
+#include "distance_kernels.h"
+
+#include "parallel_for.h"
+
+#include <faiss/utils/distances.h>
+#include <faiss/utils/hamming.h>
+
+#include <stdexcept>
+#include <vector>
+
+DistanceMetric ParseDistanceMetric(const std::string& name) {
+    if (name == "l2") {
+        return DistanceMetric::L2;
+    }
+    if (name == "ip") {
+        return DistanceMetric::InnerProduct;
+    }
+    if (name == "cosine") {
+        return DistanceMetric::Cosine;
+    }
+    throw std::invalid_argument("metric must be one of: l2, ip, cosine");
+}
+
+namespace {
+
+// Cosine is the inner product of normalized copies; fvec_renorm_L2 leaves zero vectors
+// at zero, so their similarity comes out as 0. x and y are repointed at the copies.
+void NormalizeForCosine(
+    const float*& x, size_t n, const float*& y, size_t m, size_t d,
+    std::vector<float>& xNormalized, std::vector<float>& yNormalized) {
+    xNormalized.assign(x, x + n * d);
+    yNormalized.assign(y, y + m * d);
+    faiss::fvec_renorm_L2(d, n, xNormalized.data());
+    faiss::fvec_renorm_L2(d, m, yNormalized.data());
+    x = xNormalized.data();
+    y = yNormalized.data();
+}
+
+} // namespace
+
+void PairwiseDistances(
+    const float* x, size_t n, const float* y, size_t m, size_t d, DistanceMetric metric, float* out) {
+    if (n == 0 || m == 0) {
+        return;
+    }
+
+    // Large L2 matrices go through BLAS, like a flat index search does; below FAISS's
+    // own threshold the SIMD row kernels win.
+    const bool blas = n >= static_cast<size_t>(faiss::distance_compute_blas_threshold);
+    if (metric == DistanceMetric::L2) {
+        if (blas) {
+            faiss::pairwise_L2sqr(
+                static_cast<int64_t>(d), static_cast<int64_t>(n), x, static_cast<int64_t>(m), y, out);
+        } else {
+            ParallelFor(n, true, [&](size_t i) {
+                faiss::fvec_L2sqr_ny(out + i * m, x + i * d, y, d, m);
+            });
+        }
+        return;
+    }
+
+    std::vector<float> xNormalized;
+    std::vector<float> yNormalized;
+    if (metric == DistanceMetric::Cosine) {
+        NormalizeForCosine(x, n, y, m, d, xNormalized, yNormalized);
+    }
+
+    ParallelFor(n, true, [&](size_t i) {
+        faiss::fvec_inner_products_ny(out + i * m, x + i * d, y, d, m);
+    });
+}
+
+void KnnSearch(
+    const float* x, size_t n, const float* y, size_t m, size_t d, size_t k, DistanceMetric metric,
+    float* distances, int64_t* labels) {
+    if (k == 0 || k > m) {
+        throw std::invalid_argument("k must be between 1 and the number of database vectors");
+    }
+
+    if (metric == DistanceMetric::L2) {
+        faiss::knn_L2sqr(x, y, d, n, m, k, distances, labels);
+        return;
+    }
+
+    std::vector<float> xNormalized;
+    std::vector<float> yNormalized;
+    if (metric == DistanceMetric::Cosine) {
+        NormalizeForCosine(x, n, y, m, d, xNormalized, yNormalized);
+    }
+    faiss::knn_inner_product(x, y, d, n, m, k, distances, labels);
+}
+
+void HammingDistances(
+    const uint8_t* a, size_t na, const uint8_t* b, size_t nb, size_t code_size, int32_t* out) {
+    // HammingComputerDefault popcounts 8 bytes at a time, so any code size works
+    ParallelFor(na, true, [&](size_t i) {
+        faiss::HammingComputerDefault computer(a + i * code_size, static_cast<int>(code_size));
+        int32_t* row = out + i * nb;
+        for (size_t j = 0; j < nb; j++) {
+            row[j] = computer.hamming(b + j * code_size);
+        }
+    });
+}
+
+void HammingKnn(
+    const uint8_t* a, size_t na, const uint8_t* b, size_t nb, size_t code_size, size_t k,
+    int32_t* distances, int64_t* labels) {
+    if (k == 0 || k > nb) {
+        throw std::invalid_argument("k must be between 1 and the number of database codes");
+    }
+
+    // The same heap search IndexBinaryFlat runs, without copying the codes into an index
+    faiss::int_maxheap_array_t heaps = {na, k, labels, distances};
+    faiss::hammings_knn_hc(&heaps, a, b, nb, code_size, /* ordered */ 1);
+}
@@ -0,0 +1,46 @@
+#ifndef FAISS_NODE_DISTANCE_KERNELS_H
+#define FAISS_NODE_DISTANCE_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Index-free distance computations over caller-supplied arrays, built on the FAISS
+ * distance utilities. They run on whatever thread calls them; the N-API layer
+ * schedules them on a worker.
+ */
+
+enum class DistanceMetric {
+    L2,            // squared Euclidean distance
+    InnerProduct,
+    Cosine,        // inner product of the L2-normalized vectors; 0 against a zero vector
+};
+
+// Parses 'l2', 'ip' or 'cosine'; throws std::invalid_argument otherwise
+DistanceMetric ParseDistanceMetric(const std::string& name);
+
+// Writes the dense n x m matrix of distances between the rows of x (n x d) and the
+// rows of y (m x d) to out, row-major: out[i * m + j] = distance(x_i, y_j).
+void PairwiseDistances(
+    const float* x, size_t n, const float* y, size_t m, size_t d, DistanceMetric metric, float* out);
+
+// Exact k nearest rows of y (m x d) for each row of x (n x d), best first: ascending
+// for L2, descending for the similarity metrics. distances and labels hold n * k entries;
+// labels are row numbers in y, and k must not exceed m.
+void KnnSearch(
+    const float* x, size_t n, const float* y, size_t m, size_t d, size_t k, DistanceMetric metric,
+    float* distances, int64_t* labels);
+
+// Dense na x nb matrix of Hamming distances between binary codes of code_size bytes,
+// row-major like PairwiseDistances.
+void HammingDistances(
+    const uint8_t* a, size_t na, const uint8_t* b, size_t nb, size_t code_size, int32_t* out);
+
+// k nearest codes of b for each code of a, by ascending Hamming distance; k must not
+// exceed nb.
+void HammingKnn(
+    const uint8_t* a, size_t na, const uint8_t* b, size_t nb, size_t code_size, size_t k,
+    int32_t* distances, int64_t* labels);
+
+#endif // FAISS_NODE_DISTANCE_KERNELS_H
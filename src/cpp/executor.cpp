@@ -0,0 +1,113 @@
+#include "executor.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+thread_local ExecutorLane current_lane = ExecutorLane::Interactive;
+
+// Lane size from the environment, else the given default.
+size_t LaneSizeFromEnv(const char* name, size_t fallback) {
+    const char* value = std::getenv(name);
+    if (value == nullptr) {
+        return fallback;
+    }
+    const long parsed = std::strtol(value, nullptr, 10);
+    return parsed > 0 ? static_cast<size_t>(std::min(parsed, 4096L)) : fallback;
+}
+
+} // namespace
+
+Executor& Executor::Instance() {
+    static Executor* instance = new Executor();
+    return *instance;
+}
+
+Executor::Executor() {
+    // Each FAISS call fans out over OpenMP on its own, so a handful of lane threads
+    // is enough to keep independent requests from queueing behind one another.
+    const size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    GetLane(ExecutorLane::Interactive).target =
+        LaneSizeFromEnv("FAISS_NODE_INTERACTIVE_THREADS", std::min<size_t>(std::max<size_t>(cores / 2, 2), 8));
+    GetLane(ExecutorLane::Background).target = LaneSizeFromEnv("FAISS_NODE_BACKGROUND_THREADS", 2);
+}
+
+void Executor::Submit(ExecutorLane which, std::function<void()> task, std::function<void()> then) {
+    Lane& lane = GetLane(which);
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    lane.tasks.push_back(Task{std::move(task), std::move(then), Clock::now()});
+    MaybeStartThread(lane);
+    lane.ready.notify_one();
+}
+
+void Executor::Resize(ExecutorLane which, size_t threads) {
+    Lane& lane = GetLane(which);
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    lane.target = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < lane.tasks.size(); i++) {
+        MaybeStartThread(lane);
+    }
+    lane.ready.notify_all();
+}
+
+ExecutorLane Executor::CurrentLane() {
+    return current_lane;
+}
+
+ExecutorLaneStats Executor::Stats(ExecutorLane which) {
+    Lane& lane = GetLane(which);
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    ExecutorLaneStats stats;
+    stats.threads = lane.target;
+    stats.started = lane.started;
+    stats.queued = lane.tasks.size();
+    stats.running = lane.running;
+    stats.completed = lane.completed;
+    stats.totalWaitMs = lane.total_wait_ms;
+    stats.maxWaitMs = lane.max_wait_ms;
+    return stats;
+}
+
+void Executor::MaybeStartThread(Lane& lane) {
+    const size_t idle = lane.started - lane.running;
+    if (lane.started >= lane.target || idle >= lane.tasks.size()) {
+        return;
+    }
+    lane.started++;
+    std::thread([this, &lane] { Run(lane); }).detach();
+}
+
+void Executor::Run(Lane& lane) {
+    current_lane = static_cast<ExecutorLane>(&lane - lanes_);
+    std::unique_lock<std::mutex> lock(lane.mutex);
+    for (;;) {
+        lane.ready.wait(lock, [&] { return lane.started > lane.target || !lane.tasks.empty(); });
+        if (lane.started > lane.target) {
+            lane.started--;
+            return;
+        }
+
+        Task task = std::move(lane.tasks.front());
+        lane.tasks.pop_front();
+        const double wait_ms =
+            std::chrono::duration<double, std::milli>(Clock::now() - task.enqueued).count();
+        lane.total_wait_ms += wait_ms;
+        lane.max_wait_ms = std::max(lane.max_wait_ms, wait_ms);
+        lane.running++;
+
+        lock.unlock();
+        task.run();
+        lock.lock();
+
+        lane.running--;
+        lane.completed++;
+
+        if (task.then) {
+            lock.unlock();
+            task.then();
+            lock.lock();
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef FAISS_NODE_EXECUTOR_H
+#define FAISS_NODE_EXECUTOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+/**
+ * Native thread pool for index work, kept apart from the libuv pool so that a long
+ * train or save never holds up fs/dns callbacks. Work is split into two lanes with
+ * their own threads: interactive (search, reconstruct, distance kernels) and
+ * background (add, train, save, merge). A search therefore never queues behind a
+ * build, and the lanes are sized independently of UV_THREADPOOL_SIZE.
+ *
+ * Threads start on demand up to the lane's size and live for the rest of the
+ * process. The instance is intentionally never destroyed so that idle threads
+ * blocked on the queue at exit do not race a destructor.
+ */
+enum class ExecutorLane {
+    Interactive = 0,
+    Background = 1,
+};
+
+struct ExecutorLaneStats {
+    size_t threads = 0;     // configured lane size
+    size_t started = 0;     // threads currently alive
+    size_t queued = 0;      // tasks waiting for a thread
+    size_t running = 0;     // tasks executing
+    uint64_t completed = 0;
+    double totalWaitMs = 0; // sum of queue wait over completed and running tasks
+    double maxWaitMs = 0;
+};
+
+class Executor {
+public:
+    static Executor& Instance();
+
+    // Queues a task on a lane. then, if given, runs on the same thread once the task
+    // is counted as completed, so results handed off there are never seen before the
+    // stats reflect them. Neither may throw.
+    void Submit(ExecutorLane lane, std::function<void()> task, std::function<void()> then = nullptr);
+
+    // Sets a lane's thread count (at least 1). Extra threads exit once their current
+    // task finishes; queued tasks are kept.
+    void Resize(ExecutorLane lane, size_t threads);
+
+    ExecutorLaneStats Stats(ExecutorLane lane);
+
+    // Lane the calling thread belongs to; Interactive for threads outside the executor.
+    static ExecutorLane CurrentLane();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        std::function<void()> run;
+        std::function<void()> then;
+        Clock::time_point enqueued;
+    };
+
+    struct Lane {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<Task> tasks;
+        size_t target = 1;
+        size_t started = 0;
+        size_t running = 0;
+        uint64_t completed = 0;
+        double total_wait_ms = 0;
+        double max_wait_ms = 0;
+    };
+
+    Executor();
+
+    Lane& GetLane(ExecutorLane lane) {
+        return lanes_[static_cast<size_t>(lane)];
+    }
+
+    // Starts a thread if every live one is busy and the lane is below its size.
+    // Caller holds lane.mutex.
+    void MaybeStartThread(Lane& lane);
+    void Run(Lane& lane);
+
+    Lane lanes_[2];
+};
+
+#endif // FAISS_NODE_EXECUTOR_H
@@ -22,6 +22,8 @@
 #include <stdexcept>
 
 #include "faiss_binary_index.h"
+#include "buffer_io.h"
+#include "parallel_for.h"
 
 namespace {
 
@@ -251,8 +253,16 @@ void FaissBinaryIndexWrapper::ReconstructBatch(
         if (ids[i] < 0 || ids[i] >= static_cast<int64_t>(index_->ntotal)) {
             throw std::out_of_range("Vector id is out of range");
         }
-        index_->reconstruct(ids[i], output + (i * codeSize));
     }
+
+    // Same parallel decode as the float index; GPU-resident indexes stay serial.
+    bool parallel = true;
+#ifdef FAISS_NODE_HAVE_GPU
+    parallel = !gpu_resident_;
+#endif
+    ParallelFor(n, parallel, [&](size_t i) {
+        index_->reconstruct(ids[i], output + (i * codeSize));
+    });
 }
 
 void FaissBinaryIndexWrapper::Train(const uint8_t* vectors, size_t n) {
@@ -528,7 +538,7 @@ std::vector<uint8_t> FaissBinaryIndexWrapper::ToBuffer() const {
 #else
         faiss::write_index_binary(index_.get(), &writer);
 #endif
-        return writer.data;
+        return std::move(writer.data);
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Failed to serialize binary index: ") + e.what());
     }
@@ -542,8 +552,7 @@ std::unique_ptr<FaissBinaryIndexWrapper> FaissBinaryIndexWrapper::FromBuffer(
     }
 
     try {
-        faiss::VectorIOReader reader;
-        reader.data.assign(data, data + length);
+        BufferIOReader reader(data, length);
 
         std::unique_ptr<faiss::IndexBinary> loaded_index(faiss::read_index_binary(&reader));
         EnableSequentialDirectMap(loaded_index.get());
@@ -9,14 +9,17 @@
 #include <faiss/Index.h>
 #include <faiss/IndexFlat.h>
 #include <faiss/IndexHNSW.h>
+#include <faiss/IndexIDMap.h>
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/IndexPQ.h>
 #include <faiss/IndexPreTransform.h>
+#include <faiss/IndexRefine.h>
 #include <faiss/IndexScalarQuantizer.h>
 #include <faiss/VectorTransform.h>
 #include <faiss/impl/IDSelector.h>
 #include <faiss/invlists/DirectMap.h>
+#include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
 #include <faiss/impl/io.h>
@@ -32,6 +35,8 @@
 
 // Now include our header
 #include "faiss_index.h"
+#include "buffer_io.h"
+#include "parallel_for.h"
 #include <stdexcept>
 
 namespace {
@@ -64,6 +69,16 @@ std::string InferIndexType(const faiss::Index* index) {
         return "UNKNOWN";
     }
 
+    const auto* idMap = dynamic_cast<const faiss::IndexIDMap*>(index);
+    if (idMap != nullptr) {
+        return InferIndexType(idMap->index);
+    }
+
+    const auto* refine = dynamic_cast<const faiss::IndexRefine*>(index);
+    if (refine != nullptr) {
+        return InferIndexType(refine->base_index);
+    }
+
     const auto* pretransform = dynamic_cast<const faiss::IndexPreTransform*>(index);
     if (pretransform != nullptr) {
         const std::string transformLabel = InferTransformLabel(pretransform);
@@ -116,14 +131,27 @@ void EnableSequentialDirectMap(faiss::Index* index) {
         return;
     }
 
+    auto* idMap = dynamic_cast<faiss::IndexIDMap*>(index);
+    if (idMap != nullptr) {
+        EnableSequentialDirectMap(idMap->index);
+        return;
+    }
+
+    auto* refine = dynamic_cast<faiss::IndexRefine*>(index);
+    if (refine != nullptr) {
+        EnableSequentialDirectMap(refine->base_index);
+        return;
+    }
+
     auto* pretransform = dynamic_cast<faiss::IndexPreTransform*>(index);
     if (pretransform != nullptr) {
         EnableSequentialDirectMap(pretransform->index);
         return;
     }
 
+    // Leave hashtable maps alone: they back custom ids and removals, which an array map cannot hold
     auto* ivf = dynamic_cast<faiss::IndexIVF*>(index);
-    if (ivf != nullptr) {
+    if (ivf != nullptr && ivf->direct_map.type == faiss::DirectMap::NoMap) {
         ivf->set_direct_map_type(faiss::DirectMap::Array);
     }
 }
@@ -133,6 +161,16 @@ faiss::IndexIVF* FindIvfIndex(faiss::Index* index) {
         return nullptr;
     }
 
+    auto* idMap = dynamic_cast<faiss::IndexIDMap*>(index);
+    if (idMap != nullptr) {
+        return FindIvfIndex(idMap->index);
+    }
+
+    auto* refine = dynamic_cast<faiss::IndexRefine*>(index);
+    if (refine != nullptr) {
+        return FindIvfIndex(refine->base_index);
+    }
+
     auto* pretransform = dynamic_cast<faiss::IndexPreTransform*>(index);
     if (pretransform != nullptr) {
         return FindIvfIndex(pretransform->index);
@@ -141,6 +179,133 @@ faiss::IndexIVF* FindIvfIndex(faiss::Index* index) {
     return dynamic_cast<faiss::IndexIVF*>(index);
 }
 
+faiss::IndexHNSW* FindHnswIndex(faiss::Index* index) {
+    if (index == nullptr) {
+        return nullptr;
+    }
+
+    auto* idMap = dynamic_cast<faiss::IndexIDMap*>(index);
+    if (idMap != nullptr) {
+        return FindHnswIndex(idMap->index);
+    }
+
+    auto* refine = dynamic_cast<faiss::IndexRefine*>(index);
+    if (refine != nullptr) {
+        return FindHnswIndex(refine->base_index);
+    }
+
+    auto* pretransform = dynamic_cast<faiss::IndexPreTransform*>(index);
+    if (pretransform != nullptr) {
+        return FindHnswIndex(pretransform->index);
+    }
+
+    return dynamic_cast<faiss::IndexHNSW*>(index);
+}
+
+// The refine stage wraps the whole base index (including any pre-transform), and
+// sits under the ID map when custom ids are stored.
+faiss::IndexRefine* FindRefineIndex(faiss::Index* index) {
+    auto* idMap = dynamic_cast<faiss::IndexIDMap*>(index);
+    if (idMap != nullptr) {
+        return FindRefineIndex(idMap->index);
+    }
+
+    return dynamic_cast<faiss::IndexRefine*>(index);
+}
+
+// FAISS SearchParameters only borrow their selector, so one call's selector chain
+// and parameter objects are owned together here.
+struct ResolvedSearchParams {
+    std::unique_ptr<faiss::IDSelector> inner;
+    std::unique_ptr<faiss::IDSelector> selector;
+    std::unique_ptr<faiss::IDSelector> translated;
+    std::unique_ptr<faiss::SearchParameters> base;
+    std::unique_ptr<faiss::SearchParameters> params;
+
+    const faiss::SearchParameters* get() const {
+        return params.get();
+    }
+};
+
+// IVF and HNSW reject SearchParameters of the wrong subclass, so the parameter type
+// follows the innermost index. Fields the caller did not override are copied from the
+// index, so a filtered search is as accurate as an unfiltered one. Overrides live only
+// in this call's parameters; the shared index is never written. A refine stage takes
+// its own parameter type, with the base index's parameters (and selector) nested inside.
+ResolvedSearchParams ResolveSearchParams(faiss::Index* index, const SearchOptions* options) {
+    ResolvedSearchParams resolved;
+    if (options == nullptr || options->IsDefault()) {
+        return resolved;
+    }
+
+    switch (options->filter) {
+        case SearchOptions::FilterMode::Allow:
+            resolved.selector = std::make_unique<faiss::IDSelectorBatch>(
+                options->filter_ids.size(), reinterpret_cast<const faiss::idx_t*>(options->filter_ids.data()));
+            break;
+        case SearchOptions::FilterMode::Deny:
+            resolved.inner = std::make_unique<faiss::IDSelectorBatch>(
+                options->filter_ids.size(), reinterpret_cast<const faiss::idx_t*>(options->filter_ids.data()));
+            resolved.selector = std::make_unique<faiss::IDSelectorNot>(resolved.inner.get());
+            break;
+        case SearchOptions::FilterMode::Bitmap:
+            resolved.selector = std::make_unique<faiss::IDSelectorBitmap>(
+                options->bitmap.size(), options->bitmap.data());
+            break;
+        case SearchOptions::FilterMode::None:
+            break;
+    }
+
+    std::unique_ptr<faiss::SearchParameters> params;
+    if (faiss::IndexIVF* ivf = FindIvfIndex(index)) {
+        auto ivfParams = std::make_unique<faiss::SearchParametersIVF>();
+        ivfParams->nprobe = options->nprobe > 0 ? static_cast<size_t>(options->nprobe) : ivf->nprobe;
+        ivfParams->max_codes = options->max_codes > 0 ? options->max_codes : ivf->max_codes;
+        params = std::move(ivfParams);
+    } else if (faiss::IndexHNSW* hnsw = FindHnswIndex(index)) {
+        auto hnswParams = std::make_unique<faiss::SearchParametersHNSW>();
+        hnswParams->efSearch = options->ef_search > 0 ? options->ef_search : hnsw->hnsw.efSearch;
+        params = std::move(hnswParams);
+    } else {
+        params = std::make_unique<faiss::SearchParameters>();
+    }
+
+    faiss::IndexRefine* refine = FindRefineIndex(index);
+    if (refine == nullptr) {
+        params->sel = resolved.selector.get();
+        resolved.params = std::move(params);
+        return resolved;
+    }
+
+    // The ID map translates the outer selector only, so the nested one is translated here
+    faiss::IDSelector* selector = resolved.selector.get();
+    auto* idMap = dynamic_cast<faiss::IndexIDMap*>(index);
+    if (selector != nullptr && idMap != nullptr) {
+        resolved.translated = std::make_unique<faiss::IDSelectorTranslated>(idMap->id_map, selector);
+        selector = resolved.translated.get();
+    }
+
+    auto refineParams = std::make_unique<faiss::IndexRefineSearchParameters>();
+    refineParams->k_factor = options->k_factor > 0 ? options->k_factor : refine->k_factor;
+    params->sel = selector;
+    refineParams->base_index_params = params.get();
+    refineParams->sel = selector;
+    resolved.base = std::move(params);
+    resolved.params = std::move(refineParams);
+    return resolved;
+}
+
+// An index holds caller-supplied ids if it is wrapped in an ID map, or is an IVF whose
+// direct map is a hashtable (how add_with_ids is supported natively by IVF).
+bool DetectIdMap(faiss::Index* index) {
+    if (dynamic_cast<faiss::IndexIDMap*>(index) != nullptr) {
+        return true;
+    }
+
+    faiss::IndexIVF* ivf = FindIvfIndex(index);
+    return ivf != nullptr && ivf->direct_map.type == faiss::DirectMap::Hashtable;
+}
+
 }  // namespace
 
 FaissIndexWrapper::FaissIndexWrapper(
@@ -148,11 +313,13 @@ FaissIndexWrapper::FaissIndexWrapper(
         const std::string& indexDescription,
         int metric,
         const std::string& typeLabel,
-        const std::string& factoryDescription)
+        const std::string& factoryDescription,
+        bool idMap)
     : dims_(dims),
       disposed_(false),
       type_label_(typeLabel),
-      factory_description_(factoryDescription.empty() ? indexDescription : factoryDescription) {
+      factory_description_(factoryDescription.empty() ? indexDescription : factoryDescription),
+      id_map_(idMap) {
     if (dims <= 0) {
         throw std::invalid_argument("Dimensions must be positive");
     }
@@ -161,7 +328,22 @@ FaissIndexWrapper::FaissIndexWrapper(
     // Examples: "Flat" -> IndexFlatL2, "IVF100,Flat" -> IndexIVFFlat, "HNSW32" -> IndexHNSW
     faiss::MetricType metricType = static_cast<faiss::MetricType>(metric);
     index_ = std::unique_ptr<faiss::Index>(faiss::index_factory(dims, indexDescription.c_str(), metricType));
-    EnableSequentialDirectMap(index_.get());
+
+    if (id_map_) {
+        // A refine stage keeps its own sequential copy of the vectors, so it needs the ID map
+        faiss::IndexIVF* ivf = FindRefineIndex(index_.get()) == nullptr ? FindIvfIndex(index_.get()) : nullptr;
+        if (ivf != nullptr) {
+            // IVF stores ids in its inverted lists; a hashtable map keeps reconstruct/remove working
+            ivf->set_direct_map_type(faiss::DirectMap::Hashtable);
+        } else {
+            auto* wrapped = new faiss::IndexIDMap2(index_.get());
+            wrapped->own_fields = true;
+            index_.release();
+            index_.reset(wrapped);
+        }
+    } else {
+        EnableSequentialDirectMap(index_.get());
+    }
 
     if (type_label_.empty()) {
         type_label_ = InferIndexType(index_.get());
@@ -179,11 +361,12 @@ FaissIndexWrapper::~FaissIndexWrapper() {
 }
 
 void FaissIndexWrapper::Add(const float* vectors, size_t n) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
+    EnsureWritable();
     
     if (vectors == nullptr) {
         throw std::invalid_argument("Vectors pointer cannot be null");
@@ -198,12 +381,38 @@ void FaissIndexWrapper::Add(const float* vectors, size_t n) {
     index_->add(n, vectors);
 }
 
-void FaissIndexWrapper::Search(const float* query, int k, float* distances, int64_t* labels) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+void FaissIndexWrapper::AddWithIds(const float* vectors, const int64_t* ids, size_t n) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    if (disposed_) {
+        throw std::runtime_error("Index has been disposed");
+    }
+    EnsureWritable();
+
+    if (!id_map_) {
+        throw std::runtime_error("add_with_ids requires an index created with idMap enabled");
+    }
+
+    if (vectors == nullptr || ids == nullptr) {
+        throw std::invalid_argument("Vectors and ids pointers cannot be null");
+    }
+
+    if (n == 0) {
+        return;
+    }
+
+    index_->add_with_ids(n, vectors, reinterpret_cast<const faiss::idx_t*>(ids));
+}
+
+void FaissIndexWrapper::Search(const float* query, int k, float* distances, int64_t* labels,
+                               const SearchOptions* options) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
+
+    auto gpuLock = LockGpuReads();
     
     if (query == nullptr) {
         throw std::invalid_argument("Query pointer cannot be null");
@@ -225,17 +434,22 @@ void FaissIndexWrapper::Search(const float* query, int k, float* distances, int6
     // Clamp k to available vectors
     int actual_k = (k > static_cast<int>(ntotal)) ? static_cast<int>(ntotal) : k;
     
+    ResolvedSearchParams params = ResolveSearchParams(index_.get(), options);
+    
     // FAISS search: nq=1 (single query), k neighbors
     // Cast labels to faiss::idx_t* for FAISS API
-    index_->search(1, query, actual_k, distances, reinterpret_cast<faiss::idx_t*>(labels));
+    index_->search(1, query, actual_k, distances, reinterpret_cast<faiss::idx_t*>(labels), params.get());
 }
 
-void FaissIndexWrapper::SearchBatch(const float* queries, size_t nq, int k, float* distances, int64_t* labels) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+void FaissIndexWrapper::SearchBatch(const float* queries, size_t nq, int k, float* distances, int64_t* labels,
+                                    const SearchOptions* options) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
+
+    auto gpuLock = LockGpuReads();
     
     if (queries == nullptr) {
         throw std::invalid_argument("Queries pointer cannot be null");
@@ -265,21 +479,25 @@ void FaissIndexWrapper::SearchBatch(const float* queries, size_t nq, int k, floa
     // Results are stored as: [q1_results, q2_results, ..., qn_results]
     // Each query's results: [k distances, k labels]
     // Cast labels to faiss::idx_t* for FAISS API
-    index_->search(nq, queries, actual_k, distances, reinterpret_cast<faiss::idx_t*>(labels));
+    ResolvedSearchParams params = ResolveSearchParams(index_.get(), options);
+    index_->search(nq, queries, actual_k, distances, reinterpret_cast<faiss::idx_t*>(labels), params.get());
 }
 
 void FaissIndexWrapper::Reconstruct(int64_t id, float* output) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
 
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
 
+    auto gpuLock = LockGpuReads();
+
     if (output == nullptr) {
         throw std::invalid_argument("Output buffer cannot be null");
     }
 
-    if (id < 0 || id >= static_cast<int64_t>(index_->ntotal)) {
+    // Custom ids are sparse; the ID map / hashtable reports unknown ids itself
+    if (id < 0 || (!id_map_ && id >= static_cast<int64_t>(index_->ntotal))) {
         throw std::out_of_range("Vector id is out of range");
     }
 
@@ -287,12 +505,14 @@ void FaissIndexWrapper::Reconstruct(int64_t id, float* output) const {
 }
 
 void FaissIndexWrapper::ReconstructBatch(const int64_t* ids, size_t n, float* output) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
 
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
 
+    auto gpuLock = LockGpuReads();
+
     if (ids == nullptr) {
         throw std::invalid_argument("Ids pointer cannot be null");
     }
@@ -302,15 +522,24 @@ void FaissIndexWrapper::ReconstructBatch(const int64_t* ids, size_t n, float* ou
     }
 
     for (size_t i = 0; i < n; i++) {
-        if (ids[i] < 0 || ids[i] >= static_cast<int64_t>(index_->ntotal)) {
+        if (ids[i] < 0 || (!id_map_ && ids[i] >= static_cast<int64_t>(index_->ntotal))) {
             throw std::out_of_range("Vector id is out of range");
         }
-        index_->reconstruct(ids[i], output + (i * dims_));
     }
+
+    // Decode in parallel: FAISS's default reconstruct_batch stays serial below 1000 keys,
+    // which is exactly the re-ranking batch size. GPU indexes share one stream, so stay serial.
+    bool parallel = true;
+#ifdef FAISS_NODE_HAVE_GPU
+    parallel = !gpu_resident_;
+#endif
+    ParallelFor(n, parallel, [&](size_t i) {
+        index_->reconstruct(ids[i], output + (i * dims_));
+    });
 }
 
 size_t FaissIndexWrapper::GetTotalVectors() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (disposed_) {
         return 0;
     }
@@ -322,11 +551,12 @@ int FaissIndexWrapper::GetDimensions() const {
 }
 
 void FaissIndexWrapper::Train(const float* vectors, size_t n) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
+    EnsureWritable();
     
     if (vectors == nullptr) {
         throw std::invalid_argument("Vectors pointer cannot be null");
@@ -340,7 +570,7 @@ void FaissIndexWrapper::Train(const float* vectors, size_t n) {
 }
 
 void FaissIndexWrapper::SetNprobe(int nprobe) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
@@ -355,7 +585,7 @@ void FaissIndexWrapper::SetNprobe(int nprobe) {
 }
 
 bool FaissIndexWrapper::IsTrained() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (disposed_) {
         return false;
     }
@@ -363,7 +593,7 @@ bool FaissIndexWrapper::IsTrained() const {
 }
 
 std::string FaissIndexWrapper::GetIndexType() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (disposed_) {
         return "UNKNOWN";
     }
@@ -371,15 +601,38 @@ std::string FaissIndexWrapper::GetIndexType() const {
 }
 
 std::string FaissIndexWrapper::GetFactoryDescription() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (disposed_) {
         return "";
     }
     return factory_description_;
 }
 
+bool FaissIndexWrapper::IsIdMapped() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id_map_;
+}
+
+bool FaissIndexWrapper::IsReadOnly() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return read_only_;
+}
+
+bool FaissIndexWrapper::IsMmapped() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return mmapped_;
+}
+
+void FaissIndexWrapper::EnsureWritable() const {
+    if (read_only_) {
+        throw std::runtime_error(mmapped_
+            ? "Mutations are not supported on a memory-mapped index"
+            : "Mutations are not supported on an index loaded with readOnly");
+    }
+}
+
 std::string FaissIndexWrapper::GetMetricName() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (disposed_) {
         return "l2";
     }
@@ -387,7 +640,7 @@ std::string FaissIndexWrapper::GetMetricName() const {
 }
 
 void FaissIndexWrapper::Dispose() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     if (disposed_) {
         return;
     }
@@ -402,7 +655,7 @@ void FaissIndexWrapper::Dispose() {
 }
 
 void FaissIndexWrapper::Save(const std::string& filename) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
@@ -429,14 +682,31 @@ void FaissIndexWrapper::Save(const std::string& filename) const {
     }
 }
 
-std::unique_ptr<FaissIndexWrapper> FaissIndexWrapper::Load(const std::string& filename) {
+std::unique_ptr<FaissIndexWrapper> FaissIndexWrapper::Load(
+    const std::string& filename,
+    bool mmap,
+    bool readOnly) {
     if (filename.empty()) {
         throw std::invalid_argument("Filename cannot be empty");
     }
+
+    // A mapped file is shared with other processes, so it is never written through.
+    readOnly = readOnly || mmap;
+    int ioFlags = 0;
+    if (mmap) {
+        ioFlags |= faiss::IO_FLAG_MMAP;
+    }
+    if (readOnly) {
+        ioFlags |= faiss::IO_FLAG_READ_ONLY;
+    }
     
     try {
-        faiss::Index* loaded_index = faiss::read_index(filename.c_str());
-        EnableSequentialDirectMap(loaded_index);
+        faiss::Index* loaded_index = faiss::read_index(filename.c_str(), ioFlags);
+        // The direct map is one heap int64 per vector, which would undo the point
+        // of mapping the lists; mmapped IVF indexes reconstruct only if saved with one.
+        if (!mmap) {
+            EnableSequentialDirectMap(loaded_index);
+        }
         
         // Create wrapper with loaded index (supports any index type)
         auto wrapper = std::make_unique<FaissIndexWrapper>(loaded_index->d);
@@ -444,6 +714,10 @@ std::unique_ptr<FaissIndexWrapper> FaissIndexWrapper::Load(const std::string& fi
         wrapper->dims_ = loaded_index->d;
         wrapper->type_label_ = InferIndexType(loaded_index);
         wrapper->factory_description_.clear();
+        wrapper->id_map_ = DetectIdMap(loaded_index);
+        wrapper->read_only_ = readOnly;
+        // IO_FLAG_MMAP only maps IVF inverted lists; anything else was read into heap
+        wrapper->mmapped_ = mmap && FindIvfIndex(loaded_index) != nullptr;
         
         return wrapper;
     } catch (const std::exception& e) {
@@ -452,7 +726,7 @@ std::unique_ptr<FaissIndexWrapper> FaissIndexWrapper::Load(const std::string& fi
 }
 
 std::vector<uint8_t> FaissIndexWrapper::ToBuffer() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
@@ -474,8 +748,8 @@ std::vector<uint8_t> FaissIndexWrapper::ToBuffer() const {
         faiss::write_index(index_.get(), &writer);
 #endif
         
-        // Return the buffer directly
-        return writer.data;
+        // Move the serialized bytes out; the binding hands them to JS without copying
+        return std::move(writer.data);
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Failed to serialize index: ") + e.what());
     }
@@ -487,10 +761,8 @@ std::unique_ptr<FaissIndexWrapper> FaissIndexWrapper::FromBuffer(const uint8_t*
     }
     
     try {
-        // Use FAISS VectorIOReader for direct memory deserialization (no temp files)
-        // This is the same approach used by ewfian/faiss-node
-        faiss::VectorIOReader reader;
-        reader.data.assign(data, data + length);
+        // Parse straight from the caller's memory (no temp files, no intermediate copy)
+        BufferIOReader reader(data, length);
         
         faiss::Index* loaded_index = faiss::read_index(&reader);
         EnableSequentialDirectMap(loaded_index);
@@ -501,6 +773,7 @@ std::unique_ptr<FaissIndexWrapper> FaissIndexWrapper::FromBuffer(const uint8_t*
         wrapper->dims_ = loaded_index->d;
         wrapper->type_label_ = InferIndexType(loaded_index);
         wrapper->factory_description_.clear();
+        wrapper->id_map_ = DetectIdMap(loaded_index);
         
         return wrapper;
     } catch (const std::exception& e) {
@@ -508,16 +781,47 @@ std::unique_ptr<FaissIndexWrapper> FaissIndexWrapper::FromBuffer(const uint8_t*
     }
 }
 
+std::unique_ptr<FaissIndexWrapper> FaissIndexWrapper::Clone() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    if (disposed_) {
+        throw std::runtime_error("Index has been disposed");
+    }
+
+    try {
+#ifdef FAISS_NODE_HAVE_GPU
+        std::unique_ptr<faiss::Index> copy(gpu_resident_ ? faiss::gpu::index_gpu_to_cpu(index_.get())
+                                                         : faiss::clone_index(index_.get()));
+#else
+        std::unique_ptr<faiss::Index> copy(faiss::clone_index(index_.get()));
+#endif
+        EnableSequentialDirectMap(copy.get());
+
+        auto wrapper = std::make_unique<FaissIndexWrapper>(dims_);
+        wrapper->index_ = std::move(copy);
+        wrapper->type_label_ = type_label_;
+        wrapper->factory_description_ = factory_description_;
+        wrapper->id_map_ = id_map_;
+        return wrapper;
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string("Failed to clone index: ") + e.what());
+    }
+}
+
 void FaissIndexWrapper::MergeFrom(const FaissIndexWrapper& other) {
     if (this == &other) {
         throw std::invalid_argument("Cannot merge an index into itself");
     }
 
-    std::scoped_lock lock(mutex_, other.mutex_);
+    // Exclusive on the target, shared on the source; std::lock avoids lock-order deadlocks.
+    std::unique_lock<std::shared_mutex> lock(mutex_, std::defer_lock);
+    std::shared_lock<std::shared_mutex> otherLock(other.mutex_, std::defer_lock);
+    std::lock(lock, otherLock);
     
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
+    EnsureWritable();
     
     if (other.disposed_) {
         throw std::runtime_error("Cannot merge from disposed index");
@@ -536,13 +840,13 @@ void FaissIndexWrapper::MergeFrom(const FaissIndexWrapper& other) {
 }
 
 void FaissIndexWrapper::SetHnswParams(int efConstruction, int efSearch) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
 
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
 
-    faiss::IndexHNSW* hnsw_index = dynamic_cast<faiss::IndexHNSW*>(index_.get());
+    faiss::IndexHNSW* hnsw_index = FindHnswIndex(index_.get());
     if (hnsw_index == nullptr) {
         return;
     }
@@ -556,8 +860,36 @@ void FaissIndexWrapper::SetHnswParams(int efConstruction, int efSearch) {
     }
 }
 
+void FaissIndexWrapper::SetRefineKFactor(float kFactor) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    if (disposed_) {
+        throw std::runtime_error("Index has been disposed");
+    }
+
+    if (!(kFactor >= 1)) {
+        throw std::invalid_argument("kFactor must be at least 1");
+    }
+
+    faiss::IndexRefine* refine = FindRefineIndex(index_.get());
+    if (refine == nullptr) {
+        throw std::runtime_error("kFactor requires an index with a refine stage");
+    }
+    refine->k_factor = kFactor;
+}
+
+float FaissIndexWrapper::GetRefineKFactor() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (disposed_) {
+        return 0;
+    }
+
+    faiss::IndexRefine* refine = FindRefineIndex(index_.get());
+    return refine != nullptr ? refine->k_factor : 0;
+}
+
 void FaissIndexWrapper::ToGpu(int device) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
 
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
@@ -595,7 +927,7 @@ void FaissIndexWrapper::ToGpu(int device) {
 }
 
 void FaissIndexWrapper::ToCpu() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
 
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
@@ -619,9 +951,20 @@ void FaissIndexWrapper::ToCpu() {
 #endif
 }
 
+std::unique_lock<std::mutex> FaissIndexWrapper::LockGpuReads() const {
+#ifdef FAISS_NODE_HAVE_GPU
+    // FAISS GPU indexes share one resources object and stream, so they are not
+    // safe for concurrent searches even though CPU indexes are.
+    if (gpu_resident_) {
+        return std::unique_lock<std::mutex>(gpu_read_mutex_);
+    }
+#endif
+    return std::unique_lock<std::mutex>();
+}
+
 bool FaissIndexWrapper::IsGpuResident() const {
 #ifdef FAISS_NODE_HAVE_GPU
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     return !disposed_ && gpu_resident_;
 #else
     return false;
@@ -637,11 +980,12 @@ bool FaissIndexWrapper::HasGpuSupport() {
 }
 
 void FaissIndexWrapper::Reset() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
+    EnsureWritable();
     
     try {
         // FAISS reset() clears all vectors but keeps the index structure
@@ -652,11 +996,12 @@ void FaissIndexWrapper::Reset() {
 }
 
 size_t FaissIndexWrapper::RemoveIds(const int64_t* ids, size_t n) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
 
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
+    EnsureWritable();
 
     if (ids == nullptr) {
         throw std::invalid_argument("Ids pointer cannot be null");
@@ -696,18 +1041,22 @@ size_t FaissIndexWrapper::RemoveIds(const int64_t* ids, size_t n) {
     }
 }
 
-size_t FaissIndexWrapper::RangeSearch(const float* query, float radius,
-                                      std::vector<float>& distances,
-                                      std::vector<int64_t>& labels,
-                                      std::vector<size_t>& lims) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+RangeSearchOutput FaissIndexWrapper::RangeSearch(const float* queries, size_t nq, float radius,
+                                                 const SearchOptions* options) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     
     if (disposed_) {
         throw std::runtime_error("Index has been disposed");
     }
+
+    auto gpuLock = LockGpuReads();
     
-    if (query == nullptr) {
-        throw std::invalid_argument("Query pointer cannot be null");
+    if (queries == nullptr) {
+        throw std::invalid_argument("Queries pointer cannot be null");
+    }
+
+    if (nq == 0) {
+        throw std::invalid_argument("Number of queries must be positive");
     }
     
     if (radius < 0) {
@@ -720,28 +1069,21 @@ size_t FaissIndexWrapper::RangeSearch(const float* query, float radius,
     }
     
     try {
-        // FAISS range_search returns RangeSearchResult
-        faiss::RangeSearchResult result(1);  // nq=1 (single query)
-        
-        // Perform range search (nq=1, single query)
-        index_->range_search(1, query, radius, &result);
-        
-        // Extract results
-        size_t total = result.lims[1];  // Total results for query 0
-        distances.resize(total);
-        labels.resize(total);
-        lims.resize(2);  // [0, total]
-        
-        // Copy distances and labels
-        for (size_t i = 0; i < total; i++) {
-            distances[i] = result.distances[i];
-            labels[i] = result.labels[i];
-        }
+        faiss::RangeSearchResult result(nq);
+        ResolvedSearchParams params = ResolveSearchParams(index_.get(), options);
+        index_->range_search(nq, queries, radius, &result, params.get());
         
-        lims[0] = 0;
-        lims[1] = total;
+        // Take ownership of FAISS's buffers; RangeSearchResult's destructor skips nulls
+        RangeSearchOutput output;
+        output.nq = nq;
+        output.lims.reset(result.lims);
+        output.labels.reset(reinterpret_cast<int64_t*>(result.labels));
+        output.distances.reset(result.distances);
+        result.lims = nullptr;
+        result.labels = nullptr;
+        result.distances = nullptr;
         
-        return total;
+        return output;
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Failed to range search: ") + e.what());
     }
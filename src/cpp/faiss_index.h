@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 
 #if __has_include(<faiss/gpu/StandardGpuResources.h>) && __has_include(<faiss/gpu/GpuCloner.h>)
 #define FAISS_NODE_HAVE_GPU 1
@@ -22,6 +23,46 @@ namespace faiss {
 #endif
 }
 
+/**
+ * Optional per-call search settings. A default-constructed value searches the
+ * whole index with its stored parameters.
+ */
+struct SearchOptions {
+    enum class FilterMode { None, Allow, Deny, Bitmap };
+
+    FilterMode filter = FilterMode::None;
+    std::vector<int64_t> filter_ids;  // Allow/Deny: labels to keep or exclude
+    std::vector<uint8_t> bitmap;      // Bitmap: id is kept if bit (id & 7) of byte (id >> 3) is set
+
+    // Per-call overrides of the index's own settings; 0 keeps the stored value.
+    // Each is ignored by index types that do not use it.
+    int nprobe = 0;        // IVF
+    size_t max_codes = 0;  // IVF
+    int ef_search = 0;     // HNSW
+    float k_factor = 0;    // refine stage: re-rank k * k_factor base candidates
+
+    bool IsDefault() const {
+        return filter == FilterMode::None && nprobe == 0 && max_codes == 0 && ef_search == 0 &&
+               k_factor == 0;
+    }
+};
+
+/**
+ * Range search results in FAISS's lims layout: matches for query i occupy
+ * [lims[i], lims[i + 1]) of labels and distances. The arrays are the buffers
+ * FAISS filled, taken over from its RangeSearchResult rather than copied.
+ */
+struct RangeSearchOutput {
+    size_t nq = 0;
+    std::unique_ptr<size_t[]> lims;      // nq + 1 entries
+    std::unique_ptr<int64_t[]> labels;   // Total() entries
+    std::unique_ptr<float[]> distances;  // Total() entries
+
+    size_t Total() const {
+        return lims ? lims[nq] : 0;
+    }
+};
+
 /**
  * Wrapper class for FAISS index that manages memory and provides
  * a clean interface for N-API bindings.
@@ -30,12 +71,14 @@ class FaissIndexWrapper {
 public:
     // Constructor: creates index using index_factory string
     // Examples: "Flat" for IndexFlatL2, "IVF100,Flat" for IndexIVFFlat, "HNSW32" for IndexHNSW
+    // idMap: accept caller-supplied 64-bit ids (IVF natively, other types via IndexIDMap2)
     FaissIndexWrapper(
         int dims,
         const std::string& indexDescription,
         int metric = 1,
         const std::string& typeLabel = "",
-        const std::string& factoryDescription = "");
+        const std::string& factoryDescription = "",
+        bool idMap = false);
     
     // Constructor: creates IndexFlatL2 (for backward compatibility)
     explicit FaissIndexWrapper(int dims);
@@ -51,13 +94,19 @@ public:
     // vectors: pointer to float array (n * dims elements)
     // n: number of vectors
     void Add(const float* vectors, size_t n);
+
+    // Add vectors with caller-supplied ids (id-mapped indexes only)
+    // ids: n int64 ids, returned as labels by search and accepted by reconstruct/removeIds
+    void AddWithIds(const float* vectors, const int64_t* ids, size_t n);
     
     // Search for k nearest neighbors (single query)
     // query: pointer to query vector (dims elements)
     // k: number of neighbors to return
     // distances: output array (k elements) - caller must allocate
     // labels: output array (k elements) - caller must allocate
-    void Search(const float* query, int k, float* distances, int64_t* labels) const;
+    // options: optional id filter; unmatched result slots get label -1
+    void Search(const float* query, int k, float* distances, int64_t* labels,
+                const SearchOptions* options = nullptr) const;
     
     // Batch search for k nearest neighbors (multiple queries)
     // queries: pointer to query vectors (nq * dims elements)
@@ -65,7 +114,9 @@ public:
     // k: number of neighbors to return per query
     // distances: output array (nq * k elements) - caller must allocate
     // labels: output array (nq * k elements) - caller must allocate
-    void SearchBatch(const float* queries, size_t nq, int k, float* distances, int64_t* labels) const;
+    // options: optional id filter applied to every query
+    void SearchBatch(const float* queries, size_t nq, int k, float* distances, int64_t* labels,
+                     const SearchOptions* options = nullptr) const;
 
     // Reconstruct a stored vector by its internal id
     void Reconstruct(int64_t id, float* output) const;
@@ -83,6 +134,9 @@ public:
     std::string GetIndexType() const;
     std::string GetFactoryDescription() const;
     std::string GetMetricName() const;
+    bool IsIdMapped() const;
+    bool IsReadOnly() const;
+    bool IsMmapped() const;
     
     // Set nprobe for IVF indexes
     void SetNprobe(int nprobe);
@@ -90,6 +144,11 @@ public:
     // Configure HNSW-specific parameters after index construction
     void SetHnswParams(int efConstruction, int efSearch);
 
+    // Number of base-index candidates (k * kFactor) the refine stage re-ranks.
+    // Setting throws if the index has no refine stage; the getter returns 0 then.
+    void SetRefineKFactor(float kFactor);
+    float GetRefineKFactor() const;
+
     // Convert the wrapped index between CPU and GPU when FAISS GPU support is available.
     void ToGpu(int device);
     void ToCpu();
@@ -101,7 +160,7 @@ public:
     
     // Check if disposed (thread-safe)
     bool IsDisposed() const {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_lock<std::shared_mutex> lock(mutex_);
         return disposed_;
     }
     
@@ -109,7 +168,12 @@ public:
     void Save(const std::string& filename) const;
     
     // Load index from file (static factory method)
-    static std::unique_ptr<FaissIndexWrapper> Load(const std::string& filename);
+    // mmap: map IVF list data from the file instead of reading it into heap (implies readOnly)
+    // readOnly: reject add/train/remove/reset/merge on the loaded index
+    static std::unique_ptr<FaissIndexWrapper> Load(
+        const std::string& filename,
+        bool mmap = false,
+        bool readOnly = false);
     
     // Serialize index to buffer
     std::vector<uint8_t> ToBuffer() const;
@@ -117,6 +181,10 @@ public:
     // Deserialize index from buffer (static factory method)
     static std::unique_ptr<FaissIndexWrapper> FromBuffer(const uint8_t* data, size_t length);
     
+    // Writable in-memory CPU copy of the index, e.g. a search replica. Fails for
+    // mmapped IVF lists, which FAISS cannot clone.
+    std::unique_ptr<FaissIndexWrapper> Clone() const;
+    
     // Merge vectors from another index
     // other: reference to another FaissIndexWrapper
     void MergeFrom(const FaissIndexWrapper& other);
@@ -128,28 +196,36 @@ public:
     // Returns the number of removed vectors.
     size_t RemoveIds(const int64_t* ids, size_t n);
     
-    // Range search: find all vectors within radius
-    // query: pointer to query vector (dims elements)
+    // Range search: find all vectors within radius of each query
+    // queries: pointer to query vectors (nq * dims elements)
+    // nq: number of queries, searched together in one FAISS call (parallel over queries)
     // radius: maximum distance threshold
-    // distances: output array (variable length, caller must allocate buffer)
-    // labels: output array (variable length, caller must allocate buffer)
-    // lims: output array (nq+1 elements) - limits for each query result
-    // Returns: total number of results found
-    size_t RangeSearch(const float* query, float radius, 
-                       std::vector<float>& distances, 
-                       std::vector<int64_t>& labels,
-                       std::vector<size_t>& lims) const;
+    // Returns: per-query result ranges plus the labels and distances they index
+    RangeSearchOutput RangeSearch(const float* queries, size_t nq, float radius,
+                                  const SearchOptions* options = nullptr) const;
 
 private:
+    // Serializes reads while the index is GPU-resident; returns an empty lock for CPU indexes.
+    std::unique_lock<std::mutex> LockGpuReads() const;
+
+    // Throws for indexes loaded read-only; callers must hold mutex_.
+    void EnsureWritable() const;
+
     std::unique_ptr<faiss::Index> index_;  // Base Index pointer (can hold any index type)
     int dims_;
     bool disposed_;
     std::string type_label_;
     std::string factory_description_;
-    mutable std::mutex mutex_;  // Protect concurrent access
+    bool id_map_ = false;  // labels are caller-supplied ids rather than insertion order
+    bool read_only_ = false;
+    bool mmapped_ = false;  // IVF lists live in a shared file mapping, not the heap
+    // Read paths (search, reconstruct, stats, serialization) take a shared lock so
+    // concurrent searches run in parallel; mutations take it exclusively.
+    mutable std::shared_mutex mutex_;
 #ifdef FAISS_NODE_HAVE_GPU
     std::shared_ptr<faiss::gpu::StandardGpuResources> gpu_resources_;
     bool gpu_resident_ = false;
+    mutable std::mutex gpu_read_mutex_;  // serializes reads while gpu_resident_
     int gpu_device_ = -1;
 #endif
 };
@@ -0,0 +1,170 @@
+#include "faiss_replica_set.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Large enough that a replica under a write loses to any replica that is only reading
+constexpr int64_t kWriteWeight = int64_t(1) << 32;
+
+} // namespace
+
+// Counts a read against its replica until it goes out of scope. Holds the replica's
+// current copy, so a resync that swaps the copy out does not free it mid-read.
+class FaissReplicaSet::Lease {
+public:
+    explicit Lease(const Replica* replica) : replica_(replica) {
+        replica_->load.fetch_add(1);
+        index_ = std::atomic_load(&replica_->index);
+    }
+    Lease(Lease&& other) noexcept : replica_(other.replica_), index_(std::move(other.index_)) {
+        other.replica_ = nullptr;
+    }
+    ~Lease() {
+        if (replica_ != nullptr) {
+            replica_->load.fetch_sub(1);
+        }
+    }
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    Lease& operator=(Lease&&) = delete;
+
+    const FaissIndexWrapper& operator*() const {
+        return *index_;
+    }
+    const FaissIndexWrapper* operator->() const {
+        return index_.get();
+    }
+
+private:
+    const Replica* replica_;
+    std::shared_ptr<const FaissIndexWrapper> index_;
+};
+
+FaissReplicaSet::FaissReplicaSet(std::unique_ptr<FaissIndexWrapper> primary, size_t replicas) {
+    if (!primary) {
+        throw std::invalid_argument("Replica set needs an index");
+    }
+    replicas = std::max<size_t>(replicas, 1);
+    replicas_.reserve(replicas);
+
+    auto first = std::make_unique<Replica>();
+    first->index = std::move(primary);
+    replicas_.push_back(std::move(first));
+    for (size_t i = 1; i < replicas; i++) {
+        auto replica = std::make_unique<Replica>();
+        replica->index = Primary().Clone();
+        replicas_.push_back(std::move(replica));
+    }
+}
+
+void FaissReplicaSet::Resync(Replica& replica) {
+    std::shared_ptr<FaissIndexWrapper> copy = Primary().Clone();
+    std::atomic_store(&replica.index, std::move(copy));
+}
+
+FaissReplicaSet::Lease FaissReplicaSet::Acquire() const {
+    const Replica* best = replicas_[0].get();
+    int64_t bestLoad = best->load.load();
+    for (size_t i = 1; i < replicas_.size() && bestLoad > 0; i++) {
+        const int64_t load = replicas_[i]->load.load();
+        if (load < bestLoad) {
+            best = replicas_[i].get();
+            bestLoad = load;
+        }
+    }
+    return Lease(best);
+}
+
+template <typename Fn>
+void FaissReplicaSet::RollingWrite(const Fn& fn) {
+    // One write rolls through the copies at a time, so every copy applies writes in
+    // the same order
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    for (size_t i = 0; i < replicas_.size(); i++) {
+        Replica& replica = *replicas_[i];
+        replica.load.fetch_add(kWriteWeight);
+        try {
+            fn(*std::atomic_load(&replica.index));
+        } catch (...) {
+            replica.load.fetch_sub(kWriteWeight);
+            if (i == 0) {
+                throw;
+            }
+            // The primary took the write, so the write stands; bring this copy back
+            // in line with it. A failed resync leaves the copy stale and is reported.
+            Resync(replica);
+            continue;
+        }
+        replica.load.fetch_sub(kWriteWeight);
+    }
+}
+
+void FaissReplicaSet::AddWithIds(const float* vectors, const int64_t* ids, size_t n) {
+    RollingWrite([&](FaissIndexWrapper& index) {
+        index.AddWithIds(vectors, ids, n);
+    });
+}
+
+// Trains the primary once and copies it, instead of running k-means on every replica
+// and relying on each run producing the same centroids
+void FaissReplicaSet::Train(const float* vectors, size_t n) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    replicas_[0]->index->Train(vectors, n);
+    for (size_t i = 1; i < replicas_.size(); i++) {
+        Resync(*replicas_[i]);
+    }
+}
+
+size_t FaissReplicaSet::RemoveIds(const int64_t* ids, size_t n) {
+    size_t removed = 0;
+    bool first = true;
+    RollingWrite([&](FaissIndexWrapper& index) {
+        const size_t count = index.RemoveIds(ids, n);
+        if (first) {
+            removed = count;
+            first = false;
+        }
+    });
+    return removed;
+}
+
+void FaissReplicaSet::SetNprobe(int nprobe) {
+    RollingWrite([&](FaissIndexWrapper& index) {
+        index.SetNprobe(nprobe);
+    });
+}
+
+void FaissReplicaSet::Reset() {
+    RollingWrite([](FaissIndexWrapper& index) {
+        index.Reset();
+    });
+}
+
+void FaissReplicaSet::Dispose() {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    for (const auto& replica : replicas_) {
+        std::atomic_load(&replica->index)->Dispose();
+    }
+}
+
+size_t FaissReplicaSet::SearchBatch(const float* queries, size_t nq, int k, std::vector<float>& distances,
+                                    std::vector<int64_t>& labels, const SearchOptions* options) const {
+    Lease replica = Acquire();
+    const size_t ntotal = replica->GetTotalVectors();
+    if (ntotal == 0) {
+        return 0;
+    }
+    const size_t actualK = std::min(static_cast<size_t>(k), ntotal);
+    distances.resize(nq * actualK);
+    labels.resize(nq * actualK);
+    replica->SearchBatch(queries, nq, static_cast<int>(actualK), distances.data(), labels.data(), options);
+    return actualK;
+}
+
+void FaissReplicaSet::ReconstructBatch(const int64_t* ids, size_t n, float* output) const {
+    Lease replica = Acquire();
+    replica->ReconstructBatch(ids, n, output);
+}
@@ -0,0 +1,83 @@
+#ifndef FAISS_NODE_REPLICA_SET_H
+#define FAISS_NODE_REPLICA_SET_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "faiss_index.h"
+
+/**
+ * K in-memory copies of one index, in the spirit of faiss::IndexReplicas. Each read
+ * goes to the replica with the fewest calls in flight, so concurrent searches spread
+ * over separate copies of the data instead of sharing one.
+ *
+ * Writes are rolled through the replicas one at a time rather than broadcast: while
+ * one copy holds its exclusive lock the others keep serving reads, which steer clear
+ * of the copy being written. Writers are serialized over the whole roll, so every
+ * copy applies writes in the same order. A read that overlaps a write may see the
+ * index before or after it; once the write returns, every replica has it.
+ *
+ * The first replica is the primary and is written first, so a write it rejects
+ * leaves all copies untouched. A copy that fails a write the primary accepted is
+ * replaced with a fresh clone of the primary. Training runs on the primary only and
+ * is cloned to the other copies.
+ */
+class FaissReplicaSet {
+public:
+    // Takes primary and clones it until there are replicas copies (at least one).
+    FaissReplicaSet(std::unique_ptr<FaissIndexWrapper> primary, size_t replicas);
+
+    FaissReplicaSet(const FaissReplicaSet&) = delete;
+    FaissReplicaSet& operator=(const FaissReplicaSet&) = delete;
+
+    size_t ReplicaCount() const {
+        return replicas_.size();
+    }
+
+    void AddWithIds(const float* vectors, const int64_t* ids, size_t n);
+    void Train(const float* vectors, size_t n);
+    size_t RemoveIds(const int64_t* ids, size_t n);
+    void SetNprobe(int nprobe);
+    void Reset();
+    void Dispose();
+
+    // Searches one replica with k clamped to its size and returns the k used,
+    // resizing distances and labels to nq * that k; 0 when the replica is empty.
+    size_t SearchBatch(const float* queries, size_t nq, int k, std::vector<float>& distances,
+                       std::vector<int64_t>& labels, const SearchOptions* options) const;
+    void ReconstructBatch(const int64_t* ids, size_t n, float* output) const;
+
+    // Read from the first replica, which is always the most up to date and is never
+    // replaced
+    const FaissIndexWrapper& Primary() const {
+        return *replicas_[0]->index;
+    }
+
+private:
+    struct Replica {
+        // Swapped with std::atomic_store when the copy is resynced
+        std::shared_ptr<FaissIndexWrapper> index;
+        // Calls in flight, plus kWriteWeight while a write holds the replica
+        mutable std::atomic<int64_t> load{0};
+    };
+
+    class Lease;
+
+    // Claims the least loaded replica for a read
+    Lease Acquire() const;
+
+    template <typename Fn>
+    void RollingWrite(const Fn& fn);
+
+    // Replaces a copy with a clone of the primary. Caller holds write_mutex_.
+    void Resync(Replica& replica);
+
+    std::mutex write_mutex_;  // held for a whole write roll, and for Train and Dispose
+    std::vector<std::unique_ptr<Replica>> replicas_;
+};
+
+#endif // FAISS_NODE_REPLICA_SET_H
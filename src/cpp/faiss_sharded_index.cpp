@@ -0,0 +1,563 @@
+#include "faiss_sharded_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "parallel_for.h"
+#include "thread_control.h"
+
+namespace {
+
+constexpr char kShardMagic[8] = {'F', 'N', 'S', 'H', 'A', 'R', 'D', 'S'};
+constexpr uint32_t kShardFormatVersion = 1;
+
+// Runs fn(shard) for every shard in an OpenMP parallel loop on the calling thread's
+// persistent OpenMP team, so a fan-out starts no threads of its own. The caller's
+// OpenMP budget is split between the shards so a fan-out does not multiply the thread
+// count; when there are fewer shards than threads, nesting is enabled for the loop so
+// each shard's FAISS call can use its share. Builds without OpenMP fan the shards out
+// over the calling thread's executor lane instead. The first exception is rethrown
+// after every shard has finished.
+template <typename Fn>
+void ForEachShard(size_t count, const Fn& fn) {
+    if (count == 1) {
+        fn(0);
+        return;
+    }
+
+#ifndef _OPENMP
+    ExecutorParallelFor(count, count, fn);
+#else
+    const int budget = CurrentOmpThreads();
+    const int team = std::max(1, std::min(budget, static_cast<int>(count)));
+    const int perShard = std::max(1, budget / static_cast<int>(count));
+    std::vector<std::exception_ptr> errors(count);
+    const int64_t shards = static_cast<int64_t>(count);
+
+    // max-active-levels is part of the calling task's data environment (OpenMP 5.0)
+    const int levels = omp_get_max_active_levels();
+    if (perShard > 1 && levels < 2) {
+        omp_set_max_active_levels(2);
+    }
+
+#pragma omp parallel for num_threads(team) schedule(dynamic, 1)
+    for (int64_t shard = 0; shard < shards; shard++) {
+        ScopedOmpThreads scope(perShard);
+        try {
+            fn(static_cast<size_t>(shard));
+        } catch (...) {
+            errors[static_cast<size_t>(shard)] = std::current_exception();
+        }
+    }
+
+    if (perShard > 1 && levels < 2) {
+        omp_set_max_active_levels(levels);
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+#endif
+}
+
+// One shard's vectors and ids after routing
+struct ShardBatch {
+    std::vector<float> vectors;
+    std::vector<int64_t> ids;
+};
+
+std::vector<ShardBatch> Partition(const float* vectors, const int64_t* ids, size_t n, size_t dims, size_t count) {
+    std::vector<ShardBatch> batches(count);
+    for (size_t i = 0; i < n; i++) {
+        ShardBatch& batch = batches[FaissShardedIndex::ShardFor(ids[i], count)];
+        batch.vectors.insert(batch.vectors.end(), vectors + i * dims, vectors + (i + 1) * dims);
+        batch.ids.push_back(ids[i]);
+    }
+    return batches;
+}
+
+// One shard's answer to a batch search: nq rows of k results, best first
+struct ShardResult {
+    size_t k = 0;
+    std::vector<float> distances;
+    std::vector<int64_t> labels;
+};
+
+// Merges each query's per-shard lists into its best k. Slots with no candidate left
+// get label -1 and the worst possible distance, as FAISS pads its own results.
+void MergeTopK(const std::vector<ShardResult>& parts, size_t nq, size_t k, bool largerIsBetter,
+               float* distances, int64_t* labels) {
+    const float worst = largerIsBetter ? -std::numeric_limits<float>::infinity()
+                                       : std::numeric_limits<float>::infinity();
+    ParallelFor(nq, true, [&](size_t q) {
+        std::vector<size_t> cursor(parts.size(), 0);
+        for (size_t slot = 0; slot < k; slot++) {
+            size_t best = parts.size();
+            float bestDistance = worst;
+            for (size_t s = 0; s < parts.size(); s++) {
+                const ShardResult& part = parts[s];
+                if (cursor[s] >= part.k || part.labels[q * part.k + cursor[s]] < 0) {
+                    continue;
+                }
+                const float d = part.distances[q * part.k + cursor[s]];
+                if (best == parts.size() || (largerIsBetter ? d > bestDistance : d < bestDistance)) {
+                    best = s;
+                    bestDistance = d;
+                }
+            }
+
+            float* outDistance = distances + q * k + slot;
+            int64_t* outLabel = labels + q * k + slot;
+            if (best == parts.size()) {
+                *outDistance = worst;
+                *outLabel = -1;
+                continue;
+            }
+            const ShardResult& part = parts[best];
+            *outDistance = bestDistance;
+            *outLabel = part.labels[q * part.k + cursor[best]];
+            cursor[best]++;
+        }
+    });
+}
+
+template <typename T>
+void AppendRaw(std::vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// Bounds-checked reader over a serialized shard set
+class ShardSetReader {
+public:
+    ShardSetReader(const uint8_t* data, size_t length) : data_(data), length_(length) {}
+
+    template <typename T>
+    T Read() {
+        T value;
+        std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    const uint8_t* Take(size_t bytes) {
+        if (bytes > length_ - position_) {
+            throw std::runtime_error("Sharded index data is truncated");
+        }
+        const uint8_t* start = data_ + position_;
+        position_ += bytes;
+        return start;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t length_;
+    size_t position_ = 0;
+};
+
+std::vector<uint8_t> SerializeHeader(size_t shards, int64_t nextId) {
+    std::vector<uint8_t> header(kShardMagic, kShardMagic + sizeof(kShardMagic));
+    AppendRaw(header, kShardFormatVersion);
+    AppendRaw(header, static_cast<uint32_t>(shards));
+    AppendRaw(header, nextId);
+    return header;
+}
+
+} // namespace
+
+FaissShardedIndex::FaissShardedIndex(std::vector<std::unique_ptr<FaissIndexWrapper>> shards, int64_t nextId,
+                                     size_t replicas)
+    : replicas_(std::max<size_t>(replicas, 1)), next_id_(nextId) {
+    if (shards.empty()) {
+        throw std::invalid_argument("A sharded index needs at least one shard");
+    }
+    dims_ = shards[0]->GetDimensions();
+    larger_is_better_ = shards[0]->GetMetricName() == "ip";
+    for (auto& shard : shards) {
+        CheckCompatible(*shard);
+        shards_.push_back(std::make_shared<FaissReplicaSet>(std::move(shard), replicas_));
+    }
+}
+
+size_t FaissShardedIndex::ShardFor(int64_t id, size_t count) {
+    // splitmix64 finalizer: consecutive ids land on different shards, and the
+    // mapping never changes, so saved shard sets route the same way after loading.
+    uint64_t z = static_cast<uint64_t>(id) + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    return static_cast<size_t>(z % count);
+}
+
+FaissShardedIndex::Shards FaissShardedIndex::Snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (disposed_) {
+        throw std::runtime_error("Index has been disposed");
+    }
+    return shards_;
+}
+
+void FaissShardedIndex::CheckCompatible(const FaissIndexWrapper& shard) const {
+    if (shard.GetDimensions() != dims_) {
+        throw std::invalid_argument(
+            "Shard dimensions must match index dimensions. Got " + std::to_string(shard.GetDimensions()) +
+            ", expected " + std::to_string(dims_));
+    }
+    if ((shard.GetMetricName() == "ip") != larger_is_better_) {
+        throw std::invalid_argument("Every shard must use the same metric");
+    }
+    if (!shard.IsIdMapped()) {
+        throw std::invalid_argument("Shards must be id-mapped so labels stay global");
+    }
+}
+
+void FaissShardedIndex::ReserveIds(const int64_t* ids, size_t n) {
+    int64_t highest = -1;
+    for (size_t i = 0; i < n; i++) {
+        highest = std::max(highest, ids[i]);
+    }
+    int64_t current = next_id_.load();
+    while (highest >= current && !next_id_.compare_exchange_weak(current, highest + 1)) {
+    }
+}
+
+int64_t FaissShardedIndex::Add(const float* vectors, size_t n) {
+    const int64_t first = next_id_.fetch_add(static_cast<int64_t>(n));
+    std::vector<int64_t> ids(n);
+    for (size_t i = 0; i < n; i++) {
+        ids[i] = first + static_cast<int64_t>(i);
+    }
+    AddWithIds(vectors, ids.data(), n);
+    return first;
+}
+
+void FaissShardedIndex::AddWithIds(const float* vectors, const int64_t* ids, size_t n) {
+    Shards shards = Snapshot();
+    if (vectors == nullptr || ids == nullptr) {
+        throw std::invalid_argument("Vectors and ids pointers cannot be null");
+    }
+    if (n == 0) {
+        return;
+    }
+
+    ReserveIds(ids, n);
+    std::vector<ShardBatch> batches = Partition(vectors, ids, n, static_cast<size_t>(dims_), shards.size());
+    ForEachShard(shards.size(), [&](size_t s) {
+        if (!batches[s].ids.empty()) {
+            shards[s]->AddWithIds(batches[s].vectors.data(), batches[s].ids.data(), batches[s].ids.size());
+        }
+    });
+}
+
+void FaissShardedIndex::Train(const float* vectors, size_t n) {
+    Shards shards = Snapshot();
+    ForEachShard(shards.size(), [&](size_t s) {
+        shards[s]->Train(vectors, n);
+    });
+}
+
+void FaissShardedIndex::SearchBatch(const float* queries, size_t nq, int k, float* distances, int64_t* labels,
+                                    const SearchOptions* options) const {
+    Shards shards = Snapshot();
+    if (queries == nullptr || distances == nullptr || labels == nullptr) {
+        throw std::invalid_argument("Query and output pointers cannot be null");
+    }
+    if (nq == 0 || k <= 0) {
+        throw std::invalid_argument("nq and k must be positive");
+    }
+
+    std::vector<ShardResult> parts(shards.size());
+    ForEachShard(shards.size(), [&](size_t s) {
+        // Each shard clamps k to its own size and skips the search when empty
+        ShardResult& part = parts[s];
+        part.k = shards[s]->SearchBatch(queries, nq, k, part.distances, part.labels, options);
+    });
+
+    MergeTopK(parts, nq, static_cast<size_t>(k), larger_is_better_, distances, labels);
+}
+
+void FaissShardedIndex::Reconstruct(int64_t id, float* output) const {
+    Shards shards = Snapshot();
+    if (id < 0) {
+        throw std::out_of_range("Vector id is out of range");
+    }
+    shards[ShardFor(id, shards.size())]->ReconstructBatch(&id, 1, output);
+}
+
+void FaissShardedIndex::ReconstructBatch(const int64_t* ids, size_t n, float* output) const {
+    Shards shards = Snapshot();
+    if (ids == nullptr || output == nullptr) {
+        throw std::invalid_argument("Ids and output pointers cannot be null");
+    }
+
+    // Group the ids by shard, decode each group in one call, then scatter back
+    std::vector<std::vector<size_t>> positions(shards.size());
+    for (size_t i = 0; i < n; i++) {
+        if (ids[i] < 0) {
+            throw std::out_of_range("Vector id is out of range");
+        }
+        positions[ShardFor(ids[i], shards.size())].push_back(i);
+    }
+
+    const size_t dims = static_cast<size_t>(dims_);
+    for (size_t s = 0; s < shards.size(); s++) {
+        if (positions[s].empty()) {
+            continue;
+        }
+        std::vector<int64_t> shardIds(positions[s].size());
+        for (size_t j = 0; j < positions[s].size(); j++) {
+            shardIds[j] = ids[positions[s][j]];
+        }
+        std::vector<float> decoded(shardIds.size() * dims);
+        shards[s]->ReconstructBatch(shardIds.data(), shardIds.size(), decoded.data());
+        for (size_t j = 0; j < positions[s].size(); j++) {
+            std::memcpy(output + positions[s][j] * dims, decoded.data() + j * dims, dims * sizeof(float));
+        }
+    }
+}
+
+size_t FaissShardedIndex::RemoveIds(const int64_t* ids, size_t n) {
+    Shards shards = Snapshot();
+    if (ids == nullptr) {
+        throw std::invalid_argument("Ids pointer cannot be null");
+    }
+
+    std::vector<std::vector<int64_t>> grouped(shards.size());
+    for (size_t i = 0; i < n; i++) {
+        if (ids[i] < 0) {
+            throw std::invalid_argument("Ids must be non-negative");
+        }
+        grouped[ShardFor(ids[i], shards.size())].push_back(ids[i]);
+    }
+
+    size_t removed = 0;
+    for (size_t s = 0; s < shards.size(); s++) {
+        if (!grouped[s].empty()) {
+            removed += shards[s]->RemoveIds(grouped[s].data(), grouped[s].size());
+        }
+    }
+    return removed;
+}
+
+void FaissShardedIndex::SetNprobe(int nprobe) {
+    for (const auto& shard : Snapshot()) {
+        shard->SetNprobe(nprobe);
+    }
+}
+
+void FaissShardedIndex::Reset() {
+    for (const auto& shard : Snapshot()) {
+        shard->Reset();
+    }
+    next_id_.store(0);
+}
+
+void FaissShardedIndex::Dispose() {
+    Shards shards;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (disposed_) {
+            return;
+        }
+        disposed_ = true;
+        shards.swap(shards_);
+    }
+    // Waits for in-flight calls on each shard; later ones see it disposed
+    for (const auto& shard : shards) {
+        shard->Dispose();
+    }
+}
+
+bool FaissShardedIndex::IsDisposed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return disposed_;
+}
+
+size_t FaissShardedIndex::ShardCount() const {
+    return Snapshot().size();
+}
+
+std::vector<size_t> FaissShardedIndex::GetShardSizes() const {
+    Shards shards = Snapshot();
+    std::vector<size_t> sizes;
+    sizes.reserve(shards.size());
+    for (const auto& shard : shards) {
+        sizes.push_back(shard->Primary().GetTotalVectors());
+    }
+    return sizes;
+}
+
+size_t FaissShardedIndex::GetTotalVectors() const {
+    size_t total = 0;
+    for (const auto& shard : Snapshot()) {
+        total += shard->Primary().GetTotalVectors();
+    }
+    return total;
+}
+
+bool FaissShardedIndex::IsTrained() const {
+    for (const auto& shard : Snapshot()) {
+        if (!shard->Primary().IsTrained()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string FaissShardedIndex::GetIndexType() const {
+    return Snapshot()[0]->Primary().GetIndexType();
+}
+
+std::string FaissShardedIndex::GetFactoryDescription() const {
+    return Snapshot()[0]->Primary().GetFactoryDescription();
+}
+
+std::string FaissShardedIndex::GetMetricName() const {
+    return larger_is_better_ ? "ip" : "l2";
+}
+
+float FaissShardedIndex::GetRefineKFactor() const {
+    return Snapshot()[0]->Primary().GetRefineKFactor();
+}
+
+std::vector<uint8_t> FaissShardedIndex::ShardToBuffer(size_t shard) const {
+    Shards shards = Snapshot();
+    if (shard >= shards.size()) {
+        throw std::out_of_range("Shard index is out of range");
+    }
+    return shards[shard]->Primary().ToBuffer();
+}
+
+void FaissShardedIndex::ReplaceShard(size_t shard, std::unique_ptr<FaissIndexWrapper> replacement) {
+    if (!replacement) {
+        throw std::invalid_argument("Replacement shard cannot be null");
+    }
+    CheckCompatible(*replacement);
+    auto group = std::make_shared<FaissReplicaSet>(std::move(replacement), replicas_);
+
+    std::shared_ptr<FaissReplicaSet> previous;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (disposed_) {
+            throw std::runtime_error("Index has been disposed");
+        }
+        if (shard >= shards_.size()) {
+            throw std::out_of_range("Shard index is out of range");
+        }
+        previous = std::move(shards_[shard]);
+        shards_[shard] = std::move(group);
+    }
+    // Calls that took their snapshot before the swap keep the old shard alive until they finish
+}
+
+void FaissShardedIndex::Save(const std::string& filename) const {
+    if (filename.empty()) {
+        throw std::invalid_argument("Filename cannot be empty");
+    }
+    Shards shards = Snapshot();
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to save index: cannot open " + filename);
+    }
+    const std::vector<uint8_t> header = SerializeHeader(shards.size(), next_id_.load());
+    out.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    // One shard in memory at a time
+    for (const auto& shard : shards) {
+        const std::vector<uint8_t> bytes = shard->Primary().ToBuffer();
+        const uint64_t length = bytes.size();
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+    if (!out.flush()) {
+        throw std::runtime_error("Failed to save index: write error on " + filename);
+    }
+}
+
+std::unique_ptr<FaissShardedIndex> FaissShardedIndex::Load(const std::string& filename, size_t replicas) {
+    if (filename.empty()) {
+        throw std::invalid_argument("Filename cannot be empty");
+    }
+
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to load index: cannot open " + filename);
+    }
+
+    auto readExact = [&](void* target, size_t bytes) {
+        if (!in.read(reinterpret_cast<char*>(target), static_cast<std::streamsize>(bytes))) {
+            throw std::runtime_error("Failed to load index: " + filename + " is truncated");
+        }
+    };
+
+    char magic[sizeof(kShardMagic)];
+    uint32_t version = 0;
+    uint32_t count = 0;
+    int64_t nextId = 0;
+    readExact(magic, sizeof(magic));
+    if (std::memcmp(magic, kShardMagic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Failed to load index: " + filename + " is not a sharded index file");
+    }
+    readExact(&version, sizeof(version));
+    if (version != kShardFormatVersion) {
+        throw std::runtime_error("Failed to load index: unsupported sharded format version " + std::to_string(version));
+    }
+    readExact(&count, sizeof(count));
+    readExact(&nextId, sizeof(nextId));
+
+    // One serialized shard in memory at a time
+    std::vector<std::unique_ptr<FaissIndexWrapper>> shards;
+    std::vector<uint8_t> bytes;
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t length = 0;
+        readExact(&length, sizeof(length));
+        bytes.resize(length);
+        readExact(bytes.data(), bytes.size());
+        shards.push_back(FaissIndexWrapper::FromBuffer(bytes.data(), bytes.size()));
+    }
+    return std::make_unique<FaissShardedIndex>(std::move(shards), nextId, replicas);
+}
+
+std::vector<uint8_t> FaissShardedIndex::ToBuffer() const {
+    Shards shards = Snapshot();
+    std::vector<uint8_t> out = SerializeHeader(shards.size(), next_id_.load());
+    for (const auto& shard : shards) {
+        const std::vector<uint8_t> bytes = shard->Primary().ToBuffer();
+        AppendRaw(out, static_cast<uint64_t>(bytes.size()));
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+    return out;
+}
+
+std::unique_ptr<FaissShardedIndex> FaissShardedIndex::FromBuffer(const uint8_t* data, size_t length,
+                                                                 size_t replicas) {
+    if (data == nullptr || length == 0) {
+        throw std::invalid_argument("Invalid buffer data");
+    }
+
+    ShardSetReader reader(data, length);
+    if (std::memcmp(reader.Take(sizeof(kShardMagic)), kShardMagic, sizeof(kShardMagic)) != 0) {
+        throw std::runtime_error("Buffer does not hold a sharded index");
+    }
+    const uint32_t version = reader.Read<uint32_t>();
+    if (version != kShardFormatVersion) {
+        throw std::runtime_error("Unsupported sharded format version " + std::to_string(version));
+    }
+    const uint32_t count = reader.Read<uint32_t>();
+    const int64_t nextId = reader.Read<int64_t>();
+
+    // Shards parse straight from the caller's memory
+    std::vector<std::unique_ptr<FaissIndexWrapper>> shards;
+    for (uint32_t i = 0; i < count; i++) {
+        const uint64_t size = reader.Read<uint64_t>();
+        const uint8_t* bytes = reader.Take(static_cast<size_t>(size));
+        shards.push_back(FaissIndexWrapper::FromBuffer(bytes, static_cast<size_t>(size)));
+    }
+    return std::make_unique<FaissShardedIndex>(std::move(shards), nextId, replicas);
+}
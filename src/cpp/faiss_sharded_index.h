@@ -0,0 +1,118 @@
+#ifndef FAISS_NODE_SHARDED_INDEX_H
+#define FAISS_NODE_SHARDED_INDEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "faiss_index.h"
+#include "faiss_replica_set.h"
+
+/**
+ * N independent FaissIndexWrapper shards presented as one index, in the spirit of
+ * faiss::IndexShards but with a reader/writer lock per shard: an add only locks the
+ * shards its vectors land on, and a search runs every shard in parallel and merges
+ * the per-shard top-k lists.
+ *
+ * Shards are id-mapped and labels are global ids. A vector lives on the shard its
+ * id hashes to, so reconstruct and removeIds touch a single shard; adds without ids
+ * draw consecutive ids from a shared counter, which spreads them evenly.
+ *
+ * Every operation works on a snapshot of the shard list. ReplaceShard therefore
+ * swaps a rebuilt shard in without waiting for in-flight searches, which finish on
+ * the shard they started with.
+ *
+ * Each shard can be held as several replicas (see FaissReplicaSet), trading memory
+ * for read throughput: one shard with K replicas is a replicated index.
+ */
+class FaissShardedIndex {
+public:
+    // shards: at least one id-mapped index, all with the same dimensions and metric.
+    // nextId: first id handed out by Add.
+    // replicas: copies kept of each shard (at least one).
+    explicit FaissShardedIndex(std::vector<std::unique_ptr<FaissIndexWrapper>> shards, int64_t nextId = 0,
+                               size_t replicas = 1);
+
+    FaissShardedIndex(const FaissShardedIndex&) = delete;
+    FaissShardedIndex& operator=(const FaissShardedIndex&) = delete;
+
+    // Shard that stores id, for a set of count shards
+    static size_t ShardFor(int64_t id, size_t count);
+
+    // Adds vectors under consecutive ids starting at the returned value
+    int64_t Add(const float* vectors, size_t n);
+    void AddWithIds(const float* vectors, const int64_t* ids, size_t n);
+
+    // Trains every shard on the same sample, in parallel
+    void Train(const float* vectors, size_t n);
+
+    // k must not exceed GetTotalVectors(); missing results are padded with label -1
+    void SearchBatch(const float* queries, size_t nq, int k, float* distances, int64_t* labels,
+                     const SearchOptions* options = nullptr) const;
+
+    void Reconstruct(int64_t id, float* output) const;
+    void ReconstructBatch(const int64_t* ids, size_t n, float* output) const;
+    size_t RemoveIds(const int64_t* ids, size_t n);
+
+    void SetNprobe(int nprobe);
+    void Reset();
+    void Dispose();
+    bool IsDisposed() const;
+
+    size_t ShardCount() const;
+    size_t ReplicaCount() const {
+        return replicas_;
+    }
+    std::vector<size_t> GetShardSizes() const;
+    size_t GetTotalVectors() const;
+    int GetDimensions() const {
+        return dims_;
+    }
+    bool IsTrained() const;
+    std::string GetIndexType() const;
+    std::string GetFactoryDescription() const;
+    std::string GetMetricName() const;
+    float GetRefineKFactor() const;
+    int64_t NextId() const {
+        return next_id_.load();
+    }
+
+    // Serializes one shard in the plain single-index format
+    std::vector<uint8_t> ShardToBuffer(size_t shard) const;
+
+    // Swaps in a replacement for one shard, cloned into every replica. The replacement
+    // should only hold ids that route to that shard; others stay searchable but not
+    // reconstructable or removable.
+    void ReplaceShard(size_t shard, std::unique_ptr<FaissIndexWrapper> replacement);
+
+    // The whole shard set in one file or buffer: a small header, the id counter, and
+    // each shard's FAISS serialization. Replicas are not stored; loading builds them.
+    void Save(const std::string& filename) const;
+    static std::unique_ptr<FaissShardedIndex> Load(const std::string& filename, size_t replicas = 1);
+    std::vector<uint8_t> ToBuffer() const;
+    static std::unique_ptr<FaissShardedIndex> FromBuffer(const uint8_t* data, size_t length, size_t replicas = 1);
+
+private:
+    using Shards = std::vector<std::shared_ptr<FaissReplicaSet>>;
+
+    // Current shard list; throws once disposed
+    Shards Snapshot() const;
+
+    void CheckCompatible(const FaissIndexWrapper& shard) const;
+
+    // Moves next_id_ past every id in ids so Add never reuses one
+    void ReserveIds(const int64_t* ids, size_t n);
+
+    mutable std::mutex mutex_;  // guards the shard list and disposed_, not shard contents
+    Shards shards_;
+    bool disposed_ = false;
+    int dims_;
+    bool larger_is_better_;
+    size_t replicas_;
+    std::atomic<int64_t> next_id_;
+};
+
+#endif // FAISS_NODE_SHARDED_INDEX_H
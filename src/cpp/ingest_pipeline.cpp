@@ -0,0 +1,239 @@
+#include "ingest_pipeline.h"
+
+#include "executor.h"
+#include "faiss_index.h"
+#include "thread_control.h"
+#include "vector_kernels.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void RunAll(std::vector<std::function<void()>>& due) {
+    for (auto& callback : due) {
+        callback();
+    }
+    due.clear();
+}
+
+} // namespace
+
+IngestPipeline::IngestPipeline(std::shared_ptr<FaissIndexWrapper> index, const IngestOptions& options)
+    : index_(std::move(index)),
+      options_(options),
+      dims_(static_cast<size_t>(index_->GetDimensions())) {
+    if (options_.queue_depth == 0) {
+        options_.queue_depth = 1;
+    }
+}
+
+bool IngestPipeline::Push(std::vector<float>&& vectors, PushCallback done) {
+    if (vectors.empty() || vectors.size() % dims_ != 0) {
+        throw std::invalid_argument(
+            "Batch length must be a non-zero multiple of " + std::to_string(dims_));
+    }
+
+    DueCallbacks due;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        if (closed_) {
+            throw std::runtime_error("Ingest stream is closed");
+        }
+        if (!waiting_.empty() || incoming_.size() >= options_.queue_depth) {
+            waiting_.push_back(WaitingBatch{std::move(vectors), std::move(done)});
+            return false;
+        }
+        incoming_.push_back(std::move(vectors));
+        Schedule(due);
+    }
+    RunAll(due);
+    return true;
+}
+
+void IngestPipeline::Finish(FinishCallback done) {
+    DueCallbacks due;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (on_finish_) {
+            throw std::runtime_error("Ingest stream is already finishing");
+        }
+        closed_ = true;
+        on_finish_ = std::move(done);
+        Schedule(due);
+    }
+    RunAll(due);
+}
+
+void IngestPipeline::Abort() {
+    DueCallbacks due;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        aborted_ = true;
+        incoming_.clear();
+        validated_.clear();
+        auto closed = std::make_exception_ptr(std::runtime_error("Ingest stream is closed"));
+        for (auto& batch : waiting_) {
+            PushCallback callback = std::move(batch.done);
+            due.push_back([callback, closed]() { callback(closed); });
+        }
+        waiting_.clear();
+        Schedule(due);
+    }
+    RunAll(due);
+}
+
+void IngestPipeline::Schedule(DueCallbacks& due) {
+    while (!waiting_.empty() && incoming_.size() < options_.queue_depth) {
+        incoming_.push_back(std::move(waiting_.front().vectors));
+        PushCallback callback = std::move(waiting_.front().done);
+        waiting_.pop_front();
+        due.push_back([callback]() { callback(nullptr); });
+    }
+
+    if (!validating_ && !incoming_.empty() && validated_.size() < options_.queue_depth) {
+        validating_ = true;
+        std::shared_ptr<IngestPipeline> self = shared_from_this();
+        Executor::Instance().Submit(ExecutorLane::Background, [self]() { self->ValidateStage(); });
+    }
+    if (!inserting_ && !validated_.empty()) {
+        inserting_ = true;
+        std::shared_ptr<IngestPipeline> self = shared_from_this();
+        Executor::Instance().Submit(ExecutorLane::Background, [self]() { self->InsertStage(); });
+    }
+
+    const bool drained = waiting_.empty() && incoming_.empty() && validated_.empty();
+    if (on_finish_ && drained && !validating_ && !inserting_) {
+        FinishCallback callback = std::move(on_finish_);
+        on_finish_ = nullptr;
+        const size_t added = added_.load();
+        std::exception_ptr error = error_;
+        due.push_back([callback, added, error]() { callback(added, error); });
+    }
+}
+
+void IngestPipeline::ValidateStage() {
+    for (;;) {
+        DueCallbacks due;
+        std::vector<float> batch;
+        size_t offset = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Give the thread back once there is nothing to do or nowhere to put it
+            if (error_ || aborted_ || incoming_.empty() || validated_.size() >= options_.queue_depth) {
+                validating_ = false;
+                Schedule(due);
+            } else {
+                batch = std::move(incoming_.front());
+                incoming_.pop_front();
+                offset = offset_;
+                offset_ += batch.size() / dims_;
+                Schedule(due);
+            }
+        }
+        RunAll(due);
+        if (batch.empty()) {
+            return;
+        }
+
+        try {
+            Validate(batch, offset);
+        } catch (...) {
+            Fail(std::current_exception());
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_ && !aborted_) {
+                validated_.push_back(std::move(batch));
+                Schedule(due);
+            }
+        }
+        RunAll(due);
+    }
+}
+
+void IngestPipeline::InsertStage() {
+    ScopedOmpThreads scope;
+    for (;;) {
+        DueCallbacks due;
+        std::vector<float> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error_ || aborted_ || validated_.empty()) {
+                inserting_ = false;
+                Schedule(due);
+            } else {
+                batch = std::move(validated_.front());
+                validated_.pop_front();
+                Schedule(due);
+            }
+        }
+        RunAll(due);
+        if (batch.empty()) {
+            return;
+        }
+
+        const size_t n = batch.size() / dims_;
+        try {
+            index_->Add(batch.data(), n);
+        } catch (...) {
+            Fail(std::current_exception());
+            continue;
+        }
+        added_ += n;
+    }
+}
+
+void IngestPipeline::Validate(std::vector<float>& batch, size_t offset) const {
+    const size_t n = batch.size() / dims_;
+    // Normalizing also stops at the first non-finite component. Without validate, that
+    // vector is passed through as it is and normalizing resumes after it.
+    size_t bad = n;  // first non-finite vector in the batch
+    if (options_.normalize) {
+        size_t done = 0;
+        while (done < n) {
+            float* rest = batch.data() + done * dims_;
+            const size_t found = NormalizeL2Vectors(rest, n - done, dims_, rest);
+            if (found == (n - done) * dims_) {
+                break;
+            }
+            if (options_.validate) {
+                bad = done + found / dims_;
+                break;
+            }
+            done += found / dims_ + 1;
+        }
+    } else if (options_.validate) {
+        bad = FindNonFinite(batch.data(), batch.size()) / dims_;
+    }
+    if (bad != n) {
+        throw std::invalid_argument(
+            "Vector " + std::to_string(offset + bad) + " contains NaN or Infinity");
+    }
+}
+
+void IngestPipeline::Fail(std::exception_ptr error) {
+    DueCallbacks due;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+            error_ = error;
+        }
+        incoming_.clear();
+        validated_.clear();
+        for (auto& batch : waiting_) {
+            PushCallback callback = std::move(batch.done);
+            std::exception_ptr first = error_;
+            due.push_back([callback, first]() { callback(first); });
+        }
+        waiting_.clear();
+        Schedule(due);
+    }
+    RunAll(due);
+}
@@ -0,0 +1,97 @@
+#ifndef FAISS_NODE_INGEST_PIPELINE_H
+#define FAISS_NODE_INGEST_PIPELINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class FaissIndexWrapper;
+
+struct IngestOptions {
+    bool validate = true;    // reject batches containing NaN or Infinity
+    bool normalize = false;  // L2-normalize each vector before it is added
+    size_t queue_depth = 4;  // batches buffered between each pair of stages
+};
+
+/**
+ * Two-stage ingest: a validation stage checks (and optionally normalizes) each batch
+ * while an insertion stage adds the previous one, so a stream of batches runs at the
+ * speed of the slower stage rather than the sum of both. Each stage runs as a task on
+ * the executor's background lane only while it has work, and gives its thread back as
+ * soon as its input is empty or its output is full, so a slow or idle stream holds no
+ * thread. Queues of queue_depth batches ahead of each stage cap memory at
+ * 2 * queue_depth batches; a batch pushed while the first queue is full waits outside
+ * it until there is room.
+ *
+ * Nothing here blocks: Push and Finish report completion through callbacks, which may
+ * run on an executor thread. The first error from any stage cancels the pipeline and
+ * is passed to every pending and later callback. Batches added before the error stay
+ * in the index. Create with std::make_shared; running stages hold a reference.
+ */
+class IngestPipeline : public std::enable_shared_from_this<IngestPipeline> {
+public:
+    // Runs once a waiting batch has been queued, or with the error that stopped the pipeline
+    using PushCallback = std::function<void(std::exception_ptr)>;
+    // Runs once every queued batch has been added, with the number of vectors added
+    using FinishCallback = std::function<void(size_t, std::exception_ptr)>;
+
+    IngestPipeline(std::shared_ptr<FaissIndexWrapper> index, const IngestOptions& options);
+
+    IngestPipeline(const IngestPipeline&) = delete;
+    IngestPipeline& operator=(const IngestPipeline&) = delete;
+
+    // Queues a batch of n * dims floats. Returns true if it was queued at once;
+    // otherwise it waits for room and done runs when it is queued. Throws if the batch
+    // is malformed, or the pipeline has failed or been closed.
+    bool Push(std::vector<float>&& vectors, PushCallback done);
+
+    // Closes the input; done runs once every queued batch has been added.
+    void Finish(FinishCallback done);
+
+    // Drops queued and waiting batches. A stage in the middle of a batch finishes it.
+    void Abort();
+
+    size_t Added() const {
+        return added_.load();
+    }
+
+private:
+    struct WaitingBatch {
+        std::vector<float> vectors;
+        PushCallback done;
+    };
+
+    using DueCallbacks = std::vector<std::function<void()>>;
+
+    void ValidateStage();
+    void InsertStage();
+    // Admits waiting batches, starts idle stages that have work, and collects the
+    // callbacks that are now due. Caller holds mutex_.
+    void Schedule(DueCallbacks& due);
+    void Fail(std::exception_ptr error);
+    void Validate(std::vector<float>& batch, size_t offset) const;
+
+    std::shared_ptr<FaissIndexWrapper> index_;
+    IngestOptions options_;
+    size_t dims_;
+    std::atomic<size_t> added_{0};
+
+    std::mutex mutex_;
+    std::deque<std::vector<float>> incoming_;
+    std::deque<std::vector<float>> validated_;
+    std::deque<WaitingBatch> waiting_;
+    FinishCallback on_finish_;
+    std::exception_ptr error_;
+    size_t offset_ = 0;  // vectors taken for validation so far, for error messages
+    bool validating_ = false;
+    bool inserting_ = false;
+    bool closed_ = false;
+    bool aborted_ = false;
+};
+
+#endif // FAISS_NODE_INGEST_PIPELINE_H
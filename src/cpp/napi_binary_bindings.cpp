@@ -7,14 +7,18 @@
 
 #include "faiss_binary_index.h"
 #include "napi_binary_bindings.h"
+#include "napi_executor.h"
+#include "napi_external.h"
+#include "thread_control.h"
 
-class BinaryOwnedAsyncWorker : public Napi::AsyncWorker {
+class BinaryOwnedAsyncWorker : public LaneWorker {
 public:
     BinaryOwnedAsyncWorker(
             const Napi::Object& owner,
             Napi::Promise::Deferred deferred,
-            const char* name)
-        : Napi::AsyncWorker(deferred.Env(), name),
+            const char* name,
+            ExecutorLane lane)
+        : LaneWorker(deferred.Env(), name, lane),
           owner_ref_(Napi::Persistent(owner)),
           deferred_(deferred) {}
 
@@ -29,14 +33,15 @@ protected:
     Napi::Promise::Deferred deferred_;
 };
 
-class BinaryDualOwnedAsyncWorker : public Napi::AsyncWorker {
+class BinaryDualOwnedAsyncWorker : public LaneWorker {
 public:
     BinaryDualOwnedAsyncWorker(
             const Napi::Object& primaryOwner,
             const Napi::Object& secondaryOwner,
             Napi::Promise::Deferred deferred,
-            const char* name)
-        : Napi::AsyncWorker(deferred.Env(), name),
+            const char* name,
+            ExecutorLane lane)
+        : LaneWorker(deferred.Env(), name, lane),
           primary_owner_ref_(Napi::Persistent(primaryOwner)),
           secondary_owner_ref_(Napi::Persistent(secondaryOwner)),
           deferred_(deferred) {}
@@ -63,12 +68,13 @@ public:
             size_t n,
             int codeSize,
             Napi::Promise::Deferred deferred)
-        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryAddWorker"),
+        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryAddWorker", ExecutorLane::Background),
           wrapper_(wrapper),
           vectors_(vectors, vectors + n * static_cast<size_t>(codeSize)),
           n_(n) {}
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
@@ -105,12 +111,13 @@ public:
             size_t n,
             int codeSize,
             Napi::Promise::Deferred deferred)
-        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryTrainWorker"),
+        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryTrainWorker", ExecutorLane::Background),
           wrapper_(wrapper),
           vectors_(vectors, vectors + n * static_cast<size_t>(codeSize)),
           n_(n) {}
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
@@ -147,12 +154,13 @@ public:
             int codeSize,
             int k,
             Napi::Promise::Deferred deferred)
-        : BinaryOwnedAsyncWorker(owner, deferred, "BinarySearchWorker"),
+        : BinaryOwnedAsyncWorker(owner, deferred, "BinarySearchWorker", ExecutorLane::Interactive),
           wrapper_(wrapper),
           query_(query, query + codeSize),
           k_(k) {}
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
@@ -216,13 +224,14 @@ public:
             int codeSize,
             int k,
             Napi::Promise::Deferred deferred)
-        : BinaryOwnedAsyncWorker(owner, deferred, "BinarySearchBatchWorker"),
+        : BinaryOwnedAsyncWorker(owner, deferred, "BinarySearchBatchWorker", ExecutorLane::Interactive),
           wrapper_(wrapper),
           queries_(queries, queries + nq * static_cast<size_t>(codeSize)),
           nq_(nq),
           k_(k) {}
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
@@ -291,7 +300,7 @@ public:
             FaissBinaryIndexWrapper* wrapper,
             int64_t id,
             Napi::Promise::Deferred deferred)
-        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryReconstructWorker"),
+        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryReconstructWorker", ExecutorLane::Interactive),
           wrapper_(wrapper),
           id_(id) {}
 
@@ -335,21 +344,32 @@ public:
             FaissBinaryIndexWrapper* wrapper,
             const int32_t* ids,
             size_t n,
+            Napi::Uint8Array target,
             Napi::Promise::Deferred deferred)
-        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryReconstructBatchWorker"),
+        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryReconstructBatchWorker", ExecutorLane::Interactive),
           wrapper_(wrapper),
-          ids_(ids, ids + n) {}
+          ids_(ids, ids + n) {
+        if (!target.IsEmpty()) {
+            target_ = target.Data();
+            target_ref_ = Napi::Persistent(static_cast<const Napi::Object&>(target));
+        }
+    }
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
                 return;
             }
 
-            output_.resize(ids_.size() * static_cast<size_t>(wrapper_->GetCodeSize()));
+            uint8_t* output = target_;
+            if (output == nullptr) {
+                output_.resize(ids_.size() * static_cast<size_t>(wrapper_->GetCodeSize()));
+                output = output_.data();
+            }
             std::vector<int64_t> ids64(ids_.begin(), ids_.end());
-            wrapper_->ReconstructBatch(ids64.data(), ids64.size(), output_.data());
+            wrapper_->ReconstructBatch(ids64.data(), ids64.size(), output);
         } catch (const std::exception& e) {
             SetError(std::string("FAISS error: ") + e.what());
         }
@@ -357,8 +377,13 @@ public:
 
     void OnOK() override {
         Napi::Env env = Env();
-        Napi::Uint8Array result = Napi::Uint8Array::New(env, output_.size());
-        memcpy(result.Data(), output_.data(), output_.size() * sizeof(uint8_t));
+        Napi::Value result;
+        if (target_ != nullptr) {
+            result = target_ref_.Value();
+        } else {
+            size_t length = output_.size();
+            result = Napi::Uint8Array::New(env, length, ExternalArrayBuffer(env, std::move(output_)), 0);
+        }
         ReleaseOwner();
         deferred_.Resolve(result);
     }
@@ -372,6 +397,8 @@ private:
     FaissBinaryIndexWrapper* wrapper_;
     std::vector<int32_t> ids_;
     std::vector<uint8_t> output_;
+    uint8_t* target_ = nullptr;
+    Napi::ObjectReference target_ref_;
 };
 
 class BinaryRemoveIdsWorker : public BinaryOwnedAsyncWorker {
@@ -382,12 +409,13 @@ public:
             const int32_t* ids,
             size_t n,
             Napi::Promise::Deferred deferred)
-        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryRemoveIdsWorker"),
+        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryRemoveIdsWorker", ExecutorLane::Background),
           wrapper_(wrapper),
           ids_(ids, ids + n),
           removed_(0) {}
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
@@ -424,7 +452,7 @@ public:
             FaissBinaryIndexWrapper* wrapper,
             const std::string& filename,
             Napi::Promise::Deferred deferred)
-        : BinaryOwnedAsyncWorker(owner, deferred, "BinarySaveWorker"),
+        : BinaryOwnedAsyncWorker(owner, deferred, "BinarySaveWorker", ExecutorLane::Background),
           wrapper_(wrapper),
           filename_(filename) {}
 
@@ -461,7 +489,7 @@ public:
             const Napi::Object& owner,
             FaissBinaryIndexWrapper* wrapper,
             Napi::Promise::Deferred deferred)
-        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryToBufferWorker"),
+        : BinaryOwnedAsyncWorker(owner, deferred, "BinaryToBufferWorker", ExecutorLane::Background),
           wrapper_(wrapper) {}
 
     void Execute() override {
@@ -478,7 +506,7 @@ public:
 
     void OnOK() override {
         Napi::Env env = Env();
-        Napi::Buffer<uint8_t> nodeBuffer = Napi::Buffer<uint8_t>::Copy(env, buffer_.data(), buffer_.size());
+        Napi::Buffer<uint8_t> nodeBuffer = ExternalBuffer(env, std::move(buffer_));
         ReleaseOwner();
         deferred_.Resolve(nodeBuffer);
     }
@@ -501,11 +529,12 @@ public:
             const Napi::Object& sourceOwner,
             FaissBinaryIndexWrapper* source,
             Napi::Promise::Deferred deferred)
-        : BinaryDualOwnedAsyncWorker(targetOwner, sourceOwner, deferred, "BinaryMergeFromWorker"),
+        : BinaryDualOwnedAsyncWorker(targetOwner, sourceOwner, deferred, "BinaryMergeFromWorker", ExecutorLane::Background),
           target_(target),
           source_(source) {}
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (target_->IsDisposed()) {
                 SetError("Target index has been disposed");
@@ -1040,6 +1069,18 @@ Napi::Value FaissBinaryIndexWrapperJS::ReconstructBatch(const Napi::CallbackInfo
             }
         }
 
+        Napi::Uint8Array target;
+        if (!info[1].IsUndefined() && !info[1].IsNull()) {
+            if (!info[1].IsTypedArray() || info[1].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+                throw Napi::TypeError::New(env, "Expected Uint8Array for output");
+            }
+            target = info[1].As<Napi::Uint8Array>();
+            size_t required = idsArr.ElementLength() * static_cast<size_t>(wrapper_->GetCodeSize());
+            if (target.ElementLength() < required) {
+                throw Napi::RangeError::New(env, "output must hold at least " + std::to_string(required) + " bytes");
+            }
+        }
+
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
         BinaryReconstructBatchWorker* worker =
             new BinaryReconstructBatchWorker(
@@ -1047,6 +1088,7 @@ Napi::Value FaissBinaryIndexWrapperJS::ReconstructBatch(const Napi::CallbackInfo
                 wrapper_.get(),
                 idsArr.Data(),
                 idsArr.ElementLength(),
+                target,
                 deferred);
         worker->Queue();
 
@@ -1124,6 +1166,7 @@ Napi::Value FaissBinaryIndexWrapperJS::GetStats(const Napi::CallbackInfo& info)
         stats.Set("type", Napi::String::New(env, wrapper_->GetIndexType()));
         stats.Set("factory", Napi::String::New(env, wrapper_->GetFactoryDescription()));
         stats.Set("metric", Napi::String::New(env, wrapper_->GetMetricName()));
+        stats.Set("numThreads", Napi::Number::New(env, EffectiveOmpThreads()));
 
         return stats;
     } catch (const Napi::Error& e) {
@@ -2,30 +2,279 @@
 // Include FAISS headers for idx_t
 #include <faiss/MetricType.h>
 #include "faiss_index.h"
+#include "faiss_sharded_index.h"
 #include "napi_binary_bindings.h"
+#include "ingest_pipeline.h"
+#include "napi_external.h"
+#include "vector_file_reader.h"
+#include "vector_kernels.h"
+#include "napi_utility_bindings.h"
+#include "thread_control.h"
+#include "napi_executor.h"
 #include <vector>
 #include <memory>
 #include <cstring>
 #include <string>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
 
 // Forward declaration
 class FaissIndexWrapperJS;
 
+static_assert(sizeof(size_t) == sizeof(uint64_t), "range search lims are exposed as BigUint64Array");
+
+// Reads the optional { labelType: 'int32' | 'bigint' } search option.
+static bool ReadBigIntLabels(Napi::Env env, const Napi::Value& options, bool defaultValue) {
+    if (options.IsUndefined() || options.IsNull()) {
+        return defaultValue;
+    }
+
+    if (!options.IsObject()) {
+        throw Napi::TypeError::New(env, "Expected object for search options");
+    }
+
+    Napi::Object opts = options.As<Napi::Object>();
+    if (!opts.Has("labelType") || opts.Get("labelType").IsUndefined()) {
+        return defaultValue;
+    }
+
+    if (!opts.Get("labelType").IsString()) {
+        throw Napi::TypeError::New(env, "Expected string for labelType");
+    }
+
+    std::string labelType = opts.Get("labelType").As<Napi::String>().Utf8Value();
+    if (labelType == "bigint") {
+        return true;
+    }
+    if (labelType == "int32") {
+        return false;
+    }
+
+    throw Napi::TypeError::New(env, "Unsupported labelType: " + labelType + ". Supported: int32, bigint");
+}
+
+// Reads an optional boolean flag from a trailing options object.
+static bool ReadBoolOption(Napi::Env env, const Napi::Value& options, const char* key, bool defaultValue) {
+    if (options.IsUndefined() || options.IsNull()) {
+        return defaultValue;
+    }
+
+    if (!options.IsObject()) {
+        throw Napi::TypeError::New(env, "Expected object for options");
+    }
+
+    Napi::Value value = options.As<Napi::Object>().Get(key);
+    if (value.IsUndefined()) {
+        return defaultValue;
+    }
+
+    if (!value.IsBoolean()) {
+        throw Napi::TypeError::New(env, std::string("Expected boolean for ") + key);
+    }
+
+    return value.As<Napi::Boolean>().Value();
+}
+
+// Float input handed to a worker. By default the caller's data is copied so the typed
+// array can be reused as soon as the call returns. In borrow mode the worker reads the
+// caller's memory directly and pins the typed array with a persistent reference; the
+// reference is released when the worker is destroyed on the JS thread, after the
+// promise settles. The caller must not mutate or transfer the buffer until then.
+// With validate set, the NaN/Infinity check the JS layer would otherwise run on the
+// main thread is deferred to Validate(), which workers call from Execute.
+class FloatInput {
+public:
+    FloatInput(const Napi::Float32Array& array, bool borrow, bool validate = false)
+        : length_(array.ElementLength()), validate_(validate) {
+        if (borrow) {
+            borrowed_ = array.Data();
+            pin_ = Napi::Persistent(static_cast<const Napi::Object&>(array));
+        } else {
+            owned_.assign(array.Data(), array.Data() + length_);
+        }
+    }
+
+    const float* data() const {
+        return borrowed_ != nullptr ? borrowed_ : owned_.data();
+    }
+
+    void Validate(const char* name) const {
+        if (!validate_) {
+            return;
+        }
+        const size_t found = FindNonFinite(data(), length_);
+        if (found != length_) {
+            throw std::invalid_argument(
+                std::string(name) + " contains NaN or Infinity at element " + std::to_string(found));
+        }
+    }
+
+private:
+    std::vector<float> owned_;
+    const float* borrowed_ = nullptr;
+    size_t length_;
+    bool validate_;
+    Napi::ObjectReference pin_;
+};
+
+// Reads an id list passed as Int32Array or BigInt64Array.
+static std::vector<int64_t> ReadIdArray(Napi::Env env, const Napi::Value& value) {
+    if (!value.IsTypedArray()) {
+        throw Napi::TypeError::New(env, "Expected Int32Array or BigInt64Array for ids");
+    }
+
+    Napi::TypedArray arr = value.As<Napi::TypedArray>();
+    std::vector<int64_t> ids;
+    if (arr.TypedArrayType() == napi_int32_array) {
+        Napi::Int32Array idsArr = arr.As<Napi::Int32Array>();
+        ids.assign(idsArr.Data(), idsArr.Data() + idsArr.ElementLength());
+    } else if (arr.TypedArrayType() == napi_bigint64_array) {
+        Napi::BigInt64Array idsArr = arr.As<Napi::BigInt64Array>();
+        ids.assign(idsArr.Data(), idsArr.Data() + idsArr.ElementLength());
+    } else {
+        throw Napi::TypeError::New(env, "Expected Int32Array or BigInt64Array for ids");
+    }
+
+    if (ids.empty()) {
+        throw Napi::RangeError::New(env, "ids array cannot be empty");
+    }
+
+    for (int64_t id : ids) {
+        if (id < 0) {
+            throw Napi::RangeError::New(env, "ids must be non-negative");
+        }
+    }
+
+    return ids;
+}
+
+static int ReadPositiveIntOption(Napi::Env env, const Napi::Object& options, const char* key) {
+    Napi::Value value = options.Get(key);
+    if (value.IsUndefined()) {
+        return 0;
+    }
+
+    if (!value.IsNumber()) {
+        throw Napi::TypeError::New(env, std::string("Expected number for ") + key);
+    }
+
+    double number = value.As<Napi::Number>().DoubleValue();
+    // NaN passes both range checks, and casting it to int is undefined
+    if (!std::isfinite(number) || number < 1 || number > 2147483647 || number != static_cast<int>(number)) {
+        throw Napi::RangeError::New(env, std::string(key) + " must be a positive integer");
+    }
+    return static_cast<int>(number);
+}
+
+// Reads the optional per-call OpenMP thread count; 0 defers to the process-wide setting.
+static int ReadThreadsOption(Napi::Env env, const Napi::Value& options) {
+    if (options.IsUndefined() || options.IsNull()) {
+        return 0;
+    }
+
+    if (!options.IsObject()) {
+        throw Napi::TypeError::New(env, "Expected object for options");
+    }
+
+    int threads = ReadPositiveIntOption(env, options.As<Napi::Object>(), "threads");
+    if (threads > 1 && !OmpAvailable()) {
+        throw Napi::Error::New(env, "threads > 1 is not supported: this build has no OpenMP");
+    }
+    return threads;
+}
+
+// kFactor is fractional in FAISS (k * kFactor candidates are re-ranked); 0 means unset.
+static float ReadKFactorOption(Napi::Env env, const Napi::Object& options) {
+    Napi::Value value = options.Get("kFactor");
+    if (value.IsUndefined()) {
+        return 0;
+    }
+
+    if (!value.IsNumber()) {
+        throw Napi::TypeError::New(env, "Expected number for kFactor");
+    }
+
+    double number = value.As<Napi::Number>().DoubleValue();
+    if (!(number >= 1) || number > 65536) {
+        throw Napi::RangeError::New(env, "kFactor must be a number between 1 and 65536");
+    }
+    return static_cast<float>(number);
+}
+
+// Reads per-call search settings: nprobe, efSearch, maxCodes, and kFactor overrides, plus an
+// id filter - allowIds, denyIds (Int32Array or BigInt64Array), or bitmap (Uint8Array,
+// bit i selects label i). At most one filter may be set.
+static SearchOptions ReadSearchOptions(Napi::Env env, const Napi::Value& options) {
+    SearchOptions searchOptions;
+    if (options.IsUndefined() || options.IsNull()) {
+        return searchOptions;
+    }
+
+    if (!options.IsObject()) {
+        throw Napi::TypeError::New(env, "Expected object for options");
+    }
+
+    Napi::Object obj = options.As<Napi::Object>();
+    searchOptions.nprobe = ReadPositiveIntOption(env, obj, "nprobe");
+    searchOptions.ef_search = ReadPositiveIntOption(env, obj, "efSearch");
+    searchOptions.max_codes = static_cast<size_t>(ReadPositiveIntOption(env, obj, "maxCodes"));
+    searchOptions.k_factor = ReadKFactorOption(env, obj);
+
+    Napi::Value allowIds = obj.Get("allowIds");
+    Napi::Value denyIds = obj.Get("denyIds");
+    Napi::Value bitmap = obj.Get("bitmap");
+    int filters = !allowIds.IsUndefined() + !denyIds.IsUndefined() + !bitmap.IsUndefined();
+    if (filters > 1) {
+        throw Napi::TypeError::New(env, "Only one of allowIds, denyIds, or bitmap may be given");
+    }
+
+    if (!bitmap.IsUndefined()) {
+        if (!bitmap.IsTypedArray() || bitmap.As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+            throw Napi::TypeError::New(env, "Expected Uint8Array for bitmap");
+        }
+        Napi::Uint8Array bits = bitmap.As<Napi::Uint8Array>();
+        searchOptions.filter = SearchOptions::FilterMode::Bitmap;
+        searchOptions.bitmap.assign(bits.Data(), bits.Data() + bits.ElementLength());
+        return searchOptions;
+    }
+
+    Napi::Value ids = allowIds.IsUndefined() ? denyIds : allowIds;
+    if (ids.IsUndefined()) {
+        return searchOptions;
+    }
+
+    searchOptions.filter = allowIds.IsUndefined()
+        ? SearchOptions::FilterMode::Deny
+        : SearchOptions::FilterMode::Allow;
+    // An empty allow list is a valid filter (nothing visible), unlike an empty removeIds call
+    if (!ids.IsTypedArray() || ids.As<Napi::TypedArray>().ElementLength() > 0) {
+        searchOptions.filter_ids = ReadIdArray(env, ids);
+    }
+    return searchOptions;
+}
+
 // ============================================================================
 // Async Workers for Non-Blocking Operations
 // ============================================================================
 
-class GpuTransferWorker : public Napi::AsyncWorker {
+class GpuTransferWorker : public LaneWorker {
 public:
     GpuTransferWorker(
             const Napi::Object& owner,
-            FaissIndexWrapper* wrapper,
+            std::shared_ptr<FaissIndexWrapper> wrapper,
             bool toGpu,
             int device,
             Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), toGpu ? "ToGpuWorker" : "ToCpuWorker"),
+        : LaneWorker(deferred.Env(), toGpu ? "ToGpuWorker" : "ToCpuWorker", ExecutorLane::Background),
           owner_ref_(Napi::Persistent(owner)),
-          wrapper_(wrapper),
+          wrapper_(std::move(wrapper)),
           to_gpu_(toGpu),
           device_(device),
           deferred_(deferred) {}
@@ -59,29 +308,32 @@ public:
 
 private:
     Napi::ObjectReference owner_ref_;
-    FaissIndexWrapper* wrapper_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
     bool to_gpu_;
     int device_;
     Napi::Promise::Deferred deferred_;
 };
 
 // Add Worker
-class AddWorker : public Napi::AsyncWorker {
+class AddWorker : public LaneWorker {
 public:
-    AddWorker(FaissIndexWrapper* wrapper, const float* vectors, size_t n, int dims, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "AddWorker"),
-          wrapper_(wrapper),
-          vectors_(vectors, vectors + n * dims),
+    AddWorker(std::shared_ptr<FaissIndexWrapper> wrapper, FloatInput vectors, size_t n, int threads, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "AddWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
+          vectors_(std::move(vectors)),
           n_(n),
+          threads_(threads),
           deferred_(deferred) {
     }
 
     void Execute() override {
+        ScopedOmpThreads scope(threads_);
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
                 return;
             }
+            vectors_.Validate("Vectors");
             wrapper_->Add(vectors_.data(), n_);
         } catch (const std::exception& e) {
             SetError(std::string("FAISS error: ") + e.what());
@@ -97,29 +349,347 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
-    std::vector<float> vectors_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    FloatInput vectors_;
+    size_t n_;
+    int threads_;
+    Napi::Promise::Deferred deferred_;
+};
+
+// AddWithIds Worker (id-mapped indexes)
+class AddWithIdsWorker : public LaneWorker {
+public:
+    AddWithIdsWorker(std::shared_ptr<FaissIndexWrapper> wrapper, FloatInput vectors, const int64_t* ids, size_t n, int threads, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "AddWithIdsWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
+          vectors_(std::move(vectors)),
+          ids_(ids, ids + n),
+          n_(n),
+          threads_(threads),
+          deferred_(deferred) {
+    }
+
+    void Execute() override {
+        ScopedOmpThreads scope(threads_);
+        try {
+            if (wrapper_->IsDisposed()) {
+                SetError("Index has been disposed");
+                return;
+            }
+            vectors_.Validate("Vectors");
+            wrapper_->AddWithIds(vectors_.data(), ids_.data(), n_);
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    FloatInput vectors_;
+    std::vector<int64_t> ids_;
+    size_t n_;
+    int threads_;
+    Napi::Promise::Deferred deferred_;
+};
+
+struct AddProgress {
+    size_t batch;
+    size_t processed;
+    size_t total;
+    double elapsed_ms;
+};
+
+// Progress object passed to onProgress by the chunked add workers
+static Napi::Object CreateAddProgress(Napi::Env env, const AddProgress& update, size_t batchSize) {
+    size_t totalBatches = (update.total + batchSize - 1) / batchSize;
+    Napi::Object info = Napi::Object::New(env);
+    info.Set("operation", Napi::String::New(env, "add"));
+    info.Set("batch", Napi::Number::New(env, static_cast<double>(update.batch)));
+    info.Set("totalBatches", Napi::Number::New(env, static_cast<double>(totalBatches)));
+    info.Set("processed", Napi::Number::New(env, static_cast<double>(update.processed)));
+    info.Set("total", Napi::Number::New(env, static_cast<double>(update.total)));
+    info.Set("percentage", Napi::Number::New(env,
+        update.total == 0 ? 100.0 : 100.0 * static_cast<double>(update.processed) / static_cast<double>(update.total)));
+    info.Set("elapsedMs", Napi::Number::New(env, update.elapsed_ms));
+    // Extrapolated from the rate so far
+    double etaMs = update.processed == 0 || update.processed >= update.total
+        ? 0.0
+        : update.elapsed_ms * static_cast<double>(update.total - update.processed) / static_cast<double>(update.processed);
+    info.Set("etaMs", Napi::Number::New(env, etaMs));
+    return info;
+}
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// AddFromFile Worker: streams a vector file into the index one batch at a time, so the
+// dataset never passes through V8. Each batch takes the write lock separately, letting
+// searches run in between. Runs on the background lane; progress goes through the
+// worker's thread-safe function, and the next batch is read once onProgress has returned.
+class AddFromFileWorker : public LaneWorker {
+public:
+    AddFromFileWorker(std::shared_ptr<FaissIndexWrapper> wrapper, std::string path, VectorFileReader::Format format,
+                      size_t batchSize, Napi::Function onProgress, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "AddFromFileWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
+          path_(std::move(path)),
+          format_(format),
+          batch_size_(batchSize),
+          deferred_(deferred) {
+        if (!onProgress.IsEmpty()) {
+            on_progress_ = Napi::Persistent(onProgress);
+        }
+    }
+
+    void Execute() override {
+        ScopedOmpThreads scope;
+        try {
+            const auto start = std::chrono::steady_clock::now();
+            VectorFileReader reader(path_, format_, wrapper_->GetDimensions());
+            const size_t total = reader.Count();
+            std::vector<float> chunk(batch_size_ * static_cast<size_t>(wrapper_->GetDimensions()));
+
+            size_t batch = 0;
+            while (!stopped_.load()) {
+                if (wrapper_->IsDisposed()) {
+                    SetError("Index has been disposed");
+                    return;
+                }
+
+                size_t n = reader.Read(chunk.data(), batch_size_);
+                if (n == 0) {
+                    break;
+                }
+                wrapper_->Add(chunk.data(), n);
+                added_ += n;
+
+                if (!on_progress_.IsEmpty()) {
+                    AddProgress update{++batch, added_, total, ElapsedMs(start)};
+                    auto delivered = std::make_shared<std::promise<void>>();
+                    std::future<void> done = delivered->get_future();
+                    if (RunOnJsThread([this, update, delivered](Napi::Env env) {
+                            if (env != nullptr) {
+                                OnProgress(env, update);
+                            }
+                            delivered->set_value();
+                        })) {
+                        done.wait();
+                    }
+                }
+            }
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        if (!callback_error_.IsEmpty()) {
+            deferred_.Reject(callback_error_.Value());
+            return;
+        }
+        deferred_.Resolve(Napi::Number::New(Env(), static_cast<double>(added_)));
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(callback_error_.IsEmpty() ? e.Value() : callback_error_.Value());
+    }
+
+private:
+    void OnProgress(Napi::Env env, const AddProgress& update) {
+        if (!callback_error_.IsEmpty()) {
+            return;
+        }
+        try {
+            on_progress_.Call({CreateAddProgress(env, update, batch_size_)});
+        } catch (const Napi::Error& e) {
+            // A throwing callback stops the ingest after the batch in flight
+            callback_error_ = e;
+            stopped_.store(true);
+        }
+    }
+
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    std::string path_;
+    VectorFileReader::Format format_;
+    size_t batch_size_;
+    size_t added_ = 0;
+    std::atomic<bool> stopped_{false};
+    Napi::FunctionReference on_progress_;
+    Napi::Error callback_error_;
+    Napi::Promise::Deferred deferred_;
+};
+
+// AddWithProgress Worker: adds in-memory vectors one chunk at a time on the background
+// lane. FAISS already parallelizes within each chunk (HNSW inserts a batch level by
+// level with OpenMP, IVF assigns it in parallel), so chunking costs little throughput
+// while giving native progress, a cancellation point between chunks, and a write lock
+// that is released between chunks so searches keep running during a long build.
+// Progress goes through the worker's thread-safe function, ahead of the result, and
+// the next chunk starts once onProgress has returned.
+class AddWithProgressWorker : public LaneWorker {
+public:
+    AddWithProgressWorker(std::shared_ptr<FaissIndexWrapper> wrapper, FloatInput vectors, std::vector<int64_t> ids,
+                          size_t n, size_t batchSize, int threads, Napi::Function onProgress,
+                          Napi::Object signal, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "AddWithProgressWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
+          vectors_(std::move(vectors)),
+          ids_(std::move(ids)),
+          n_(n),
+          batch_size_(batchSize),
+          threads_(threads),
+          cancelled_(std::make_shared<std::atomic<bool>>(false)),
+          deferred_(deferred) {
+        if (!onProgress.IsEmpty()) {
+            on_progress_ = Napi::Persistent(onProgress);
+        }
+        if (!signal.IsEmpty()) {
+            // The listener only touches the shared flag, so a late abort after the
+            // worker is gone is harmless
+            std::shared_ptr<std::atomic<bool>> cancelled = cancelled_;
+            Napi::Function onAbort = Napi::Function::New(deferred.Env(), [cancelled](const Napi::CallbackInfo&) {
+                cancelled->store(true);
+            }, "onAbort");
+            signal.Get("addEventListener").As<Napi::Function>().Call(
+                signal, {Napi::String::New(deferred.Env(), "abort"), onAbort});
+            signal_ = Napi::Persistent(signal);
+            on_abort_ = Napi::Persistent(onAbort);
+        }
+    }
+
+    void Execute() override {
+        ScopedOmpThreads scope(threads_);
+        try {
+            vectors_.Validate("Vectors");
+            const auto start = std::chrono::steady_clock::now();
+            const size_t dims = static_cast<size_t>(wrapper_->GetDimensions());
+
+            size_t batch = 0;
+            while (added_ < n_) {
+                if (cancelled_->load()) {
+                    SetError("Add was aborted");
+                    return;
+                }
+                if (stopped_.load()) {
+                    return;
+                }
+                if (wrapper_->IsDisposed()) {
+                    SetError("Index has been disposed");
+                    return;
+                }
+
+                const size_t count = std::min(batch_size_, n_ - added_);
+                const float* chunk = vectors_.data() + added_ * dims;
+                if (ids_.empty()) {
+                    wrapper_->Add(chunk, count);
+                } else {
+                    wrapper_->AddWithIds(chunk, ids_.data() + added_, count);
+                }
+                added_ += count;
+
+                if (!on_progress_.IsEmpty()) {
+                    // Wait for the callback, so an abort or throw from onProgress stops
+                    // the add at this batch boundary
+                    AddProgress update{++batch, added_, n_, ElapsedMs(start)};
+                    auto delivered = std::make_shared<std::promise<void>>();
+                    std::future<void> done = delivered->get_future();
+                    if (RunOnJsThread([this, update, delivered](Napi::Env env) {
+                            if (env != nullptr) {
+                                OnProgress(env, update);
+                            }
+                            delivered->set_value();
+                        })) {
+                        done.wait();
+                    }
+                }
+            }
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        RemoveAbortListener();
+        if (!callback_error_.IsEmpty()) {
+            deferred_.Reject(callback_error_.Value());
+            return;
+        }
+        deferred_.Resolve(Napi::Number::New(Env(), static_cast<double>(added_)));
+    }
+
+    void OnError(const Napi::Error& e) override {
+        RemoveAbortListener();
+        deferred_.Reject(callback_error_.IsEmpty() ? e.Value() : callback_error_.Value());
+    }
+
+private:
+    void OnProgress(Napi::Env env, const AddProgress& update) {
+        if (!callback_error_.IsEmpty()) {
+            return;
+        }
+        try {
+            on_progress_.Call({CreateAddProgress(env, update, batch_size_)});
+        } catch (const Napi::Error& e) {
+            // A throwing callback stops the add after the chunk in flight
+            callback_error_ = e;
+            stopped_.store(true);
+        }
+    }
+
+    void RemoveAbortListener() {
+        if (signal_.IsEmpty()) {
+            return;
+        }
+        Napi::Object signal = signal_.Value();
+        signal.Get("removeEventListener").As<Napi::Function>().Call(
+            signal, {Napi::String::New(Env(), "abort"), on_abort_.Value()});
+    }
+
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    FloatInput vectors_;
+    std::vector<int64_t> ids_;
     size_t n_;
+    size_t batch_size_;
+    int threads_;
+    size_t added_ = 0;
+    std::atomic<bool> stopped_{false};
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+    Napi::FunctionReference on_progress_;
+    Napi::ObjectReference signal_;
+    Napi::FunctionReference on_abort_;
+    Napi::Error callback_error_;
     Napi::Promise::Deferred deferred_;
 };
 
 // Train Worker
-class TrainWorker : public Napi::AsyncWorker {
+class TrainWorker : public LaneWorker {
 public:
-    TrainWorker(FaissIndexWrapper* wrapper, const float* vectors, size_t n, int dims, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "TrainWorker"),
-          wrapper_(wrapper),
-          vectors_(vectors, vectors + n * dims),
+    TrainWorker(std::shared_ptr<FaissIndexWrapper> wrapper, FloatInput vectors, size_t n, int threads, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "TrainWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
+          vectors_(std::move(vectors)),
           n_(n),
+          threads_(threads),
           deferred_(deferred) {
     }
 
     void Execute() override {
+        ScopedOmpThreads scope(threads_);
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
                 return;
             }
+            vectors_.Validate("Training vectors");
             wrapper_->Train(vectors_.data(), n_);
         } catch (const std::exception& e) {
             SetError(std::string("FAISS error: ") + e.what());
@@ -135,24 +705,30 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
-    std::vector<float> vectors_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    FloatInput vectors_;
     size_t n_;
+    int threads_;
     Napi::Promise::Deferred deferred_;
 };
 
 // Search Worker
-class SearchWorker : public Napi::AsyncWorker {
+class SearchWorker : public LaneWorker {
 public:
-    SearchWorker(FaissIndexWrapper* wrapper, const float* query, int k, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "SearchWorker"),
-          wrapper_(wrapper),
-          query_(query, query + wrapper->GetDimensions()),
+    SearchWorker(std::shared_ptr<FaissIndexWrapper> wrapper, FloatInput query, int k, bool bigintLabels,
+                 SearchOptions options, int threads, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "SearchWorker", ExecutorLane::Interactive),
+          wrapper_(std::move(wrapper)),
+          query_(std::move(query)),
           k_(k),
+          bigint_labels_(bigintLabels),
+          options_(std::move(options)),
+          threads_(threads),
           deferred_(deferred) {
     }
 
     void Execute() override {
+        ScopedOmpThreads scope(threads_);
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
@@ -169,7 +745,8 @@ public:
             distances_.resize(actual_k);
             labels_.resize(actual_k);
             
-            wrapper_->Search(query_.data(), actual_k, distances_.data(), labels_.data());
+            query_.Validate("Query");
+            wrapper_->Search(query_.data(), actual_k, distances_.data(), labels_.data(), &options_);
         } catch (const std::exception& e) {
             SetError(std::string("FAISS error: ") + e.what());
         }
@@ -179,17 +756,8 @@ public:
         Napi::Env env = Env();
         Napi::Object result = Napi::Object::New(env);
         
-        Napi::Float32Array distances = Napi::Float32Array::New(env, distances_.size());
-        memcpy(distances.Data(), distances_.data(), distances_.size() * sizeof(float));
-        
-        Napi::Int32Array labels = Napi::Int32Array::New(env, labels_.size());
-        int32_t* labelsData = labels.Data();
-        for (size_t i = 0; i < labels_.size(); i++) {
-            labelsData[i] = static_cast<int32_t>(labels_[i]);
-        }
-        
-        result.Set("distances", distances);
-        result.Set("labels", labels);
+        result.Set("distances", ExternalFloat32Array(env, std::move(distances_)));
+        result.Set("labels", CreateLabelArray(env, std::move(labels_), bigint_labels_));
         deferred_.Resolve(result);
     }
 
@@ -198,26 +766,34 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
-    std::vector<float> query_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    FloatInput query_;
     int k_;
+    bool bigint_labels_;
+    SearchOptions options_;
     std::vector<float> distances_;
     std::vector<faiss::idx_t> labels_;
+    int threads_;
     Napi::Promise::Deferred deferred_;
 };
 
 // RangeSearch Worker
-class RangeSearchWorker : public Napi::AsyncWorker {
+class RangeSearchWorker : public LaneWorker {
 public:
-    RangeSearchWorker(FaissIndexWrapper* wrapper, const float* query, float radius, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "RangeSearchWorker"),
-          wrapper_(wrapper),
-          query_(query, query + wrapper->GetDimensions()),
+    RangeSearchWorker(std::shared_ptr<FaissIndexWrapper> wrapper, FloatInput query, float radius, bool bigintLabels,
+                      SearchOptions options, int threads, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "RangeSearchWorker", ExecutorLane::Interactive),
+          wrapper_(std::move(wrapper)),
+          query_(std::move(query)),
           radius_(radius),
+          bigint_labels_(bigintLabels),
+          options_(std::move(options)),
+          threads_(threads),
           deferred_(deferred) {
     }
 
     void Execute() override {
+        ScopedOmpThreads scope(threads_);
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
@@ -230,7 +806,8 @@ public:
                 return;
             }
             
-            wrapper_->RangeSearch(query_.data(), radius_, distances_, labels_, lims_);
+            query_.Validate("Query");
+            output_ = wrapper_->RangeSearch(query_.data(), 1, radius_, &options_);
         } catch (const std::exception& e) {
             SetError(std::string("FAISS error: ") + e.what());
         }
@@ -240,20 +817,14 @@ public:
         Napi::Env env = Env();
         Napi::Object result = Napi::Object::New(env);
         
-        Napi::Float32Array distances = Napi::Float32Array::New(env, distances_.size());
-        memcpy(distances.Data(), distances_.data(), distances_.size() * sizeof(float));
-        
-        Napi::Int32Array labels = Napi::Int32Array::New(env, labels_.size());
-        int32_t* labelsData = labels.Data();
-        for (size_t i = 0; i < labels_.size(); i++) {
-            labelsData[i] = static_cast<int32_t>(labels_[i]);
-        }
+        size_t total = output_.Total();
+        Napi::Float32Array distances = Napi::Float32Array::New(
+            env, total, ExternalArrayBuffer(env, std::move(output_.distances), total), 0);
+        Napi::TypedArray labels = CreateLabelArray(env, std::move(output_.labels), total, bigint_labels_);
         
-        Napi::Uint32Array lims = Napi::Uint32Array::New(env, lims_.size());
-        uint32_t* limsData = lims.Data();
-        for (size_t i = 0; i < lims_.size(); i++) {
-            limsData[i] = static_cast<uint32_t>(lims_[i]);
-        }
+        Napi::Uint32Array lims = Napi::Uint32Array::New(env, 2);
+        lims.Data()[0] = 0;
+        lims.Data()[1] = static_cast<uint32_t>(total);
         
         result.Set("distances", distances);
         result.Set("labels", labels);
@@ -268,45 +839,47 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
-    std::vector<float> query_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    FloatInput query_;
     float radius_;
-    std::vector<float> distances_;
-    std::vector<int64_t> labels_;
-    std::vector<size_t> lims_;
+    bool bigint_labels_;
+    SearchOptions options_;
+    RangeSearchOutput output_;
+    int threads_;
     Napi::Promise::Deferred deferred_;
 };
 
-// SearchBatch Worker
-class SearchBatchWorker : public Napi::AsyncWorker {
+// RangeSearchBatch Worker: all queries in one FAISS call, results handed over in lims layout
+class RangeSearchBatchWorker : public LaneWorker {
 public:
-    SearchBatchWorker(FaissIndexWrapper* wrapper, const float* queries, size_t nq, int k, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "SearchBatchWorker"),
-          wrapper_(wrapper),
-          queries_(queries, queries + nq * wrapper->GetDimensions()),
+    RangeSearchBatchWorker(std::shared_ptr<FaissIndexWrapper> wrapper, FloatInput queries, size_t nq, float radius,
+                           bool bigintLabels, SearchOptions options, int threads, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "RangeSearchBatchWorker", ExecutorLane::Interactive),
+          wrapper_(std::move(wrapper)),
+          queries_(std::move(queries)),
           nq_(nq),
-          k_(k),
+          radius_(radius),
+          bigint_labels_(bigintLabels),
+          options_(std::move(options)),
+          threads_(threads),
           deferred_(deferred) {
     }
 
     void Execute() override {
+        ScopedOmpThreads scope(threads_);
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
                 return;
             }
-            
-            size_t ntotal = wrapper_->GetTotalVectors();
-            if (ntotal == 0) {
+
+            if (wrapper_->GetTotalVectors() == 0) {
                 SetError("Cannot search empty index");
                 return;
             }
-            
-            int actual_k = (k_ > static_cast<int>(ntotal)) ? static_cast<int>(ntotal) : k_;
-            distances_.resize(nq_ * actual_k);
-            labels_.resize(nq_ * actual_k);
-            
-            wrapper_->SearchBatch(queries_.data(), nq_, actual_k, distances_.data(), labels_.data());
+
+            queries_.Validate("Queries");
+            output_ = wrapper_->RangeSearch(queries_.data(), nq_, radius_, &options_);
         } catch (const std::exception& e) {
             SetError(std::string("FAISS error: ") + e.what());
         }
@@ -315,20 +888,15 @@ public:
     void OnOK() override {
         Napi::Env env = Env();
         Napi::Object result = Napi::Object::New(env);
-        
-        Napi::Float32Array distances = Napi::Float32Array::New(env, distances_.size());
-        memcpy(distances.Data(), distances_.data(), distances_.size() * sizeof(float));
-        
-        Napi::Int32Array labels = Napi::Int32Array::New(env, labels_.size());
-        int32_t* labelsData = labels.Data();
-        for (size_t i = 0; i < labels_.size(); i++) {
-            labelsData[i] = static_cast<int32_t>(labels_[i]);
-        }
-        
-        result.Set("distances", distances);
-        result.Set("labels", labels);
+
+        size_t total = output_.Total();
+        result.Set("distances", Napi::Float32Array::New(
+            env, total, ExternalArrayBuffer(env, std::move(output_.distances), total), 0));
+        result.Set("labels", CreateLabelArray(env, std::move(output_.labels), total, bigint_labels_));
+        result.Set("lims", Napi::BigUint64Array::New(
+            env, nq_ + 1, ExternalArrayBuffer(env, std::move(output_.lims), nq_ + 1), 0));
         result.Set("nq", Napi::Number::New(env, nq_));
-        result.Set("k", Napi::Number::New(env, static_cast<int>(distances_.size() / nq_)));
+
         deferred_.Resolve(result);
     }
 
@@ -337,34 +905,53 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
-    std::vector<float> queries_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    FloatInput queries_;
     size_t nq_;
-    int k_;
-    std::vector<float> distances_;
-    std::vector<faiss::idx_t> labels_;
+    float radius_;
+    bool bigint_labels_;
+    SearchOptions options_;
+    RangeSearchOutput output_;
+    int threads_;
     Napi::Promise::Deferred deferred_;
 };
 
-// Reconstruct Worker
-class ReconstructWorker : public Napi::AsyncWorker {
+// SearchBatch Worker
+class SearchBatchWorker : public LaneWorker {
 public:
-    ReconstructWorker(FaissIndexWrapper* wrapper, int64_t id, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "ReconstructWorker"),
-          wrapper_(wrapper),
-          id_(id),
+    SearchBatchWorker(std::shared_ptr<FaissIndexWrapper> wrapper, FloatInput queries, size_t nq, int k, bool bigintLabels,
+                      SearchOptions options, int threads, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "SearchBatchWorker", ExecutorLane::Interactive),
+          wrapper_(std::move(wrapper)),
+          queries_(std::move(queries)),
+          nq_(nq),
+          k_(k),
+          bigint_labels_(bigintLabels),
+          options_(std::move(options)),
+          threads_(threads),
           deferred_(deferred) {
     }
 
     void Execute() override {
+        ScopedOmpThreads scope(threads_);
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
                 return;
             }
-
-            output_.resize(wrapper_->GetDimensions());
-            wrapper_->Reconstruct(id_, output_.data());
+            
+            size_t ntotal = wrapper_->GetTotalVectors();
+            if (ntotal == 0) {
+                SetError("Cannot search empty index");
+                return;
+            }
+            
+            int actual_k = (k_ > static_cast<int>(ntotal)) ? static_cast<int>(ntotal) : k_;
+            distances_.resize(nq_ * actual_k);
+            labels_.resize(nq_ * actual_k);
+            
+            queries_.Validate("Queries");
+            wrapper_->SearchBatch(queries_.data(), nq_, actual_k, distances_.data(), labels_.data(), &options_);
         } catch (const std::exception& e) {
             SetError(std::string("FAISS error: ") + e.what());
         }
@@ -372,8 +959,13 @@ public:
 
     void OnOK() override {
         Napi::Env env = Env();
-        Napi::Float32Array result = Napi::Float32Array::New(env, output_.size());
-        memcpy(result.Data(), output_.data(), output_.size() * sizeof(float));
+        Napi::Object result = Napi::Object::New(env);
+        
+        int k = static_cast<int>(distances_.size() / nq_);
+        result.Set("distances", ExternalFloat32Array(env, std::move(distances_)));
+        result.Set("labels", CreateLabelArray(env, std::move(labels_), bigint_labels_));
+        result.Set("nq", Napi::Number::New(env, nq_));
+        result.Set("k", Napi::Number::New(env, k));
         deferred_.Resolve(result);
     }
 
@@ -382,32 +974,314 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
-    int64_t id_;
-    std::vector<float> output_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    FloatInput queries_;
+    size_t nq_;
+    int k_;
+    bool bigint_labels_;
+    SearchOptions options_;
+    std::vector<float> distances_;
+    std::vector<faiss::idx_t> labels_;
+    int threads_;
+    Napi::Promise::Deferred deferred_;
+};
+
+// Calls submitted against one index object that have not completed yet. Calls are
+// counted and released on the JS thread (workers are deleted there), so
+// disposeAsync() can wait for them without tying up an executor thread.
+struct InFlightCalls {
+    std::mutex mutex;
+    size_t count = 0;
+    std::function<void()> on_idle;
+
+    // Runs fn on the JS thread once no call is in flight: now if already idle,
+    // otherwise when the last one is released.
+    void WhenIdle(std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (count > 0) {
+                on_idle = std::move(fn);
+                return;
+            }
+        }
+        fn();
+    }
+};
+
+// Runs fn once every counter in calls is idle, checking them one after another. Callers
+// make sure no new calls can be counted on them meanwhile.
+static void WhenAllIdle(std::vector<std::shared_ptr<InFlightCalls>> calls, std::function<void()> fn) {
+    if (calls.empty()) {
+        fn();
+        return;
+    }
+    std::shared_ptr<InFlightCalls> last = std::move(calls.back());
+    calls.pop_back();
+    last->WhenIdle([calls, fn]() {
+        WhenAllIdle(calls, fn);
+    });
+}
+
+// Counts as one call in flight for as long as it lives
+class InFlightCall {
+public:
+    explicit InFlightCall(std::shared_ptr<InFlightCalls> calls) : calls_(std::move(calls)) {
+        std::lock_guard<std::mutex> lock(calls_->mutex);
+        calls_->count++;
+    }
+
+    ~InFlightCall() {
+        std::function<void()> onIdle;
+        {
+            std::lock_guard<std::mutex> lock(calls_->mutex);
+            if (--calls_->count == 0) {
+                onIdle = std::move(calls_->on_idle);
+                calls_->on_idle = nullptr;
+            }
+        }
+        if (onIdle) {
+            onIdle();
+        }
+    }
+
+    InFlightCall(const InFlightCall&) = delete;
+    InFlightCall& operator=(const InFlightCall&) = delete;
+
+private:
+    std::shared_ptr<InFlightCalls> calls_;
+};
+
+// Search coalescing: single-query search() calls that arrive within a short
+// window are merged into one SearchBatch so FAISS can use its nq>1 BLAS paths.
+// Pending requests are only created and settled on the JS thread; the worker
+// thread just moves them between the queue and its own batch.
+struct CoalescedSearchRequest {
+    std::vector<float> query;
+    int k;
+    bool bigint_labels;
+    Napi::Promise::Deferred deferred;
+    std::chrono::steady_clock::time_point enqueued;
+};
+
+struct SearchCoalescer {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<CoalescedSearchRequest> pending;
+    std::shared_ptr<FaissIndexWrapper> wrapper;  // index the next batch searches
+    // A CoalescedSearchWorker is queued, collecting or running a batch. Set by Submit,
+    // cleared only by the worker once it finds nothing pending, so there is at most one.
+    bool collecting = false;
+    size_t max_batch_size = 64;
+    std::chrono::microseconds window{1000};
+};
+
+class CoalescedSearchWorker : public LaneWorker {
+public:
+    CoalescedSearchWorker(Napi::Env env, std::shared_ptr<SearchCoalescer> coalescer)
+        : LaneWorker(env, "CoalescedSearchWorker", ExecutorLane::Interactive),
+          coalescer_(std::move(coalescer)) {
+    }
+
+    // Called on the JS thread with a new request. Queues a worker when none is collecting.
+    static void Submit(
+            Napi::Env env,
+            const std::shared_ptr<SearchCoalescer>& coalescer,
+            CoalescedSearchRequest request) {
+        bool startWorker = false;
+        {
+            std::lock_guard<std::mutex> lock(coalescer->mutex);
+            coalescer->pending.push_back(std::move(request));
+            if (!coalescer->collecting) {
+                coalescer->collecting = true;
+                startWorker = true;
+            }
+        }
+
+        if (startWorker) {
+            (new CoalescedSearchWorker(env, coalescer))->Queue();
+        } else {
+            coalescer->ready.notify_one();
+        }
+    }
+
+    void Execute() override {
+        ScopedOmpThreads scope;
+        {
+            std::unique_lock<std::mutex> lock(coalescer_->mutex);
+            if (coalescer_->pending.empty()) {
+                return;
+            }
+            // The latency ceiling is measured from the oldest waiting request
+            auto deadline = coalescer_->pending.front().enqueued + coalescer_->window;
+            coalescer_->ready.wait_until(lock, deadline, [this]() {
+                return coalescer_->pending.size() >= coalescer_->max_batch_size;
+            });
+
+            size_t take = std::min(coalescer_->pending.size(), coalescer_->max_batch_size);
+            for (size_t i = 0; i < take; i++) {
+                batch_.push_back(std::move(coalescer_->pending.front()));
+                coalescer_->pending.pop_front();
+            }
+            // Overflow beyond max_batch_size, and requests that arrive while this batch
+            // runs, are picked up by a follow-up worker from OnOK/OnError
+            wrapper_ = coalescer_->wrapper;
+        }
+        if (batch_.empty()) {
+            return;
+        }
+
+        try {
+            if (!wrapper_ || wrapper_->IsDisposed()) {
+                SetError("Index has been disposed");
+                return;
+            }
+
+            size_t ntotal = wrapper_->GetTotalVectors();
+            if (ntotal == 0) {
+                SetError("Cannot search empty index");
+                return;
+            }
+
+            int maxK = 0;
+            for (const auto& request : batch_) {
+                maxK = std::max(maxK, request.k);
+            }
+            batch_k_ = (maxK > static_cast<int>(ntotal)) ? static_cast<int>(ntotal) : maxK;
+
+            size_t dims = static_cast<size_t>(wrapper_->GetDimensions());
+            std::vector<float> queries(batch_.size() * dims);
+            for (size_t i = 0; i < batch_.size(); i++) {
+                memcpy(queries.data() + i * dims, batch_[i].query.data(), dims * sizeof(float));
+            }
+
+            distances_.resize(batch_.size() * batch_k_);
+            labels_.resize(batch_.size() * batch_k_);
+            wrapper_->SearchBatch(queries.data(), batch_.size(), batch_k_, distances_.data(), labels_.data());
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+
+        for (size_t i = 0; i < batch_.size(); i++) {
+            // Results are sorted per query, so a smaller k is a prefix of the batch row
+            int k = std::min(batch_[i].k, batch_k_);
+            const float* rowDistances = distances_.data() + i * batch_k_;
+            const faiss::idx_t* rowLabels = labels_.data() + i * batch_k_;
+
+            Napi::Object result = Napi::Object::New(env);
+            Napi::Float32Array distances = Napi::Float32Array::New(env, k);
+            memcpy(distances.Data(), rowDistances, k * sizeof(float));
+
+            result.Set("distances", distances);
+            result.Set("labels", CreateLabelArray(env, rowLabels, k, batch_[i].bigint_labels));
+            batch_[i].deferred.Resolve(result);
+        }
+
+        ContinueIfPending();
+    }
+
+    void OnError(const Napi::Error& e) override {
+        for (auto& request : batch_) {
+            request.deferred.Reject(e.Value());
+        }
+
+        ContinueIfPending();
+    }
+
+private:
+    void ContinueIfPending() {
+        bool more = false;
+        {
+            std::lock_guard<std::mutex> lock(coalescer_->mutex);
+            more = !coalescer_->pending.empty();
+            coalescer_->collecting = more;
+        }
+        if (more) {
+            (new CoalescedSearchWorker(Env(), coalescer_))->Queue();
+        }
+    }
+
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    std::shared_ptr<SearchCoalescer> coalescer_;
+    std::vector<CoalescedSearchRequest> batch_;
+    int batch_k_ = 0;
+    std::vector<float> distances_;
+    std::vector<faiss::idx_t> labels_;
+};
+
+// Reconstruct Worker
+class ReconstructWorker : public LaneWorker {
+public:
+    ReconstructWorker(std::shared_ptr<FaissIndexWrapper> wrapper, int64_t id, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "ReconstructWorker", ExecutorLane::Interactive),
+          wrapper_(std::move(wrapper)),
+          id_(id),
+          deferred_(deferred) {
+    }
+
+    void Execute() override {
+        try {
+            if (wrapper_->IsDisposed()) {
+                SetError("Index has been disposed");
+                return;
+            }
+
+            output_.resize(wrapper_->GetDimensions());
+            wrapper_->Reconstruct(id_, output_.data());
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        deferred_.Resolve(ExternalFloat32Array(env, std::move(output_)));
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    int64_t id_;
+    std::vector<float> output_;
     Napi::Promise::Deferred deferred_;
 };
 
 // ReconstructBatch Worker
-class ReconstructBatchWorker : public Napi::AsyncWorker {
+class ReconstructBatchWorker : public LaneWorker {
 public:
-    ReconstructBatchWorker(FaissIndexWrapper* wrapper, const int32_t* ids, size_t n, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "ReconstructBatchWorker"),
-          wrapper_(wrapper),
-          ids_(ids, ids + n),
+    // target: optional caller-supplied Float32Array, written in place and pinned until settled
+    ReconstructBatchWorker(std::shared_ptr<FaissIndexWrapper> wrapper, std::vector<int64_t> ids, Napi::Float32Array target,
+                           Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "ReconstructBatchWorker", ExecutorLane::Interactive),
+          wrapper_(std::move(wrapper)),
+          ids_(std::move(ids)),
           deferred_(deferred) {
+        if (!target.IsEmpty()) {
+            target_ = target.Data();
+            target_ref_ = Napi::Persistent(static_cast<const Napi::Object&>(target));
+        }
     }
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
                 return;
             }
 
-            output_.resize(ids_.size() * static_cast<size_t>(wrapper_->GetDimensions()));
-            std::vector<int64_t> ids64(ids_.begin(), ids_.end());
-            wrapper_->ReconstructBatch(ids64.data(), ids64.size(), output_.data());
+            float* output = target_;
+            if (output == nullptr) {
+                output_.resize(ids_.size() * static_cast<size_t>(wrapper_->GetDimensions()));
+                output = output_.data();
+            }
+            wrapper_->ReconstructBatch(ids_.data(), ids_.size(), output);
         } catch (const std::exception& e) {
             SetError(std::string("FAISS error: ") + e.what());
         }
@@ -415,9 +1289,11 @@ public:
 
     void OnOK() override {
         Napi::Env env = Env();
-        Napi::Float32Array result = Napi::Float32Array::New(env, output_.size());
-        memcpy(result.Data(), output_.data(), output_.size() * sizeof(float));
-        deferred_.Resolve(result);
+        if (target_ != nullptr) {
+            deferred_.Resolve(target_ref_.Value());
+            return;
+        }
+        deferred_.Resolve(ExternalFloat32Array(env, std::move(output_)));
     }
 
     void OnError(const Napi::Error& e) override {
@@ -425,32 +1301,34 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
-    std::vector<int32_t> ids_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    std::vector<int64_t> ids_;
     std::vector<float> output_;
+    float* target_ = nullptr;
+    Napi::ObjectReference target_ref_;
     Napi::Promise::Deferred deferred_;
 };
 
 // RemoveIds Worker
-class RemoveIdsWorker : public Napi::AsyncWorker {
+class RemoveIdsWorker : public LaneWorker {
 public:
-    RemoveIdsWorker(FaissIndexWrapper* wrapper, const int32_t* ids, size_t n, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "RemoveIdsWorker"),
-          wrapper_(wrapper),
-          ids_(ids, ids + n),
+    RemoveIdsWorker(std::shared_ptr<FaissIndexWrapper> wrapper, std::vector<int64_t> ids, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "RemoveIdsWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
+          ids_(std::move(ids)),
           removed_(0),
           deferred_(deferred) {
     }
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (wrapper_->IsDisposed()) {
                 SetError("Index has been disposed");
                 return;
             }
 
-            std::vector<int64_t> ids64(ids_.begin(), ids_.end());
-            removed_ = wrapper_->RemoveIds(ids64.data(), ids64.size());
+            removed_ = wrapper_->RemoveIds(ids_.data(), ids_.size());
         } catch (const std::exception& e) {
             SetError(std::string("FAISS error: ") + e.what());
         }
@@ -465,18 +1343,18 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
-    std::vector<int32_t> ids_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    std::vector<int64_t> ids_;
     size_t removed_;
     Napi::Promise::Deferred deferred_;
 };
 
 // Save Worker
-class SaveWorker : public Napi::AsyncWorker {
+class SaveWorker : public LaneWorker {
 public:
-    SaveWorker(FaissIndexWrapper* wrapper, const std::string& filename, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "SaveWorker"),
-          wrapper_(wrapper),
+    SaveWorker(std::shared_ptr<FaissIndexWrapper> wrapper, const std::string& filename, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "SaveWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
           filename_(filename),
           deferred_(deferred) {
     }
@@ -502,17 +1380,17 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
     std::string filename_;
     Napi::Promise::Deferred deferred_;
 };
 
 // ToBuffer Worker
-class ToBufferWorker : public Napi::AsyncWorker {
+class ToBufferWorker : public LaneWorker {
 public:
-    ToBufferWorker(FaissIndexWrapper* wrapper, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "ToBufferWorker"),
-          wrapper_(wrapper),
+    ToBufferWorker(std::shared_ptr<FaissIndexWrapper> wrapper, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "ToBufferWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
           deferred_(deferred) {
     }
 
@@ -530,8 +1408,7 @@ public:
 
     void OnOK() override {
         Napi::Env env = Env();
-        Napi::Buffer<uint8_t> nodeBuffer = Napi::Buffer<uint8_t>::Copy(env, buffer_.data(), buffer_.size());
-        deferred_.Resolve(nodeBuffer);
+        deferred_.Resolve(ExternalBuffer(env, std::move(buffer_)));
     }
 
     void OnError(const Napi::Error& e) override {
@@ -539,22 +1416,90 @@ public:
     }
 
 private:
-    FaissIndexWrapper* wrapper_;
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
     std::vector<uint8_t> buffer_;
     Napi::Promise::Deferred deferred_;
 };
 
+// Reset Worker: clears the index off the JS thread, where freeing a large index's
+// storage would otherwise stall the event loop
+class ResetWorker : public LaneWorker {
+public:
+    ResetWorker(std::shared_ptr<FaissIndexWrapper> wrapper, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "ResetWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
+          deferred_(deferred) {
+    }
+
+    void Execute() override {
+        try {
+            if (wrapper_->IsDisposed()) {
+                SetError("Index has been disposed");
+                return;
+            }
+            wrapper_->Reset();
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    Napi::Promise::Deferred deferred_;
+};
+
+// Dispose Worker: frees an index on the background lane. Queued by disposeAsync()
+// once the calls submitted before it have completed.
+class DisposeWorker : public LaneWorker {
+public:
+    DisposeWorker(std::shared_ptr<FaissIndexWrapper> wrapper, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "DisposeWorker", ExecutorLane::Background),
+          wrapper_(std::move(wrapper)),
+          deferred_(deferred) {
+    }
+
+    void Execute() override {
+        try {
+            wrapper_->Dispose();
+            wrapper_.reset();
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    Napi::Promise::Deferred deferred_;
+};
+
 // MergeFrom Worker
-class MergeFromWorker : public Napi::AsyncWorker {
+class MergeFromWorker : public LaneWorker {
 public:
-    MergeFromWorker(FaissIndexWrapper* target, FaissIndexWrapper* source, Napi::Promise::Deferred deferred)
-        : Napi::AsyncWorker(deferred.Env(), "MergeFromWorker"),
-          target_(target),
-          source_(source),
+    MergeFromWorker(std::shared_ptr<FaissIndexWrapper> target, std::shared_ptr<FaissIndexWrapper> source, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "MergeFromWorker", ExecutorLane::Background),
+          target_(std::move(target)),
+          source_(std::move(source)),
           deferred_(deferred) {
     }
 
     void Execute() override {
+        ScopedOmpThreads scope;
         try {
             if (target_->IsDisposed()) {
                 SetError("Target index has been disposed");
@@ -579,264 +1524,496 @@ public:
     }
 
 private:
-    FaissIndexWrapper* target_;
-    FaissIndexWrapper* source_;
+    std::shared_ptr<FaissIndexWrapper> target_;
+    std::shared_ptr<FaissIndexWrapper> source_;
     Napi::Promise::Deferred deferred_;
 };
 
-// Wrapper class that bridges N-API and our C++ wrapper
-class FaissIndexWrapperJS : public Napi::ObjectWrap<FaissIndexWrapperJS> {
+// Settles an ingest promise from whichever thread the pipeline calls back on. The
+// pipeline never blocks, so push and finish need no worker of their own; the
+// thread-safe function keeps the event loop alive until the promise is settled.
+class IngestCall {
 public:
-    static Napi::Object Init(Napi::Env env, Napi::Object exports);
-    FaissIndexWrapperJS(const Napi::CallbackInfo& info);
-    ~FaissIndexWrapperJS();
+    static IngestCall* New(Napi::Env env, Napi::Promise::Deferred deferred) {
+        IngestCall* call = new IngestCall(deferred);
+        call->tsfn_ = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, Noop), "IngestCall", 0, 1);
+        return call;
+    }
+
+    // Resolves with undefined, or rejects with error. May run on any thread, once.
+    void Settle(std::exception_ptr error) {
+        Deliver(error, false, 0);
+    }
+
+    // Resolves with the number of vectors added, or rejects with error.
+    void Settle(std::exception_ptr error, size_t added) {
+        Deliver(error, true, added);
+    }
 
 private:
-    static Napi::FunctionReference constructor;
-    std::unique_ptr<FaissIndexWrapper> wrapper_;
-    int dims_;
-    
-    // Methods
-    Napi::Value Add(const Napi::CallbackInfo& info);
-    Napi::Value Train(const Napi::CallbackInfo& info);
-    Napi::Value Search(const Napi::CallbackInfo& info);
-    Napi::Value SearchBatch(const Napi::CallbackInfo& info);
-    Napi::Value RangeSearch(const Napi::CallbackInfo& info);
-    Napi::Value Reconstruct(const Napi::CallbackInfo& info);
-    Napi::Value ReconstructBatch(const Napi::CallbackInfo& info);
-    Napi::Value RemoveIds(const Napi::CallbackInfo& info);
-    Napi::Value GetStats(const Napi::CallbackInfo& info);
-    Napi::Value Dispose(const Napi::CallbackInfo& info);
-    Napi::Value Save(const Napi::CallbackInfo& info);
-    Napi::Value ToBuffer(const Napi::CallbackInfo& info);
-    Napi::Value MergeFrom(const Napi::CallbackInfo& info);
-    Napi::Value SetNprobe(const Napi::CallbackInfo& info);
-    Napi::Value ToGpu(const Napi::CallbackInfo& info);
-    Napi::Value ToCpu(const Napi::CallbackInfo& info);
-    Napi::Value Reset(const Napi::CallbackInfo& info);
-    
-    // Static methods
-    static Napi::Value Load(const Napi::CallbackInfo& info);
-    static Napi::Value FromBuffer(const Napi::CallbackInfo& info);
-    static Napi::Value GpuSupport(const Napi::CallbackInfo& info);
-    
-    // Helper methods
-    void ValidateNotDisposed(Napi::Env env) const;
-    Napi::Float32Array CreateFloat32Array(Napi::Env env, size_t length, const float* data);
-    Napi::Int32Array CreateInt32Array(Napi::Env env, size_t length, const faiss::idx_t* data);
+    explicit IngestCall(Napi::Promise::Deferred deferred) : deferred_(deferred) {}
+
+    void Deliver(std::exception_ptr error, bool hasCount, size_t added) {
+        if (error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (const std::exception& e) {
+                error_ = std::string("FAISS error: ") + e.what();
+            } catch (...) {
+                error_ = "Unknown error in ingest pipeline";
+            }
+            failed_ = true;
+        }
+        has_count_ = hasCount;
+        added_ = added;
+
+        Napi::ThreadSafeFunction tsfn = tsfn_;
+        // Refused only while the environment shuts down; the call is then leaked, as
+        // its deferred may only be released on the JS thread
+        tsfn.BlockingCall(this, Complete);
+        tsfn.Release();
+    }
+
+    static void Noop(const Napi::CallbackInfo&) {}
+
+    static void Complete(Napi::Env env, Napi::Function, IngestCall* call) {
+        if (env == nullptr) {
+            return;
+        }
+        std::unique_ptr<IngestCall> owned(call);
+        if (owned->failed_) {
+            owned->deferred_.Reject(Napi::Error::New(env, owned->error_).Value());
+        } else if (owned->has_count_) {
+            owned->deferred_.Resolve(Napi::Number::New(env, static_cast<double>(owned->added_)));
+        } else {
+            owned->deferred_.Resolve(env.Undefined());
+        }
+    }
+
+    Napi::Promise::Deferred deferred_;
+    Napi::ThreadSafeFunction tsfn_;
+    std::string error_;
+    bool failed_ = false;
+    bool has_count_ = false;
+    size_t added_ = 0;
 };
 
-// Static constructor reference
-Napi::FunctionReference FaissIndexWrapperJS::constructor;
+// JS handle for an IngestPipeline. It holds a strong reference to the owning index
+// object for as long as the stream is in use.
+class IngestPipelineJS : public Napi::ObjectWrap<IngestPipelineJS> {
+public:
+    static void Init(Napi::Env env) {
+        Napi::Function func = DefineClass(env, "FaissIngestPipeline", {
+            InstanceMethod("push", &IngestPipelineJS::Push),
+            InstanceMethod("finish", &IngestPipelineJS::Finish),
+            InstanceMethod("abort", &IngestPipelineJS::Abort),
+            InstanceMethod("getAdded", &IngestPipelineJS::GetAdded),
+        });
+        constructor = Napi::Persistent(func);
+        constructor.SuppressDestruct();
+    }
 
-Napi::Object FaissIndexWrapperJS::Init(Napi::Env env, Napi::Object exports) {
-    Napi::Function func = DefineClass(env, "FaissIndexWrapper", {
-        InstanceMethod("add", &FaissIndexWrapperJS::Add),
-        InstanceMethod("train", &FaissIndexWrapperJS::Train),
-        InstanceMethod("search", &FaissIndexWrapperJS::Search),
-        InstanceMethod("searchBatch", &FaissIndexWrapperJS::SearchBatch),
-        InstanceMethod("rangeSearch", &FaissIndexWrapperJS::RangeSearch),
-        InstanceMethod("reconstruct", &FaissIndexWrapperJS::Reconstruct),
-        InstanceMethod("reconstructBatch", &FaissIndexWrapperJS::ReconstructBatch),
-        InstanceMethod("removeIds", &FaissIndexWrapperJS::RemoveIds),
-        InstanceMethod("getStats", &FaissIndexWrapperJS::GetStats),
-        InstanceMethod("dispose", &FaissIndexWrapperJS::Dispose),
-        InstanceMethod("save", &FaissIndexWrapperJS::Save),
-        InstanceMethod("toBuffer", &FaissIndexWrapperJS::ToBuffer),
-        InstanceMethod("mergeFrom", &FaissIndexWrapperJS::MergeFrom),
-        InstanceMethod("setNprobe", &FaissIndexWrapperJS::SetNprobe),
-        InstanceMethod("toGpu", &FaissIndexWrapperJS::ToGpu),
-        InstanceMethod("toCpu", &FaissIndexWrapperJS::ToCpu),
-        InstanceMethod("reset", &FaissIndexWrapperJS::Reset),
-        StaticMethod("load", &FaissIndexWrapperJS::Load),
-        StaticMethod("fromBuffer", &FaissIndexWrapperJS::FromBuffer),
-        StaticMethod("gpuSupport", &FaissIndexWrapperJS::GpuSupport),
-    });
-    
-    constructor = Napi::Persistent(func);
-    constructor.SuppressDestruct();
-    
-    exports.Set("FaissIndexWrapper", func);
-    return exports;
-}
+    static Napi::Object NewInstance(Napi::Object owner, std::shared_ptr<FaissIndexWrapper> index,
+                                    const IngestOptions& options) {
+        Napi::Object obj = constructor.New({});
+        IngestPipelineJS* instance = Napi::ObjectWrap<IngestPipelineJS>::Unwrap(obj);
+        instance->owner_ = Napi::Persistent(owner);
+        instance->dims_ = static_cast<size_t>(index->GetDimensions());
+        instance->pipeline_ = std::make_shared<IngestPipeline>(std::move(index), options);
+        return obj;
+    }
 
-FaissIndexWrapperJS::FaissIndexWrapperJS(const Napi::CallbackInfo& info)
-    : Napi::ObjectWrap<FaissIndexWrapperJS>(info), dims_(0) {
-    Napi::Env env = info.Env();
-    
-    try {
-        // Validate constructor arguments
-        if (info.Length() < 1) {
-            throw Napi::TypeError::New(env, "Expected 1 argument: { dims: number }");
-        }
-        
-        if (!info[0].IsObject()) {
-            throw Napi::TypeError::New(env, "Expected object with 'dims' property");
+    IngestPipelineJS(const Napi::CallbackInfo& info) : Napi::ObjectWrap<IngestPipelineJS>(info) {}
+
+    ~IngestPipelineJS() {
+        // Drop queued batches; a stage that is mid-batch keeps the pipeline and index alive
+        if (pipeline_) {
+            pipeline_->Abort();
         }
-        
-        Napi::Object config = info[0].As<Napi::Object>();
-        
-        if (!config.Has("dims") || !config.Get("dims").IsNumber()) {
-            throw Napi::TypeError::New(env, "Config must have 'dims' as a number");
+    }
+
+private:
+    static Napi::FunctionReference constructor;
+    std::shared_ptr<IngestPipeline> pipeline_;
+    Napi::ObjectReference owner_;
+    size_t dims_ = 0;
+
+    Napi::Value Push(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!info[0].IsTypedArray() || info[0].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+            throw Napi::TypeError::New(env, "Expected Float32Array");
         }
-        
-        dims_ = config.Get("dims").As<Napi::Number>().Int32Value();
-        
-        if (dims_ <= 0) {
-            throw Napi::RangeError::New(env, "Dimensions must be positive");
+
+        Napi::Float32Array arr = info[0].As<Napi::Float32Array>();
+        if (arr.ElementLength() == 0 || arr.ElementLength() % dims_ != 0) {
+            throw Napi::RangeError::New(env,
+                "Vector length must be a non-zero multiple of dimensions. Got " +
+                std::to_string(arr.ElementLength()) + ", expected multiple of " + std::to_string(dims_));
         }
-        
-        // Get index type (default to "FLAT_L2" -> "Flat")
-        std::string indexDescription = "Flat";  // Default: IndexFlatL2
-        std::string typeLabel = "FLAT_L2";
-        int metric = 1;  // Default: METRIC_L2
-        bool isHnsw = false;
-        int efConstruction = 200;
-        int efSearch = 50;
-        std::string factoryDescription;
 
-        auto readPositiveInt = [&](const char* key, int defaultValue) -> int {
-            if (!config.Has(key)) {
-                return defaultValue;
+        // The batch is copied here; the promise settles once it is queued, which holds
+        // the stream back while the pipeline is full without blocking any thread
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        std::vector<float> batch(arr.Data(), arr.Data() + arr.ElementLength());
+        IngestCall* call = IngestCall::New(env, deferred);
+        try {
+            if (pipeline_->Push(std::move(batch), [call](std::exception_ptr error) { call->Settle(error); })) {
+                call->Settle(nullptr);
             }
+        } catch (const std::exception&) {
+            call->Settle(std::current_exception());
+        }
+        return deferred.Promise();
+    }
 
-            if (!config.Get(key).IsNumber()) {
-                throw Napi::TypeError::New(env, std::string("Expected number for ") + key);
-            }
+    Napi::Value Finish(const Napi::CallbackInfo& info) {
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
+        IngestCall* call = IngestCall::New(info.Env(), deferred);
+        try {
+            pipeline_->Finish([call](size_t added, std::exception_ptr error) { call->Settle(error, added); });
+        } catch (const std::exception&) {
+            call->Settle(std::current_exception());
+        }
+        return deferred.Promise();
+    }
 
-            int value = config.Get(key).As<Napi::Number>().Int32Value();
-            if (value <= 0) {
-                throw Napi::RangeError::New(env, std::string(key) + " must be positive");
-            }
+    Napi::Value Abort(const Napi::CallbackInfo& info) {
+        pipeline_->Abort();
+        return info.Env().Undefined();
+    }
 
-            return value;
-        };
+    Napi::Value GetAdded(const Napi::CallbackInfo& info) {
+        return Napi::Number::New(info.Env(), static_cast<double>(pipeline_->Added()));
+    }
+};
 
-        auto pqDescription = [&](int defaultSegments = 8, int defaultBits = 8) -> std::string {
-            int pqSegments = readPositiveInt("pqSegments", defaultSegments);
-            int pqBits = readPositiveInt("pqBits", defaultBits);
+Napi::FunctionReference IngestPipelineJS::constructor;
 
-            if (dims_ % pqSegments != 0) {
-                throw Napi::RangeError::New(
-                    env,
-                    "pqSegments must evenly divide dims. Got dims=" +
-                    std::to_string(dims_) + ", pqSegments=" + std::to_string(pqSegments));
-            }
+// Builds a wrapper from a JS index config; forceIdMap id-maps it regardless of config.idMap
+static std::unique_ptr<FaissIndexWrapper> CreateWrapperFromConfig(
+        Napi::Env env, const Napi::Object& config, bool forceIdMap = false) {
+    if (!config.Has("dims") || !config.Get("dims").IsNumber()) {
+        throw Napi::TypeError::New(env, "Config must have 'dims' as a number");
+    }
+    
+    const int dims = config.Get("dims").As<Napi::Number>().Int32Value();
+    
+    if (dims <= 0) {
+        throw Napi::RangeError::New(env, "Dimensions must be positive");
+    }
+    
+    // Get index type (default to "FLAT_L2" -> "Flat")
+    std::string indexDescription = "Flat";  // Default: IndexFlatL2
+    std::string typeLabel = "FLAT_L2";
+    int metric = 1;  // Default: METRIC_L2
+    bool isHnsw = false;
+    int efConstruction = 200;
+    int efSearch = 50;
+    bool idMap = false;
+    std::string factoryDescription;
+
+    auto readPositiveInt = [&](const char* key, int defaultValue) -> int {
+        if (!config.Has(key)) {
+            return defaultValue;
+        }
 
-            if (pqBits == 8) {
-                return "PQ" + std::to_string(pqSegments);
-            }
+        if (!config.Get(key).IsNumber()) {
+            throw Napi::TypeError::New(env, std::string("Expected number for ") + key);
+        }
 
-            return "PQ" + std::to_string(pqSegments) + "x" + std::to_string(pqBits);
-        };
+        int value = config.Get(key).As<Napi::Number>().Int32Value();
+        if (value <= 0) {
+            throw Napi::RangeError::New(env, std::string(key) + " must be positive");
+        }
 
-        auto metricFromConfig = [&]() -> int {
-            if (!config.Has("metric")) {
-                return metric;
-            }
+        return value;
+    };
 
-            if (!config.Get("metric").IsString()) {
-                throw Napi::TypeError::New(env, "Expected string for metric");
-            }
+    auto pqDescription = [&](int defaultSegments = 8, int defaultBits = 8) -> std::string {
+        int pqSegments = readPositiveInt("pqSegments", defaultSegments);
+        int pqBits = readPositiveInt("pqBits", defaultBits);
 
-            std::string metricName = config.Get("metric").As<Napi::String>().Utf8Value();
-            if (metricName == "l2") {
-                return 1;
-            }
+        if (dims % pqSegments != 0) {
+            throw Napi::RangeError::New(
+                env,
+                "pqSegments must evenly divide dims. Got dims=" +
+                std::to_string(dims) + ", pqSegments=" + std::to_string(pqSegments));
+        }
 
-            if (metricName == "ip") {
-                return 0;
-            }
+        if (pqBits == 8) {
+            return "PQ" + std::to_string(pqSegments);
+        }
 
-            throw Napi::TypeError::New(env, "Unsupported metric: " + metricName + ". Supported: l2, ip");
-        };
+        return "PQ" + std::to_string(pqSegments) + "x" + std::to_string(pqBits);
+    };
 
-        if (config.Has("factory")) {
-            if (!config.Get("factory").IsString()) {
-                throw Napi::TypeError::New(env, "Expected string for factory");
-            }
+    auto metricFromConfig = [&]() -> int {
+        if (!config.Has("metric")) {
+            return metric;
+        }
+
+        if (!config.Get("metric").IsString()) {
+            throw Napi::TypeError::New(env, "Expected string for metric");
+        }
+
+        std::string metricName = config.Get("metric").As<Napi::String>().Utf8Value();
+        if (metricName == "l2") {
+            return 1;
+        }
+
+        if (metricName == "ip") {
+            return 0;
+        }
+
+        throw Napi::TypeError::New(env, "Unsupported metric: " + metricName + ". Supported: l2, ip");
+    };
 
-            indexDescription = config.Get("factory").As<Napi::String>().Utf8Value();
-            factoryDescription = indexDescription;
-            typeLabel.clear();
+    if (config.Has("factory")) {
+        if (!config.Get("factory").IsString()) {
+            throw Napi::TypeError::New(env, "Expected string for factory");
+        }
+
+        indexDescription = config.Get("factory").As<Napi::String>().Utf8Value();
+        factoryDescription = indexDescription;
+        typeLabel.clear();
+        metric = metricFromConfig();
+    } else if (config.Has("type") && config.Get("type").IsString()) {
+        std::string type = config.Get("type").As<Napi::String>().Utf8Value();
+        typeLabel = type;
+
+        if (type == "FLAT_L2") {
+            indexDescription = "Flat";
+            metric = 1;  // METRIC_L2
+        } else if (type == "FLAT_IP") {
+            indexDescription = "Flat";
+            metric = 0;  // METRIC_INNER_PRODUCT
+        } else if (type == "IVF_FLAT") {
+            int nlist = readPositiveInt("nlist", 100);
+            indexDescription = "IVF" + std::to_string(nlist) + ",Flat";
             metric = metricFromConfig();
-        } else if (config.Has("type") && config.Get("type").IsString()) {
-            std::string type = config.Get("type").As<Napi::String>().Utf8Value();
-            typeLabel = type;
-
-            if (type == "FLAT_L2") {
-                indexDescription = "Flat";
-                metric = 1;  // METRIC_L2
-            } else if (type == "FLAT_IP") {
-                indexDescription = "Flat";
-                metric = 0;  // METRIC_INNER_PRODUCT
-            } else if (type == "IVF_FLAT") {
-                int nlist = readPositiveInt("nlist", 100);
-                indexDescription = "IVF" + std::to_string(nlist) + ",Flat";
-                metric = metricFromConfig();
-            } else if (type == "PQ") {
-                indexDescription = pqDescription();
-                metric = metricFromConfig();
-            } else if (type == "IVF_PQ") {
-                int nlist = readPositiveInt("nlist", 100);
-                indexDescription = "IVF" + std::to_string(nlist) + "," + pqDescription();
-                metric = metricFromConfig();
-            } else if (type == "IVF_SQ") {
-                int nlist = readPositiveInt("nlist", 100);
-                std::string sqType = "SQ8";
-                if (config.Has("sqType")) {
-                    if (!config.Get("sqType").IsString()) {
-                        throw Napi::TypeError::New(env, "Expected string for sqType");
-                    }
-                    sqType = config.Get("sqType").As<Napi::String>().Utf8Value();
-                    if (sqType.empty()) {
-                        throw Napi::TypeError::New(env, "sqType must be a non-empty string");
-                    }
+        } else if (type == "PQ") {
+            indexDescription = pqDescription();
+            metric = metricFromConfig();
+        } else if (type == "IVF_PQ") {
+            int nlist = readPositiveInt("nlist", 100);
+            indexDescription = "IVF" + std::to_string(nlist) + "," + pqDescription();
+            metric = metricFromConfig();
+        } else if (type == "IVF_SQ") {
+            int nlist = readPositiveInt("nlist", 100);
+            std::string sqType = "SQ8";
+            if (config.Has("sqType")) {
+                if (!config.Get("sqType").IsString()) {
+                    throw Napi::TypeError::New(env, "Expected string for sqType");
                 }
-                indexDescription = "IVF" + std::to_string(nlist) + "," + sqType;
-                metric = metricFromConfig();
-            } else if (type == "HNSW") {
-                isHnsw = true;
-                int M = readPositiveInt("M", 16);
-                indexDescription = "HNSW" + std::to_string(M);
-                metric = metricFromConfig();
-
-                if (config.Has("efConstruction")) {
-                    efConstruction = readPositiveInt("efConstruction", efConstruction);
+                sqType = config.Get("sqType").As<Napi::String>().Utf8Value();
+                if (sqType.empty()) {
+                    throw Napi::TypeError::New(env, "sqType must be a non-empty string");
                 }
+            }
+            indexDescription = "IVF" + std::to_string(nlist) + "," + sqType;
+            metric = metricFromConfig();
+        } else if (type == "HNSW") {
+            isHnsw = true;
+            int M = readPositiveInt("M", 16);
+            indexDescription = "HNSW" + std::to_string(M);
+            metric = metricFromConfig();
 
-                if (config.Has("efSearch")) {
-                    efSearch = readPositiveInt("efSearch", efSearch);
-                }
-            } else {
-                throw Napi::TypeError::New(
-                    env,
-                    "Unsupported index type: " + type +
-                    ". Supported: FLAT_L2, FLAT_IP, IVF_FLAT, HNSW, PQ, IVF_PQ, IVF_SQ");
+            if (config.Has("efConstruction")) {
+                efConstruction = readPositiveInt("efConstruction", efConstruction);
+            }
+
+            if (config.Has("efSearch")) {
+                efSearch = readPositiveInt("efSearch", efSearch);
             }
+        } else {
+            throw Napi::TypeError::New(
+                env,
+                "Unsupported index type: " + type +
+                ". Supported: FLAT_L2, FLAT_IP, IVF_FLAT, HNSW, PQ, IVF_PQ, IVF_SQ");
+        }
+    }
+
+    // Re-rank the base index's candidates against a finer copy of the vectors:
+    // "Flat" keeps exact floats (RFlat), anything else names a factory codec (e.g. SQ8)
+    bool hasRefine = false;
+    if (config.Has("refine")) {
+        if (!config.Get("refine").IsString()) {
+            throw Napi::TypeError::New(env, "Expected string for refine");
+        }
+        std::string refine = config.Get("refine").As<Napi::String>().Utf8Value();
+        if (refine.empty()) {
+            throw Napi::TypeError::New(env, "refine must be a non-empty string");
+        }
+        std::string suffix = refine == "Flat" ? ",RFlat" : ",Refine(" + refine + ")";
+        indexDescription += suffix;
+        if (!factoryDescription.empty()) {
+            factoryDescription += suffix;
+        }
+        hasRefine = true;
+    }
+    float kFactor = ReadKFactorOption(env, config);
+    if (hasRefine && kFactor == 0) {
+        kFactor = 4;
+    }
+
+    if (config.Has("idMap")) {
+        if (!config.Get("idMap").IsBoolean()) {
+            throw Napi::TypeError::New(env, "Expected boolean for idMap");
+        }
+        idMap = config.Get("idMap").As<Napi::Boolean>().Value();
+    }
+
+    // Create the C++ wrapper with index_factory
+    auto wrapper = std::make_unique<FaissIndexWrapper>(
+        dims,
+        indexDescription,
+        metric,
+        typeLabel,
+        factoryDescription,
+        idMap || forceIdMap);
+
+    if (isHnsw) {
+        wrapper->SetHnswParams(efConstruction, efSearch);
+    }
+
+    if (kFactor > 0) {
+        wrapper->SetRefineKFactor(kFactor);
+    }
+    
+    // Set nprobe for IVF indexes
+    if (config.Has("nprobe") && config.Get("nprobe").IsNumber()) {
+        int nprobe = config.Get("nprobe").As<Napi::Number>().Int32Value();
+        if (nprobe <= 0) {
+            throw Napi::RangeError::New(env, "nprobe must be positive");
         }
+        wrapper->SetNprobe(nprobe);
+    }
+
+    return wrapper;
+}
+
+// Wrapper class that bridges N-API and our C++ wrapper
+class FaissIndexWrapperJS : public Napi::ObjectWrap<FaissIndexWrapperJS> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    FaissIndexWrapperJS(const Napi::CallbackInfo& info);
+    ~FaissIndexWrapperJS();
+
+private:
+    static Napi::FunctionReference constructor;
+    // Workers take their own reference, so swap() can replace the index while calls
+    // already submitted finish on the one they started with
+    std::shared_ptr<FaissIndexWrapper> wrapper_;
+    std::shared_ptr<InFlightCalls> in_flight_ = std::make_shared<InFlightCalls>();
+    // Counters of objects whose index was swapped into this one: calls submitted through
+    // them may still be running on wrapper_
+    std::vector<std::shared_ptr<InFlightCalls>> adopted_in_flight_;
+    std::shared_ptr<SearchCoalescer> coalescer_;  // null unless search coalescing is enabled
+    int dims_;
+
+    // The current index for one worker, counted as in flight until the worker is done
+    std::shared_ptr<FaissIndexWrapper> Acquire();
+    std::shared_ptr<SearchCoalescer> NewCoalescer(size_t maxBatchSize, std::chrono::microseconds window);
+    
+    // Methods
+    Napi::Value Add(const Napi::CallbackInfo& info);
+    Napi::Value AddWithIds(const Napi::CallbackInfo& info);
+    Napi::Value AddFromFile(const Napi::CallbackInfo& info);
+    Napi::Value AddWithProgress(const Napi::CallbackInfo& info);
+    Napi::Value CreateIngestPipeline(const Napi::CallbackInfo& info);
+    Napi::Value Train(const Napi::CallbackInfo& info);
+    Napi::Value Search(const Napi::CallbackInfo& info);
+    Napi::Value SearchBatch(const Napi::CallbackInfo& info);
+    Napi::Value RangeSearch(const Napi::CallbackInfo& info);
+    Napi::Value RangeSearchBatch(const Napi::CallbackInfo& info);
+    Napi::Value Reconstruct(const Napi::CallbackInfo& info);
+    Napi::Value ReconstructBatch(const Napi::CallbackInfo& info);
+    Napi::Value RemoveIds(const Napi::CallbackInfo& info);
+    Napi::Value GetStats(const Napi::CallbackInfo& info);
+    Napi::Value Dispose(const Napi::CallbackInfo& info);
+    Napi::Value DisposeAsync(const Napi::CallbackInfo& info);
+    Napi::Value Save(const Napi::CallbackInfo& info);
+    Napi::Value ToBuffer(const Napi::CallbackInfo& info);
+    Napi::Value MergeFrom(const Napi::CallbackInfo& info);
+    Napi::Value Swap(const Napi::CallbackInfo& info);
+    Napi::Value SetNprobe(const Napi::CallbackInfo& info);
+    Napi::Value SetSearchCoalescing(const Napi::CallbackInfo& info);
+    Napi::Value ToGpu(const Napi::CallbackInfo& info);
+    Napi::Value ToCpu(const Napi::CallbackInfo& info);
+    Napi::Value Reset(const Napi::CallbackInfo& info);
+    Napi::Value ResetAsync(const Napi::CallbackInfo& info);
+    
+    // Static methods
+    static Napi::Value Load(const Napi::CallbackInfo& info);
+    static Napi::Value FromBuffer(const Napi::CallbackInfo& info);
+    static Napi::Value GpuSupport(const Napi::CallbackInfo& info);
+    
+    // Helper methods
+    void ValidateNotDisposed(Napi::Env env) const;
+    Napi::Float32Array CreateFloat32Array(Napi::Env env, size_t length, const float* data);
+    Napi::Int32Array CreateInt32Array(Napi::Env env, size_t length, const faiss::idx_t* data);
+};
 
-        // Create the C++ wrapper with index_factory
-        wrapper_ = std::make_unique<FaissIndexWrapper>(
-            dims_,
-            indexDescription,
-            metric,
-            typeLabel,
-            factoryDescription);
+// Static constructor reference
+Napi::FunctionReference FaissIndexWrapperJS::constructor;
+
+Napi::Object FaissIndexWrapperJS::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "FaissIndexWrapper", {
+        InstanceMethod("add", &FaissIndexWrapperJS::Add),
+        InstanceMethod("addWithIds", &FaissIndexWrapperJS::AddWithIds),
+        InstanceMethod("addFromFile", &FaissIndexWrapperJS::AddFromFile),
+        InstanceMethod("addWithProgress", &FaissIndexWrapperJS::AddWithProgress),
+        InstanceMethod("createIngestPipeline", &FaissIndexWrapperJS::CreateIngestPipeline),
+        InstanceMethod("train", &FaissIndexWrapperJS::Train),
+        InstanceMethod("search", &FaissIndexWrapperJS::Search),
+        InstanceMethod("searchBatch", &FaissIndexWrapperJS::SearchBatch),
+        InstanceMethod("rangeSearch", &FaissIndexWrapperJS::RangeSearch),
+        InstanceMethod("rangeSearchBatch", &FaissIndexWrapperJS::RangeSearchBatch),
+        InstanceMethod("reconstruct", &FaissIndexWrapperJS::Reconstruct),
+        InstanceMethod("reconstructBatch", &FaissIndexWrapperJS::ReconstructBatch),
+        InstanceMethod("removeIds", &FaissIndexWrapperJS::RemoveIds),
+        InstanceMethod("getStats", &FaissIndexWrapperJS::GetStats),
+        InstanceMethod("dispose", &FaissIndexWrapperJS::Dispose),
+        InstanceMethod("disposeAsync", &FaissIndexWrapperJS::DisposeAsync),
+        InstanceMethod("save", &FaissIndexWrapperJS::Save),
+        InstanceMethod("toBuffer", &FaissIndexWrapperJS::ToBuffer),
+        InstanceMethod("mergeFrom", &FaissIndexWrapperJS::MergeFrom),
+        InstanceMethod("swap", &FaissIndexWrapperJS::Swap),
+        InstanceMethod("setNprobe", &FaissIndexWrapperJS::SetNprobe),
+        InstanceMethod("setSearchCoalescing", &FaissIndexWrapperJS::SetSearchCoalescing),
+        InstanceMethod("toGpu", &FaissIndexWrapperJS::ToGpu),
+        InstanceMethod("toCpu", &FaissIndexWrapperJS::ToCpu),
+        InstanceMethod("reset", &FaissIndexWrapperJS::Reset),
+        InstanceMethod("resetAsync", &FaissIndexWrapperJS::ResetAsync),
+        StaticMethod("load", &FaissIndexWrapperJS::Load),
+        StaticMethod("fromBuffer", &FaissIndexWrapperJS::FromBuffer),
+        StaticMethod("gpuSupport", &FaissIndexWrapperJS::GpuSupport),
+    });
+    
+    constructor = Napi::Persistent(func);
+    constructor.SuppressDestruct();
+    
+    exports.Set("FaissIndexWrapper", func);
+    return exports;
+}
 
-        if (isHnsw) {
-            wrapper_->SetHnswParams(efConstruction, efSearch);
+FaissIndexWrapperJS::FaissIndexWrapperJS(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<FaissIndexWrapperJS>(info), dims_(0) {
+    Napi::Env env = info.Env();
+    
+    try {
+        // Validate constructor arguments
+        if (info.Length() < 1) {
+            throw Napi::TypeError::New(env, "Expected 1 argument: { dims: number }");
         }
         
-        // Set nprobe for IVF indexes
-        if (config.Has("nprobe") && config.Get("nprobe").IsNumber()) {
-            int nprobe = config.Get("nprobe").As<Napi::Number>().Int32Value();
-            if (nprobe <= 0) {
-                throw Napi::RangeError::New(env, "nprobe must be positive");
-            }
-            wrapper_->SetNprobe(nprobe);
+        if (!info[0].IsObject()) {
+            throw Napi::TypeError::New(env, "Expected object with 'dims' property");
         }
         
+        wrapper_ = CreateWrapperFromConfig(env, info[0].As<Napi::Object>());
+        dims_ = wrapper_->GetDimensions();
+        
     } catch (const Napi::Error& e) {
         throw; // Re-throw N-API errors
     } catch (const std::exception& e) {
@@ -847,11 +2024,8 @@ FaissIndexWrapperJS::FaissIndexWrapperJS(const Napi::CallbackInfo& info)
 }
 
 FaissIndexWrapperJS::~FaissIndexWrapperJS() {
-    // RAII: wrapper_ will be automatically destroyed
-    // But we can explicitly dispose if needed
-    if (wrapper_ && !wrapper_->IsDisposed()) {
-        wrapper_->Dispose();
-    }
+    // Only drop this reference: the index is disposed by its own destructor once any
+    // workers still holding it have finished
 }
 
 void FaissIndexWrapperJS::ValidateNotDisposed(Napi::Env env) const {
@@ -892,12 +2066,14 @@ Napi::Value FaissIndexWrapperJS::Add(const Napi::CallbackInfo& info) {
         
         size_t n = length / dims_;
         
-        // Get pointer to data (zero-copy read) - copy data for async worker
-        const float* data = floatArr.Data();
+        // Inputs are copied for the async worker unless the caller opts into borrowing
+        bool borrow = ReadBoolOption(env, info[1], "borrow", false);
+        bool validate = ReadBoolOption(env, info[1], "validate", false);
+        int threads = ReadThreadsOption(env, info[1]);
         
         // Create promise and async worker
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        AddWorker* worker = new AddWorker(wrapper_.get(), data, n, dims_, deferred);
+        AddWorker* worker = new AddWorker(Acquire(), FloatInput(floatArr, borrow, validate), n, threads, deferred);
         worker->Queue();
         
         return deferred.Promise();
@@ -911,71 +2087,317 @@ Napi::Value FaissIndexWrapperJS::Add(const Napi::CallbackInfo& info) {
     }
 }
 
-Napi::Value FaissIndexWrapperJS::Train(const Napi::CallbackInfo& info) {
+Napi::Value FaissIndexWrapperJS::AddWithIds(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    
+
     try {
         ValidateNotDisposed(env);
-        
-        if (info.Length() < 1) {
-            throw Napi::TypeError::New(env, "Expected 1 argument: vectors (Float32Array)");
+
+        if (info.Length() < 2) {
+            throw Napi::TypeError::New(env, "Expected 2 arguments: vectors (Float32Array), ids (BigInt64Array)");
         }
-        
-        if (!info[0].IsTypedArray()) {
+
+        if (!info[0].IsTypedArray() || info[0].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
             throw Napi::TypeError::New(env, "Expected Float32Array");
         }
-        
-        Napi::TypedArray arr = info[0].As<Napi::TypedArray>();
-        
-        if (arr.TypedArrayType() != napi_float32_array) {
-            throw Napi::TypeError::New(env, "Expected Float32Array");
+
+        if (!info[1].IsTypedArray() || info[1].As<Napi::TypedArray>().TypedArrayType() != napi_bigint64_array) {
+            throw Napi::TypeError::New(env, "Expected BigInt64Array for ids");
         }
-        
-        Napi::Float32Array floatArr = arr.As<Napi::Float32Array>();
+
+        Napi::Float32Array floatArr = info[0].As<Napi::Float32Array>();
+        Napi::BigInt64Array idsArr = info[1].As<Napi::BigInt64Array>();
         size_t length = floatArr.ElementLength();
-        
-        // Validate dimensions
+
         if (length % dims_ != 0) {
-            throw Napi::RangeError::New(env, 
-                "Vector length must be a multiple of dimensions. Got " + 
+            throw Napi::RangeError::New(env,
+                "Vector length must be a multiple of dimensions. Got " +
                 std::to_string(length) + ", expected multiple of " + std::to_string(dims_));
         }
-        
+
         size_t n = length / dims_;
-        
-        // Get pointer to data (zero-copy read) - copy data for async worker
-        const float* data = floatArr.Data();
-        
-        // Create promise and async worker
+        if (idsArr.ElementLength() != n) {
+            throw Napi::RangeError::New(env,
+                "ids length must match the number of vectors. Got " +
+                std::to_string(idsArr.ElementLength()) + ", expected " + std::to_string(n));
+        }
+
+        const int64_t* ids = idsArr.Data();
+        for (size_t i = 0; i < n; i++) {
+            if (ids[i] < 0) {
+                throw Napi::RangeError::New(env, "ids must be non-negative");
+            }
+        }
+
+        bool borrow = ReadBoolOption(env, info[2], "borrow", false);
+        bool validate = ReadBoolOption(env, info[2], "validate", false);
+        int threads = ReadThreadsOption(env, info[2]);
+
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        TrainWorker* worker = new TrainWorker(wrapper_.get(), data, n, dims_, deferred);
+        AddWithIdsWorker* worker = new AddWithIdsWorker(Acquire(), FloatInput(floatArr, borrow, validate), ids, n, threads, deferred);
         worker->Queue();
-        
+
         return deferred.Promise();
-        
+
     } catch (const Napi::Error& e) {
         throw; // Re-throw N-API errors
     } catch (const std::exception& e) {
         throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
     } catch (...) {
-        throw Napi::Error::New(env, "Unknown error in train()");
+        throw Napi::Error::New(env, "Unknown error in addWithIds()");
     }
 }
 
-Napi::Value FaissIndexWrapperJS::SetNprobe(const Napi::CallbackInfo& info) {
+Napi::Value FaissIndexWrapperJS::AddFromFile(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    
+
     try {
         ValidateNotDisposed(env);
-        
-        if (info.Length() < 1) {
-            throw Napi::TypeError::New(env, "Expected 1 argument: nprobe (number)");
-        }
-        
-        if (!info[0].IsNumber()) {
-            throw Napi::TypeError::New(env, "Expected number for nprobe");
+
+        if (info.Length() < 1 || !info[0].IsString()) {
+            throw Napi::TypeError::New(env, "Expected string for path");
         }
-        
+        std::string path = info[0].As<Napi::String>().Utf8Value();
+
+        std::string formatName = "raw";
+        size_t batchSize = 10000;
+        Napi::Function onProgress;
+        if (info.Length() > 1 && !info[1].IsUndefined()) {
+            if (!info[1].IsObject()) {
+                throw Napi::TypeError::New(env, "Expected object for options");
+            }
+            Napi::Object options = info[1].As<Napi::Object>();
+
+            Napi::Value format = options.Get("format");
+            if (!format.IsUndefined()) {
+                if (!format.IsString()) {
+                    throw Napi::TypeError::New(env, "Expected string for format");
+                }
+                formatName = format.As<Napi::String>().Utf8Value();
+            }
+
+            int batch = ReadPositiveIntOption(env, options, "batchSize");
+            if (batch > 0) {
+                batchSize = static_cast<size_t>(batch);
+            }
+
+            Napi::Value callback = options.Get("onProgress");
+            if (!callback.IsUndefined()) {
+                if (!callback.IsFunction()) {
+                    throw Napi::TypeError::New(env, "Expected function for onProgress");
+                }
+                onProgress = callback.As<Napi::Function>();
+            }
+        }
+
+        VectorFileReader::Format format;
+        try {
+            format = VectorFileReader::ParseFormat(formatName);
+        } catch (const std::invalid_argument& e) {
+            throw Napi::TypeError::New(env, e.what());
+        }
+
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        AddFromFileWorker* worker =
+            new AddFromFileWorker(Acquire(), std::move(path), format, batchSize, onProgress, deferred);
+        worker->Queue();
+
+        return deferred.Promise();
+
+    } catch (const Napi::Error& e) {
+        throw; // Re-throw N-API errors
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    } catch (...) {
+        throw Napi::Error::New(env, "Unknown error in addFromFile()");
+    }
+}
+
+// addWithProgress(vectors, ids | null, { batchSize, onProgress, signal, borrow, validate, threads })
+// resolves to the number of vectors added
+Napi::Value FaissIndexWrapperJS::AddWithProgress(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    try {
+        ValidateNotDisposed(env);
+
+        if (info.Length() < 1 || !info[0].IsTypedArray() ||
+            info[0].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+            throw Napi::TypeError::New(env, "Expected Float32Array");
+        }
+
+        Napi::Float32Array floatArr = info[0].As<Napi::Float32Array>();
+        size_t length = floatArr.ElementLength();
+        if (length % dims_ != 0) {
+            throw Napi::RangeError::New(env,
+                "Vector length must be a multiple of dimensions. Got " +
+                std::to_string(length) + ", expected multiple of " + std::to_string(dims_));
+        }
+        size_t n = length / dims_;
+
+        std::vector<int64_t> ids;
+        if (info.Length() > 1 && !info[1].IsUndefined() && !info[1].IsNull()) {
+            if (!info[1].IsTypedArray() || info[1].As<Napi::TypedArray>().TypedArrayType() != napi_bigint64_array) {
+                throw Napi::TypeError::New(env, "Expected BigInt64Array for ids");
+            }
+            Napi::BigInt64Array idsArr = info[1].As<Napi::BigInt64Array>();
+            if (idsArr.ElementLength() != n) {
+                throw Napi::RangeError::New(env,
+                    "ids length must match the number of vectors. Got " +
+                    std::to_string(idsArr.ElementLength()) + ", expected " + std::to_string(n));
+            }
+            ids.assign(idsArr.Data(), idsArr.Data() + n);
+            for (int64_t id : ids) {
+                if (id < 0) {
+                    throw Napi::RangeError::New(env, "ids must be non-negative");
+                }
+            }
+        }
+
+        Napi::Value optionsValue = info.Length() > 2 ? info[2] : env.Undefined();
+        bool borrow = ReadBoolOption(env, optionsValue, "borrow", false);
+        bool validate = ReadBoolOption(env, optionsValue, "validate", false);
+        int threads = ReadThreadsOption(env, optionsValue);
+
+        size_t batchSize = 10000;
+        Napi::Function onProgress;
+        Napi::Object signal;
+        if (optionsValue.IsObject()) {
+            Napi::Object options = optionsValue.As<Napi::Object>();
+
+            int batch = ReadPositiveIntOption(env, options, "batchSize");
+            if (batch > 0) {
+                batchSize = static_cast<size_t>(batch);
+            }
+
+            Napi::Value callback = options.Get("onProgress");
+            if (!callback.IsUndefined()) {
+                if (!callback.IsFunction()) {
+                    throw Napi::TypeError::New(env, "Expected function for onProgress");
+                }
+                onProgress = callback.As<Napi::Function>();
+            }
+
+            Napi::Value signalValue = options.Get("signal");
+            if (!signalValue.IsUndefined()) {
+                if (!signalValue.IsObject() || !signalValue.As<Napi::Object>().Get("addEventListener").IsFunction()) {
+                    throw Napi::TypeError::New(env, "Expected AbortSignal for signal");
+                }
+                signal = signalValue.As<Napi::Object>();
+            }
+        }
+
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        AddWithProgressWorker* worker = new AddWithProgressWorker(
+            Acquire(), FloatInput(floatArr, borrow, validate), std::move(ids), n, batchSize, threads,
+            onProgress, signal, deferred);
+        worker->Queue();
+
+        return deferred.Promise();
+
+    } catch (const Napi::Error& e) {
+        throw; // Re-throw N-API errors
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    } catch (...) {
+        throw Napi::Error::New(env, "Unknown error in addWithProgress()");
+    }
+}
+
+Napi::Value FaissIndexWrapperJS::CreateIngestPipeline(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    try {
+        ValidateNotDisposed(env);
+
+        IngestOptions options;
+        options.validate = ReadBoolOption(env, info[0], "validate", options.validate);
+        options.normalize = ReadBoolOption(env, info[0], "normalize", options.normalize);
+        if (info[0].IsObject()) {
+            int depth = ReadPositiveIntOption(env, info[0].As<Napi::Object>(), "queueDepth");
+            if (depth > 0) {
+                options.queue_depth = static_cast<size_t>(depth);
+            }
+        }
+
+        return IngestPipelineJS::NewInstance(Value(), wrapper_, options);
+
+    } catch (const Napi::Error& e) {
+        throw; // Re-throw N-API errors
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    } catch (...) {
+        throw Napi::Error::New(env, "Unknown error in createIngestPipeline()");
+    }
+}
+
+Napi::Value FaissIndexWrapperJS::Train(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        ValidateNotDisposed(env);
+        
+        if (info.Length() < 1) {
+            throw Napi::TypeError::New(env, "Expected 1 argument: vectors (Float32Array)");
+        }
+        
+        if (!info[0].IsTypedArray()) {
+            throw Napi::TypeError::New(env, "Expected Float32Array");
+        }
+        
+        Napi::TypedArray arr = info[0].As<Napi::TypedArray>();
+        
+        if (arr.TypedArrayType() != napi_float32_array) {
+            throw Napi::TypeError::New(env, "Expected Float32Array");
+        }
+        
+        Napi::Float32Array floatArr = arr.As<Napi::Float32Array>();
+        size_t length = floatArr.ElementLength();
+        
+        // Validate dimensions
+        if (length % dims_ != 0) {
+            throw Napi::RangeError::New(env, 
+                "Vector length must be a multiple of dimensions. Got " + 
+                std::to_string(length) + ", expected multiple of " + std::to_string(dims_));
+        }
+        
+        size_t n = length / dims_;
+        
+        // Inputs are copied for the async worker unless the caller opts into borrowing
+        bool borrow = ReadBoolOption(env, info[1], "borrow", false);
+        bool validate = ReadBoolOption(env, info[1], "validate", false);
+        int threads = ReadThreadsOption(env, info[1]);
+        
+        // Create promise and async worker
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        TrainWorker* worker = new TrainWorker(Acquire(), FloatInput(floatArr, borrow, validate), n, threads, deferred);
+        worker->Queue();
+        
+        return deferred.Promise();
+        
+    } catch (const Napi::Error& e) {
+        throw; // Re-throw N-API errors
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    } catch (...) {
+        throw Napi::Error::New(env, "Unknown error in train()");
+    }
+}
+
+Napi::Value FaissIndexWrapperJS::SetNprobe(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        ValidateNotDisposed(env);
+        
+        if (info.Length() < 1) {
+            throw Napi::TypeError::New(env, "Expected 1 argument: nprobe (number)");
+        }
+        
+        if (!info[0].IsNumber()) {
+            throw Napi::TypeError::New(env, "Expected number for nprobe");
+        }
+        
         int nprobe = info[0].As<Napi::Number>().Int32Value();
         
         if (nprobe <= 0) {
@@ -994,6 +2416,60 @@ Napi::Value FaissIndexWrapperJS::SetNprobe(const Napi::CallbackInfo& info) {
     }
 }
 
+Napi::Value FaissIndexWrapperJS::SetSearchCoalescing(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    try {
+        ValidateNotDisposed(env);
+
+        if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+            // Disable: requests already queued still drain through the existing worker
+            coalescer_.reset();
+            return env.Undefined();
+        }
+
+        if (!info[0].IsObject()) {
+            throw Napi::TypeError::New(env, "Expected object: { maxBatchSize, windowUs }");
+        }
+
+        Napi::Object options = info[0].As<Napi::Object>();
+        int maxBatchSize = 64;
+        double windowUs = 1000;
+
+        if (options.Has("maxBatchSize")) {
+            if (!options.Get("maxBatchSize").IsNumber()) {
+                throw Napi::TypeError::New(env, "Expected number for maxBatchSize");
+            }
+            maxBatchSize = options.Get("maxBatchSize").As<Napi::Number>().Int32Value();
+            if (maxBatchSize <= 0) {
+                throw Napi::RangeError::New(env, "maxBatchSize must be positive");
+            }
+        }
+
+        if (options.Has("windowUs")) {
+            if (!options.Get("windowUs").IsNumber()) {
+                throw Napi::TypeError::New(env, "Expected number for windowUs");
+            }
+            windowUs = options.Get("windowUs").As<Napi::Number>().DoubleValue();
+            if (!(windowUs >= 0)) {
+                throw Napi::RangeError::New(env, "windowUs must be non-negative");
+            }
+        }
+
+        // A fresh coalescer per configuration keeps in-flight batches on their old settings
+        coalescer_ = NewCoalescer(static_cast<size_t>(maxBatchSize),
+                                  std::chrono::microseconds(static_cast<int64_t>(windowUs)));
+        return env.Undefined();
+
+    } catch (const Napi::Error& e) {
+        throw; // Re-throw N-API errors
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    } catch (...) {
+        throw Napi::Error::New(env, "Unknown error in setSearchCoalescing()");
+    }
+}
+
 Napi::Value FaissIndexWrapperJS::ToGpu(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
 
@@ -1013,7 +2489,7 @@ Napi::Value FaissIndexWrapperJS::ToGpu(const Napi::CallbackInfo& info) {
         }
 
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        GpuTransferWorker* worker = new GpuTransferWorker(Value(), wrapper_.get(), true, device, deferred);
+        GpuTransferWorker* worker = new GpuTransferWorker(Value(), Acquire(), true, device, deferred);
         worker->Queue();
         return deferred.Promise();
     } catch (const Napi::Error& e) {
@@ -1032,7 +2508,7 @@ Napi::Value FaissIndexWrapperJS::ToCpu(const Napi::CallbackInfo& info) {
         ValidateNotDisposed(env);
 
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        GpuTransferWorker* worker = new GpuTransferWorker(Value(), wrapper_.get(), false, 0, deferred);
+        GpuTransferWorker* worker = new GpuTransferWorker(Value(), Acquire(), false, 0, deferred);
         worker->Queue();
         return deferred.Promise();
     } catch (const Napi::Error& e) {
@@ -1080,12 +2556,32 @@ Napi::Value FaissIndexWrapperJS::Search(const Napi::CallbackInfo& info) {
             throw Napi::RangeError::New(env, "k must be positive");
         }
         
-        // Get query pointer (zero-copy read) - copy data for async worker
+        bool bigintLabels = ReadBigIntLabels(env, info[2], wrapper_->IsIdMapped());
+        
+        SearchOptions searchOptions = ReadSearchOptions(env, info[2]);
+        
+        // Inputs are copied for the async worker unless the caller opts into borrowing.
+        // Coalesced searches always copy, since each query joins a contiguous batch.
+        bool borrow = ReadBoolOption(env, info[2], "borrow", false);
+        bool validate = ReadBoolOption(env, info[2], "validate", false);
+        int threads = ReadThreadsOption(env, info[2]);
         const float* query = queryArr.Data();
         
         // Create promise and async worker
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        SearchWorker* worker = new SearchWorker(wrapper_.get(), query, k, deferred);
+        // Filtered or tuned searches run on their own, since a batch shares one set of search parameters
+        if (coalescer_ && searchOptions.IsDefault()) {
+            // Coalesced queries are copied here anyway, so a deferred check costs nothing to run now
+            if (validate && FindNonFinite(query, dims_) != static_cast<size_t>(dims_)) {
+                throw Napi::TypeError::New(env, "Query contains NaN or Infinity");
+            }
+            CoalescedSearchWorker::Submit(env, coalescer_, CoalescedSearchRequest{
+                std::vector<float>(query, query + dims_), k, bigintLabels, deferred, std::chrono::steady_clock::now()});
+            return deferred.Promise();
+        }
+
+        SearchWorker* worker = new SearchWorker(
+            Acquire(), FloatInput(queryArr, borrow, validate), k, bigintLabels, std::move(searchOptions), threads, deferred);
         worker->Queue();
         
         return deferred.Promise();
@@ -1142,12 +2638,19 @@ Napi::Value FaissIndexWrapperJS::SearchBatch(const Napi::CallbackInfo& info) {
             throw Napi::RangeError::New(env, "k must be positive");
         }
         
-        // Get queries pointer (zero-copy read) - copy data for async worker
-        const float* queries = queriesArr.Data();
+        bool bigintLabels = ReadBigIntLabels(env, info[2], wrapper_->IsIdMapped());
+        
+        SearchOptions searchOptions = ReadSearchOptions(env, info[2]);
+        
+        // Inputs are copied for the async worker unless the caller opts into borrowing
+        bool borrow = ReadBoolOption(env, info[2], "borrow", false);
+        bool validate = ReadBoolOption(env, info[2], "validate", false);
+        int threads = ReadThreadsOption(env, info[2]);
         
         // Create promise and async worker
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        SearchBatchWorker* worker = new SearchBatchWorker(wrapper_.get(), queries, nq, k, deferred);
+        SearchBatchWorker* worker = new SearchBatchWorker(
+            Acquire(), FloatInput(queriesArr, borrow, validate), nq, k, bigintLabels, std::move(searchOptions), threads, deferred);
         worker->Queue();
         
         return deferred.Promise();
@@ -1197,12 +2700,19 @@ Napi::Value FaissIndexWrapperJS::RangeSearch(const Napi::CallbackInfo& info) {
             throw Napi::RangeError::New(env, "Radius must be non-negative");
         }
         
-        // Get query pointer (zero-copy read) - copy data for async worker
-        const float* query = queryArr.Data();
+        bool bigintLabels = ReadBigIntLabels(env, info[2], wrapper_->IsIdMapped());
+        
+        SearchOptions searchOptions = ReadSearchOptions(env, info[2]);
+        
+        // Inputs are copied for the async worker unless the caller opts into borrowing
+        bool borrow = ReadBoolOption(env, info[2], "borrow", false);
+        bool validate = ReadBoolOption(env, info[2], "validate", false);
+        int threads = ReadThreadsOption(env, info[2]);
         
         // Create promise and async worker
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        RangeSearchWorker* worker = new RangeSearchWorker(wrapper_.get(), query, radius, deferred);
+        RangeSearchWorker* worker = new RangeSearchWorker(
+            Acquire(), FloatInput(queryArr, borrow, validate), radius, bigintLabels, std::move(searchOptions), threads, deferred);
         worker->Queue();
         
         return deferred.Promise();
@@ -1216,6 +2726,65 @@ Napi::Value FaissIndexWrapperJS::RangeSearch(const Napi::CallbackInfo& info) {
     }
 }
 
+Napi::Value FaissIndexWrapperJS::RangeSearchBatch(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        ValidateNotDisposed(env);
+        
+        if (info.Length() < 2) {
+            throw Napi::TypeError::New(env, "Expected 2 arguments: queries (Float32Array), radius (number)");
+        }
+        
+        if (!info[0].IsTypedArray() || info[0].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+            throw Napi::TypeError::New(env, "Expected Float32Array for queries");
+        }
+        
+        if (!info[1].IsNumber()) {
+            throw Napi::TypeError::New(env, "Expected number for radius");
+        }
+        
+        Napi::Float32Array queriesArr = info[0].As<Napi::Float32Array>();
+        size_t totalElements = queriesArr.ElementLength();
+        float radius = info[1].As<Napi::Number>().FloatValue();
+        
+        if (totalElements == 0) {
+            throw Napi::RangeError::New(env, "Queries array cannot be empty");
+        }
+        
+        if (totalElements % dims_ != 0) {
+            throw Napi::RangeError::New(env,
+                "Queries array length must be a multiple of index dimensions. Got " +
+                std::to_string(totalElements) + ", expected multiple of " + std::to_string(dims_));
+        }
+        
+        if (radius < 0) {
+            throw Napi::RangeError::New(env, "Radius must be non-negative");
+        }
+        
+        bool bigintLabels = ReadBigIntLabels(env, info[2], wrapper_->IsIdMapped());
+        SearchOptions searchOptions = ReadSearchOptions(env, info[2]);
+        bool borrow = ReadBoolOption(env, info[2], "borrow", false);
+        bool validate = ReadBoolOption(env, info[2], "validate", false);
+        int threads = ReadThreadsOption(env, info[2]);
+        
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        RangeSearchBatchWorker* worker = new RangeSearchBatchWorker(
+            Acquire(), FloatInput(queriesArr, borrow, validate), totalElements / dims_, radius,
+            bigintLabels, std::move(searchOptions), threads, deferred);
+        worker->Queue();
+        
+        return deferred.Promise();
+        
+    } catch (const Napi::Error& e) {
+        throw; // Re-throw N-API errors
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    } catch (...) {
+        throw Napi::Error::New(env, "Unknown error in rangeSearchBatch()");
+    }
+}
+
 Napi::Value FaissIndexWrapperJS::Reconstruct(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
 
@@ -1226,17 +2795,24 @@ Napi::Value FaissIndexWrapperJS::Reconstruct(const Napi::CallbackInfo& info) {
             throw Napi::TypeError::New(env, "Expected 1 argument: id (number)");
         }
 
-        if (!info[0].IsNumber()) {
-            throw Napi::TypeError::New(env, "Expected number for id");
+        int64_t id = 0;
+        if (info[0].IsBigInt()) {
+            bool lossless = true;
+            id = info[0].As<Napi::BigInt>().Int64Value(&lossless);
+            if (!lossless) {
+                throw Napi::RangeError::New(env, "id must fit in a signed 64-bit integer");
+            }
+        } else if (info[0].IsNumber()) {
+            id = static_cast<int64_t>(info[0].As<Napi::Number>().Int64Value());
+        } else {
+            throw Napi::TypeError::New(env, "Expected number or bigint for id");
         }
-
-        int64_t id = static_cast<int64_t>(info[0].As<Napi::Number>().Int64Value());
         if (id < 0) {
             throw Napi::RangeError::New(env, "id must be non-negative");
         }
 
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        ReconstructWorker* worker = new ReconstructWorker(wrapper_.get(), id, deferred);
+        ReconstructWorker* worker = new ReconstructWorker(Acquire(), id, deferred);
         worker->Queue();
 
         return deferred.Promise();
@@ -1257,31 +2833,25 @@ Napi::Value FaissIndexWrapperJS::ReconstructBatch(const Napi::CallbackInfo& info
         ValidateNotDisposed(env);
 
         if (info.Length() < 1) {
-            throw Napi::TypeError::New(env, "Expected 1 argument: ids (Int32Array)");
-        }
-
-        if (!info[0].IsTypedArray()) {
-            throw Napi::TypeError::New(env, "Expected Int32Array for ids");
-        }
-
-        Napi::TypedArray arr = info[0].As<Napi::TypedArray>();
-        if (arr.TypedArrayType() != napi_int32_array) {
-            throw Napi::TypeError::New(env, "Expected Int32Array for ids");
+            throw Napi::TypeError::New(env, "Expected 1 argument: ids (Int32Array or BigInt64Array)");
         }
 
-        Napi::Int32Array idsArr = arr.As<Napi::Int32Array>();
-        if (idsArr.ElementLength() == 0) {
-            throw Napi::RangeError::New(env, "ids array cannot be empty");
-        }
+        std::vector<int64_t> ids = ReadIdArray(env, info[0]);
 
-        for (size_t i = 0; i < idsArr.ElementLength(); i++) {
-            if (idsArr[i] < 0) {
-                throw Napi::RangeError::New(env, "ids must be non-negative");
+        Napi::Float32Array target;
+        if (!info[1].IsUndefined() && !info[1].IsNull()) {
+            if (!info[1].IsTypedArray() || info[1].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+                throw Napi::TypeError::New(env, "Expected Float32Array for output");
+            }
+            target = info[1].As<Napi::Float32Array>();
+            if (target.ElementLength() < ids.size() * static_cast<size_t>(dims_)) {
+                throw Napi::RangeError::New(env,
+                    "output must hold at least " + std::to_string(ids.size() * static_cast<size_t>(dims_)) + " floats");
             }
         }
 
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        ReconstructBatchWorker* worker = new ReconstructBatchWorker(wrapper_.get(), idsArr.Data(), idsArr.ElementLength(), deferred);
+        ReconstructBatchWorker* worker = new ReconstructBatchWorker(Acquire(), std::move(ids), target, deferred);
         worker->Queue();
 
         return deferred.Promise();
@@ -1302,32 +2872,14 @@ Napi::Value FaissIndexWrapperJS::RemoveIds(const Napi::CallbackInfo& info) {
         ValidateNotDisposed(env);
 
         if (info.Length() < 1) {
-            throw Napi::TypeError::New(env, "Expected 1 argument: ids (Int32Array)");
+            throw Napi::TypeError::New(env, "Expected 1 argument: ids (Int32Array or BigInt64Array)");
         }
 
-        if (!info[0].IsTypedArray()) {
-            throw Napi::TypeError::New(env, "Expected Int32Array for ids");
-        }
+        std::vector<int64_t> ids = ReadIdArray(env, info[0]);
 
-        Napi::TypedArray arr = info[0].As<Napi::TypedArray>();
-        if (arr.TypedArrayType() != napi_int32_array) {
-            throw Napi::TypeError::New(env, "Expected Int32Array for ids");
-        }
-
-        Napi::Int32Array idsArr = arr.As<Napi::Int32Array>();
-        if (idsArr.ElementLength() == 0) {
-            throw Napi::RangeError::New(env, "ids array cannot be empty");
-        }
-
-        for (size_t i = 0; i < idsArr.ElementLength(); i++) {
-            if (idsArr[i] < 0) {
-                throw Napi::RangeError::New(env, "ids must be non-negative");
-            }
-        }
-
-        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        RemoveIdsWorker* worker = new RemoveIdsWorker(wrapper_.get(), idsArr.Data(), idsArr.ElementLength(), deferred);
-        worker->Queue();
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        RemoveIdsWorker* worker = new RemoveIdsWorker(Acquire(), std::move(ids), deferred);
+        worker->Queue();
 
         return deferred.Promise();
 
@@ -1353,6 +2905,13 @@ Napi::Value FaissIndexWrapperJS::GetStats(const Napi::CallbackInfo& info) {
         stats.Set("type", Napi::String::New(env, wrapper_->GetIndexType()));
         stats.Set("factory", Napi::String::New(env, wrapper_->GetFactoryDescription()));
         stats.Set("metric", Napi::String::New(env, wrapper_->GetMetricName()));
+        stats.Set("idMap", Napi::Boolean::New(env, wrapper_->IsIdMapped()));
+        stats.Set("readOnly", Napi::Boolean::New(env, wrapper_->IsReadOnly()));
+        stats.Set("mmap", Napi::Boolean::New(env, wrapper_->IsMmapped()));
+        float kFactor = wrapper_->GetRefineKFactor();
+        stats.Set("kFactor", kFactor > 0 ? Napi::Value(Napi::Number::New(env, kFactor)) : env.Null());
+        // Threads each FAISS call uses when no per-call threads option is given
+        stats.Set("numThreads", Napi::Number::New(env, EffectiveOmpThreads()));
         
         return stats;
         
@@ -1395,6 +2954,37 @@ Napi::Value FaissIndexWrapperJS::Reset(const Napi::CallbackInfo& info) {
     }
 }
 
+Napi::Value FaissIndexWrapperJS::ResetAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ResetWorker* worker = new ResetWorker(Acquire(), deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// disposeAsync(): calls made from now on fail as disposed, while calls already
+// submitted (including coalesced searches) run to completion. The index is then
+// freed on the background lane and the promise resolves.
+Napi::Value FaissIndexWrapperJS::DisposeAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+
+    if (!wrapper_) {
+        deferred.Resolve(env.Undefined());
+        return deferred.Promise();
+    }
+
+    DisposeWorker* worker = new DisposeWorker(std::move(wrapper_), deferred);
+    // An idle coalescer releases its reference here, a busy one after its last batch
+    coalescer_.reset();
+    std::vector<std::shared_ptr<InFlightCalls>> calls = std::move(adopted_in_flight_);
+    calls.push_back(in_flight_);
+    WhenAllIdle(std::move(calls), [worker]() { worker->Queue(); });
+    return deferred.Promise();
+}
+
 Napi::Float32Array FaissIndexWrapperJS::CreateFloat32Array(Napi::Env env, size_t length, const float* data) {
     Napi::Float32Array arr = Napi::Float32Array::New(env, length);
     memcpy(arr.Data(), data, length * sizeof(float));
@@ -1430,7 +3020,7 @@ Napi::Value FaissIndexWrapperJS::Save(const Napi::CallbackInfo& info) {
         
         // Create promise and async worker
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        SaveWorker* worker = new SaveWorker(wrapper_.get(), filename, deferred);
+        SaveWorker* worker = new SaveWorker(Acquire(), filename, deferred);
         worker->Queue();
         
         return deferred.Promise();
@@ -1452,7 +3042,7 @@ Napi::Value FaissIndexWrapperJS::ToBuffer(const Napi::CallbackInfo& info) {
         
         // Create promise and async worker
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        ToBufferWorker* worker = new ToBufferWorker(wrapper_.get(), deferred);
+        ToBufferWorker* worker = new ToBufferWorker(Acquire(), deferred);
         worker->Queue();
         
         return deferred.Promise();
@@ -1476,7 +3066,8 @@ Napi::Value FaissIndexWrapperJS::MergeFrom(const Napi::CallbackInfo& info) {
             throw Napi::TypeError::New(env, "Expected 1 argument: otherIndex (FaissIndex)");
         }
         
-        if (!info[0].IsObject()) {
+        // Only plain indexes wrap a FaissIndexWrapperJS; a sharded index must not be unwrapped as one
+        if (!info[0].IsObject() || !info[0].As<Napi::Object>().InstanceOf(constructor.Value())) {
             throw Napi::TypeError::New(env, "Expected FaissIndex object");
         }
         
@@ -1494,7 +3085,7 @@ Napi::Value FaissIndexWrapperJS::MergeFrom(const Napi::CallbackInfo& info) {
         
         // Create promise and async worker
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-        MergeFromWorker* worker = new MergeFromWorker(wrapper_.get(), otherInstance->wrapper_.get(), deferred);
+        MergeFromWorker* worker = new MergeFromWorker(Acquire(), otherInstance->Acquire(), deferred);
         worker->Queue();
         
         return deferred.Promise();
@@ -1508,6 +3099,71 @@ Napi::Value FaissIndexWrapperJS::MergeFrom(const Napi::CallbackInfo& info) {
     }
 }
 
+// swap(other): this object takes over other's index and other is left disposed. The
+// previous index is released once the calls still running on it finish; nothing
+// waits for them here.
+Napi::Value FaissIndexWrapperJS::Swap(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    ValidateNotDisposed(env);
+    if (info.Length() < 1 || !info[0].IsObject() || !info[0].As<Napi::Object>().InstanceOf(constructor.Value())) {
+        throw Napi::TypeError::New(env, "Expected FaissIndex object");
+    }
+
+    FaissIndexWrapperJS* other = Napi::ObjectWrap<FaissIndexWrapperJS>::Unwrap(info[0].As<Napi::Object>());
+    if (other == this) {
+        throw Napi::Error::New(env, "Cannot swap an index with itself");
+    }
+    if (!other->wrapper_ || other->wrapper_->IsDisposed()) {
+        throw Napi::Error::New(env, "Cannot swap in a disposed index");
+    }
+    if (other->dims_ != dims_) {
+        throw Napi::RangeError::New(env,
+            "Swapped index must match index dimensions. Got " + std::to_string(other->dims_) +
+            ", expected " + std::to_string(dims_));
+    }
+
+    std::shared_ptr<FaissIndexWrapper> previous = std::move(wrapper_);
+    wrapper_ = std::move(other->wrapper_);
+    // Calls other already submitted run on wrapper_ now, so disposeAsync() must wait
+    // for them; counters adopted for the previous index are no longer relevant
+    adopted_in_flight_ = std::move(other->adopted_in_flight_);
+    adopted_in_flight_.push_back(other->in_flight_);
+    // Requests already waiting to be coalesced are searched on the index they were made on
+    if (coalescer_) {
+        coalescer_ = NewCoalescer(coalescer_->max_batch_size, coalescer_->window);
+    }
+    if (other->coalescer_) {
+        std::lock_guard<std::mutex> lock(other->coalescer_->mutex);
+        other->coalescer_->wrapper.reset();
+    }
+    other->coalescer_.reset();
+    return env.Undefined();
+}
+
+std::shared_ptr<FaissIndexWrapper> FaissIndexWrapperJS::Acquire() {
+    // The call is destroyed after the index reference, so a drained disposeAsync()
+    // holds the last one
+    struct CountedIndex {
+        CountedIndex(std::shared_ptr<InFlightCalls> calls, std::shared_ptr<FaissIndexWrapper> wrapper)
+            : call(std::move(calls)), index(std::move(wrapper)) {}
+        InFlightCall call;
+        std::shared_ptr<FaissIndexWrapper> index;
+    };
+    auto counted = std::make_shared<CountedIndex>(in_flight_, wrapper_);
+    return std::shared_ptr<FaissIndexWrapper>(counted, counted->index.get());
+}
+
+std::shared_ptr<SearchCoalescer> FaissIndexWrapperJS::NewCoalescer(size_t maxBatchSize,
+                                                                  std::chrono::microseconds window) {
+    auto coalescer = std::make_shared<SearchCoalescer>();
+    coalescer->max_batch_size = maxBatchSize;
+    coalescer->window = window;
+    // In flight for as long as the coalescer can still receive or run a batch
+    coalescer->wrapper = Acquire();
+    return coalescer;
+}
+
 Napi::Value FaissIndexWrapperJS::Load(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
@@ -1521,7 +3177,9 @@ Napi::Value FaissIndexWrapperJS::Load(const Napi::CallbackInfo& info) {
         }
         
         std::string filename = info[0].As<Napi::String>().Utf8Value();
-        auto loaded_wrapper = FaissIndexWrapper::Load(filename);
+        bool mmap = ReadBoolOption(env, info[1], "mmap", false);
+        bool readOnly = ReadBoolOption(env, info[1], "readOnly", false);
+        auto loaded_wrapper = FaissIndexWrapper::Load(filename, mmap, readOnly);
         
         // Create new JS instance with dummy config (will be replaced)
         int dims = loaded_wrapper->GetDimensions();
@@ -1601,10 +3259,928 @@ Napi::Value FaissIndexWrapperJS::GpuSupport(const Napi::CallbackInfo& info) {
     return result;
 }
 
+// ============================================================================
+// Sharded index
+// ============================================================================
+
+// In-flight calls of the sharded index wrapped by owner
+static std::shared_ptr<InFlightCalls> ShardedInFlight(const Napi::Object& owner);
+
+// Base for sharded-index workers: pins the owning JS object so the index outlives the
+// call even if the caller drops it, counts as in flight for disposeAsync(), and rejects
+// the promise on failure.
+class ShardedWorker : public LaneWorker {
+protected:
+    ShardedWorker(const Napi::Object& owner, FaissShardedIndex* index, Napi::Promise::Deferred deferred,
+                  const char* name, ExecutorLane lane)
+        : LaneWorker(deferred.Env(), name, lane),
+          index_(index),
+          deferred_(deferred),
+          owner_ref_(Napi::Persistent(owner)),
+          call_(ShardedInFlight(owner)) {}
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+    FaissShardedIndex* index_;
+    Napi::Promise::Deferred deferred_;
+
+private:
+    Napi::ObjectReference owner_ref_;
+    InFlightCall call_;
+};
+
+// ShardedAdd Worker: routes each vector to its shard and adds to all shards in parallel.
+// Without ids, the index assigns consecutive ids.
+class ShardedAddWorker : public ShardedWorker {
+public:
+    ShardedAddWorker(const Napi::Object& owner, FaissShardedIndex* index, FloatInput vectors, size_t n,
+                     std::vector<int64_t> ids, int threads, Napi::Promise::Deferred deferred)
+        : ShardedWorker(owner, index, deferred, "ShardedAddWorker", ExecutorLane::Background),
+          vectors_(std::move(vectors)),
+          n_(n),
+          ids_(std::move(ids)),
+          threads_(threads) {}
+
+    void Execute() override {
+        ScopedOmpThreads scope(threads_);
+        try {
+            vectors_.Validate("Vectors");
+            if (ids_.empty()) {
+                index_->Add(vectors_.data(), n_);
+            } else {
+                index_->AddWithIds(vectors_.data(), ids_.data(), n_);
+            }
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+
+private:
+    FloatInput vectors_;
+    size_t n_;
+    std::vector<int64_t> ids_;
+    int threads_;
+};
+
+// ShardedTrain Worker: every shard trains on the same sample, in parallel
+class ShardedTrainWorker : public ShardedWorker {
+public:
+    ShardedTrainWorker(const Napi::Object& owner, FaissShardedIndex* index, FloatInput vectors, size_t n,
+                       int threads, Napi::Promise::Deferred deferred)
+        : ShardedWorker(owner, index, deferred, "ShardedTrainWorker", ExecutorLane::Background),
+          vectors_(std::move(vectors)),
+          n_(n),
+          threads_(threads) {}
+
+    void Execute() override {
+        ScopedOmpThreads scope(threads_);
+        try {
+            vectors_.Validate("Training vectors");
+            index_->Train(vectors_.data(), n_);
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+
+private:
+    FloatInput vectors_;
+    size_t n_;
+    int threads_;
+};
+
+// ShardedSearch Worker: searches every shard in parallel and merges the top-k natively.
+// single: resolve { distances, labels } like search() rather than the batch shape.
+class ShardedSearchWorker : public ShardedWorker {
+public:
+    ShardedSearchWorker(const Napi::Object& owner, FaissShardedIndex* index, FloatInput queries, size_t nq, int k,
+                        bool single, bool bigintLabels, SearchOptions options, int threads,
+                        Napi::Promise::Deferred deferred)
+        : ShardedWorker(owner, index, deferred, "ShardedSearchWorker", ExecutorLane::Interactive),
+          queries_(std::move(queries)),
+          nq_(nq),
+          k_(k),
+          single_(single),
+          bigint_labels_(bigintLabels),
+          options_(std::move(options)),
+          threads_(threads) {}
+
+    void Execute() override {
+        ScopedOmpThreads scope(threads_);
+        try {
+            size_t ntotal = index_->GetTotalVectors();
+            if (ntotal == 0) {
+                SetError("Cannot search empty index");
+                return;
+            }
+
+            actual_k_ = (k_ > static_cast<int>(ntotal)) ? static_cast<int>(ntotal) : k_;
+            distances_.resize(nq_ * actual_k_);
+            labels_.resize(nq_ * actual_k_);
+
+            queries_.Validate(single_ ? "Query" : "Queries");
+            index_->SearchBatch(queries_.data(), nq_, actual_k_, distances_.data(), labels_.data(), &options_);
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("distances", ExternalFloat32Array(env, std::move(distances_)));
+        result.Set("labels", CreateLabelArray(env, std::move(labels_), bigint_labels_));
+        if (!single_) {
+            result.Set("nq", Napi::Number::New(env, nq_));
+            result.Set("k", Napi::Number::New(env, actual_k_));
+        }
+        deferred_.Resolve(result);
+    }
+
+private:
+    FloatInput queries_;
+    size_t nq_;
+    int k_;
+    int actual_k_ = 0;
+    bool single_;
+    bool bigint_labels_;
+    SearchOptions options_;
+    std::vector<float> distances_;
+    std::vector<int64_t> labels_;
+    int threads_;
+};
+
+// ShardedReconstruct Worker: each id is read from the shard it routes to.
+// single: resolve one vector for reconstruct(); otherwise the concatenated batch,
+// written into target when the caller supplied one.
+class ShardedReconstructWorker : public ShardedWorker {
+public:
+    ShardedReconstructWorker(const Napi::Object& owner, FaissShardedIndex* index, std::vector<int64_t> ids,
+                             bool single, Napi::Float32Array target, Napi::Promise::Deferred deferred)
+        : ShardedWorker(owner, index, deferred, "ShardedReconstructWorker", ExecutorLane::Interactive),
+          ids_(std::move(ids)),
+          single_(single) {
+        if (!target.IsEmpty()) {
+            target_ = target.Data();
+            target_ref_ = Napi::Persistent(static_cast<const Napi::Object&>(target));
+        }
+    }
+
+    void Execute() override {
+        ScopedOmpThreads scope;
+        try {
+            float* output = target_;
+            if (output == nullptr) {
+                output_.resize(ids_.size() * static_cast<size_t>(index_->GetDimensions()));
+                output = output_.data();
+            }
+            if (single_) {
+                index_->Reconstruct(ids_[0], output);
+            } else {
+                index_->ReconstructBatch(ids_.data(), ids_.size(), output);
+            }
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        if (target_ != nullptr) {
+            deferred_.Resolve(target_ref_.Value());
+            return;
+        }
+        deferred_.Resolve(ExternalFloat32Array(Env(), std::move(output_)));
+    }
+
+private:
+    std::vector<int64_t> ids_;
+    bool single_;
+    std::vector<float> output_;
+    float* target_ = nullptr;
+    Napi::ObjectReference target_ref_;
+};
+
+// ShardedRemoveIds Worker
+class ShardedRemoveIdsWorker : public ShardedWorker {
+public:
+    ShardedRemoveIdsWorker(const Napi::Object& owner, FaissShardedIndex* index, std::vector<int64_t> ids,
+                           Napi::Promise::Deferred deferred)
+        : ShardedWorker(owner, index, deferred, "ShardedRemoveIdsWorker", ExecutorLane::Background),
+          ids_(std::move(ids)) {}
+
+    void Execute() override {
+        ScopedOmpThreads scope;
+        try {
+            removed_ = index_->RemoveIds(ids_.data(), ids_.size());
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Napi::Number::New(Env(), removed_));
+    }
+
+private:
+    std::vector<int64_t> ids_;
+    size_t removed_ = 0;
+};
+
+// ShardedSave Worker: writes the whole shard set to one file
+class ShardedSaveWorker : public ShardedWorker {
+public:
+    ShardedSaveWorker(const Napi::Object& owner, FaissShardedIndex* index, std::string filename,
+                      Napi::Promise::Deferred deferred)
+        : ShardedWorker(owner, index, deferred, "ShardedSaveWorker", ExecutorLane::Background),
+          filename_(std::move(filename)) {}
+
+    void Execute() override {
+        try {
+            index_->Save(filename_);
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+
+private:
+    std::string filename_;
+};
+
+// ShardedToBuffer Worker: the whole shard set, or one shard (shard >= 0) in the
+// single-index format
+class ShardedToBufferWorker : public ShardedWorker {
+public:
+    ShardedToBufferWorker(const Napi::Object& owner, FaissShardedIndex* index, int64_t shard,
+                          Napi::Promise::Deferred deferred)
+        : ShardedWorker(owner, index, deferred, "ShardedToBufferWorker", ExecutorLane::Background),
+          shard_(shard) {}
+
+    void Execute() override {
+        try {
+            buffer_ = shard_ < 0 ? index_->ToBuffer() : index_->ShardToBuffer(static_cast<size_t>(shard_));
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(ExternalBuffer(Env(), std::move(buffer_)));
+    }
+
+private:
+    int64_t shard_;
+    std::vector<uint8_t> buffer_;
+};
+
+// ShardedReplace Worker: deserializes a rebuilt shard off the JS thread, reading the
+// pinned caller buffer in place, then swaps it in
+class ShardedReplaceWorker : public ShardedWorker {
+public:
+    ShardedReplaceWorker(const Napi::Object& owner, FaissShardedIndex* index, size_t shard,
+                         Napi::Buffer<uint8_t> buffer, Napi::Promise::Deferred deferred)
+        : ShardedWorker(owner, index, deferred, "ShardedReplaceWorker", ExecutorLane::Background),
+          shard_(shard),
+          data_(buffer.Data()),
+          length_(buffer.Length()),
+          buffer_ref_(Napi::Persistent(static_cast<const Napi::Object&>(buffer))) {}
+
+    void Execute() override {
+        try {
+            index_->ReplaceShard(shard_, FaissIndexWrapper::FromBuffer(data_, length_));
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+
+private:
+    size_t shard_;
+    const uint8_t* data_;
+    size_t length_;
+    Napi::ObjectReference buffer_ref_;
+};
+
+// Reads a non-empty Float32Array holding a whole number of dims-sized vectors.
+static Napi::Float32Array ReadVectorArray(Napi::Env env, const Napi::Value& value, const char* name, int dims) {
+    if (!value.IsTypedArray() || value.As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+        throw Napi::TypeError::New(env, std::string("Expected Float32Array for ") + name);
+    }
+    Napi::Float32Array array = value.As<Napi::Float32Array>();
+    if (array.ElementLength() == 0) {
+        throw Napi::RangeError::New(env, std::string(name) + " cannot be empty");
+    }
+    if (array.ElementLength() % static_cast<size_t>(dims) != 0) {
+        throw Napi::RangeError::New(env,
+            std::string(name) + " length must be a multiple of dimensions. Got " +
+            std::to_string(array.ElementLength()) + ", expected multiple of " + std::to_string(dims));
+    }
+    return array;
+}
+
+// Reads { replicas }: copies kept of each shard, 1 when omitted.
+static size_t ReadReplicasOption(Napi::Env env, const Napi::Value& options) {
+    if (!options.IsObject()) {
+        return 1;
+    }
+    Napi::Value value = options.As<Napi::Object>().Get("replicas");
+    if (value.IsUndefined()) {
+        return 1;
+    }
+    if (!value.IsNumber()) {
+        throw Napi::TypeError::New(env, "Expected number for replicas");
+    }
+    const double replicas = value.As<Napi::Number>().DoubleValue();
+    if (replicas < 1 || replicas > 256 || replicas != static_cast<int>(replicas)) {
+        throw Napi::RangeError::New(env, "replicas must be an integer between 1 and 256");
+    }
+    return static_cast<size_t>(replicas);
+}
+
+// ShardedReset Worker: clears every shard off the JS thread
+class ShardedResetWorker : public ShardedWorker {
+public:
+    ShardedResetWorker(const Napi::Object& owner, FaissShardedIndex* index, Napi::Promise::Deferred deferred)
+        : ShardedWorker(owner, index, deferred, "ShardedResetWorker", ExecutorLane::Background) {}
+
+    void Execute() override {
+        try {
+            index_->Reset();
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+};
+
+// ShardedDispose Worker: frees the shards on the background lane. Not a ShardedWorker,
+// since it is queued only once every counted call has completed.
+class ShardedDisposeWorker : public LaneWorker {
+public:
+    ShardedDisposeWorker(const Napi::Object& owner, FaissShardedIndex* index, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "ShardedDisposeWorker", ExecutorLane::Background),
+          index_(index),
+          deferred_(deferred),
+          owner_ref_(Napi::Persistent(owner)) {}
+
+    void Execute() override {
+        try {
+            index_->Dispose();
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    FaissShardedIndex* index_;
+    Napi::Promise::Deferred deferred_;
+    Napi::ObjectReference owner_ref_;
+};
+
+class FaissShardedIndexJS : public Napi::ObjectWrap<FaissShardedIndexJS> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    FaissShardedIndexJS(const Napi::CallbackInfo& info);
+    ~FaissShardedIndexJS();
+
+    std::shared_ptr<InFlightCalls> InFlight() const {
+        return in_flight_;
+    }
+
+private:
+    static Napi::FunctionReference constructor;
+    std::unique_ptr<FaissShardedIndex> index_;
+    std::shared_ptr<InFlightCalls> in_flight_ = std::make_shared<InFlightCalls>();
+    bool closing_ = false;  // disposeAsync() is waiting for in-flight calls
+    int dims_ = 0;
+
+    Napi::Value Add(const Napi::CallbackInfo& info);
+    Napi::Value AddWithIds(const Napi::CallbackInfo& info);
+    Napi::Value Train(const Napi::CallbackInfo& info);
+    Napi::Value Search(const Napi::CallbackInfo& info);
+    Napi::Value SearchBatch(const Napi::CallbackInfo& info);
+    Napi::Value Reconstruct(const Napi::CallbackInfo& info);
+    Napi::Value ReconstructBatch(const Napi::CallbackInfo& info);
+    Napi::Value RemoveIds(const Napi::CallbackInfo& info);
+    Napi::Value SetNprobe(const Napi::CallbackInfo& info);
+    Napi::Value Reset(const Napi::CallbackInfo& info);
+    Napi::Value ResetAsync(const Napi::CallbackInfo& info);
+    Napi::Value GetStats(const Napi::CallbackInfo& info);
+    Napi::Value Dispose(const Napi::CallbackInfo& info);
+    Napi::Value DisposeAsync(const Napi::CallbackInfo& info);
+    Napi::Value Save(const Napi::CallbackInfo& info);
+    Napi::Value ToBuffer(const Napi::CallbackInfo& info);
+    Napi::Value ShardToBuffer(const Napi::CallbackInfo& info);
+    Napi::Value ReplaceShard(const Napi::CallbackInfo& info);
+
+    static Napi::Value Load(const Napi::CallbackInfo& info);
+    static Napi::Value FromBuffer(const Napi::CallbackInfo& info);
+    static Napi::Object Wrap(Napi::Env env, std::unique_ptr<FaissShardedIndex> index);
+
+    void ValidateNotDisposed(Napi::Env env) const;
+    Napi::Value Search(const Napi::CallbackInfo& info, bool single);
+    Napi::Value Add(const Napi::CallbackInfo& info, bool withIds);
+    size_t ReadShardArgument(Napi::Env env, const Napi::Value& value) const;
+};
+
+Napi::FunctionReference FaissShardedIndexJS::constructor;
+
+static std::shared_ptr<InFlightCalls> ShardedInFlight(const Napi::Object& owner) {
+    return Napi::ObjectWrap<FaissShardedIndexJS>::Unwrap(owner)->InFlight();
+}
+
+Napi::Object FaissShardedIndexJS::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "FaissShardedIndexWrapper", {
+        InstanceMethod("add", &FaissShardedIndexJS::Add),
+        InstanceMethod("addWithIds", &FaissShardedIndexJS::AddWithIds),
+        InstanceMethod("train", &FaissShardedIndexJS::Train),
+        InstanceMethod("search", &FaissShardedIndexJS::Search),
+        InstanceMethod("searchBatch", &FaissShardedIndexJS::SearchBatch),
+        InstanceMethod("reconstruct", &FaissShardedIndexJS::Reconstruct),
+        InstanceMethod("reconstructBatch", &FaissShardedIndexJS::ReconstructBatch),
+        InstanceMethod("removeIds", &FaissShardedIndexJS::RemoveIds),
+        InstanceMethod("setNprobe", &FaissShardedIndexJS::SetNprobe),
+        InstanceMethod("reset", &FaissShardedIndexJS::Reset),
+        InstanceMethod("resetAsync", &FaissShardedIndexJS::ResetAsync),
+        InstanceMethod("getStats", &FaissShardedIndexJS::GetStats),
+        InstanceMethod("dispose", &FaissShardedIndexJS::Dispose),
+        InstanceMethod("disposeAsync", &FaissShardedIndexJS::DisposeAsync),
+        InstanceMethod("save", &FaissShardedIndexJS::Save),
+        InstanceMethod("toBuffer", &FaissShardedIndexJS::ToBuffer),
+        InstanceMethod("shardToBuffer", &FaissShardedIndexJS::ShardToBuffer),
+        InstanceMethod("replaceShard", &FaissShardedIndexJS::ReplaceShard),
+        StaticMethod("load", &FaissShardedIndexJS::Load),
+        StaticMethod("fromBuffer", &FaissShardedIndexJS::FromBuffer),
+    });
+
+    constructor = Napi::Persistent(func);
+    constructor.SuppressDestruct();
+
+    exports.Set("FaissShardedIndexWrapper", func);
+    return exports;
+}
+
+// Config: any FaissIndexWrapper config plus { shards, replicas? }. Every shard is built
+// from the same config and is id-mapped. load/fromBuffer pass { dims, shards: 0 } and install
+// the loaded index themselves.
+FaissShardedIndexJS::FaissShardedIndexJS(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<FaissShardedIndexJS>(info) {
+    Napi::Env env = info.Env();
+
+    try {
+        if (info.Length() < 1 || !info[0].IsObject()) {
+            throw Napi::TypeError::New(env, "Expected config object with 'dims' and 'shards'");
+        }
+
+        Napi::Object config = info[0].As<Napi::Object>();
+        Napi::Value shardsValue = config.Get("shards");
+        if (!shardsValue.IsNumber()) {
+            throw Napi::TypeError::New(env, "Expected number for shards");
+        }
+        const double count = shardsValue.As<Napi::Number>().DoubleValue();
+        if (count < 0 || count > 1024 || count != static_cast<int>(count)) {
+            throw Napi::RangeError::New(env, "shards must be an integer between 1 and 1024");
+        }
+        if (count == 0) {
+            return;
+        }
+
+        size_t replicas = ReadReplicasOption(env, config);
+        std::vector<std::unique_ptr<FaissIndexWrapper>> shards;
+        for (int i = 0; i < static_cast<int>(count); i++) {
+            shards.push_back(CreateWrapperFromConfig(env, config, true));
+        }
+        index_ = std::make_unique<FaissShardedIndex>(std::move(shards), 0, replicas);
+        dims_ = index_->GetDimensions();
+
+    } catch (const Napi::Error& e) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    } catch (...) {
+        throw Napi::Error::New(env, "Unknown error creating sharded index");
+    }
+}
+
+FaissShardedIndexJS::~FaissShardedIndexJS() {
+    if (index_) {
+        index_->Dispose();
+    }
+}
+
+void FaissShardedIndexJS::ValidateNotDisposed(Napi::Env env) const {
+    if (!index_ || closing_ || index_->IsDisposed()) {
+        throw Napi::Error::New(env, "Index has been disposed");
+    }
+}
+
+Napi::Value FaissShardedIndexJS::Add(const Napi::CallbackInfo& info) {
+    return Add(info, false);
+}
+
+Napi::Value FaissShardedIndexJS::AddWithIds(const Napi::CallbackInfo& info) {
+    return Add(info, true);
+}
+
+// add(vectors, options?) or addWithIds(vectors, ids, options?)
+Napi::Value FaissShardedIndexJS::Add(const Napi::CallbackInfo& info, bool withIds) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    Napi::Float32Array vectors = ReadVectorArray(env, info[0], "vectors", dims_);
+    const size_t n = vectors.ElementLength() / static_cast<size_t>(dims_);
+
+    std::vector<int64_t> ids;
+    if (withIds) {
+        ids = ReadIdArray(env, info[1]);
+        if (ids.size() != n) {
+            throw Napi::RangeError::New(env,
+                "ids length must match the number of vectors. Got " + std::to_string(ids.size()) +
+                ", expected " + std::to_string(n));
+        }
+    }
+
+    const Napi::Value options = info[withIds ? 2 : 1];
+    bool borrow = ReadBoolOption(env, options, "borrow", false);
+    bool validate = ReadBoolOption(env, options, "validate", false);
+    int threads = ReadThreadsOption(env, options);
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedAddWorker* worker = new ShardedAddWorker(
+        info.This().As<Napi::Object>(), index_.get(), FloatInput(vectors, borrow, validate), n, std::move(ids),
+        threads, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value FaissShardedIndexJS::Train(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    Napi::Float32Array vectors = ReadVectorArray(env, info[0], "Training vectors", dims_);
+    const size_t n = vectors.ElementLength() / static_cast<size_t>(dims_);
+    bool borrow = ReadBoolOption(env, info[1], "borrow", false);
+    bool validate = ReadBoolOption(env, info[1], "validate", false);
+    int threads = ReadThreadsOption(env, info[1]);
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedTrainWorker* worker = new ShardedTrainWorker(
+        info.This().As<Napi::Object>(), index_.get(), FloatInput(vectors, borrow, validate), n, threads, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value FaissShardedIndexJS::Search(const Napi::CallbackInfo& info) {
+    return Search(info, true);
+}
+
+Napi::Value FaissShardedIndexJS::SearchBatch(const Napi::CallbackInfo& info) {
+    return Search(info, false);
+}
+
+// search(query, k, options?) / searchBatch(queries, k, options?)
+Napi::Value FaissShardedIndexJS::Search(const Napi::CallbackInfo& info, bool single) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    Napi::Float32Array queries = ReadVectorArray(env, info[0], single ? "Query" : "Queries", dims_);
+    const size_t nq = queries.ElementLength() / static_cast<size_t>(dims_);
+    if (single && nq != 1) {
+        throw Napi::RangeError::New(env,
+            "Query vector length must match index dimensions. Got " +
+            std::to_string(queries.ElementLength()) + ", expected " + std::to_string(dims_));
+    }
+
+    if (!info[1].IsNumber()) {
+        throw Napi::TypeError::New(env, "Expected number for k");
+    }
+    int k = info[1].As<Napi::Number>().Int32Value();
+    if (k <= 0) {
+        throw Napi::RangeError::New(env, "k must be positive");
+    }
+
+    // Shards are id-mapped, so labels default to bigint like any idMap index
+    bool bigintLabels = ReadBigIntLabels(env, info[2], true);
+    SearchOptions searchOptions = ReadSearchOptions(env, info[2]);
+    bool borrow = ReadBoolOption(env, info[2], "borrow", false);
+    bool validate = ReadBoolOption(env, info[2], "validate", false);
+    int threads = ReadThreadsOption(env, info[2]);
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedSearchWorker* worker = new ShardedSearchWorker(
+        info.This().As<Napi::Object>(), index_.get(), FloatInput(queries, borrow, validate), nq, k, single,
+        bigintLabels, std::move(searchOptions), threads, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value FaissShardedIndexJS::Reconstruct(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    int64_t id = 0;
+    if (info[0].IsBigInt()) {
+        bool lossless = true;
+        id = info[0].As<Napi::BigInt>().Int64Value(&lossless);
+        if (!lossless) {
+            throw Napi::RangeError::New(env, "id must fit in a signed 64-bit integer");
+        }
+    } else if (info[0].IsNumber()) {
+        id = info[0].As<Napi::Number>().Int64Value();
+    } else {
+        throw Napi::TypeError::New(env, "Expected number or bigint for id");
+    }
+    if (id < 0) {
+        throw Napi::RangeError::New(env, "id must be non-negative");
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedReconstructWorker* worker = new ShardedReconstructWorker(
+        info.This().As<Napi::Object>(), index_.get(), std::vector<int64_t>{id}, true, Napi::Float32Array(), deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value FaissShardedIndexJS::ReconstructBatch(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    std::vector<int64_t> ids = ReadIdArray(env, info[0]);
+    Napi::Float32Array target;
+    if (!info[1].IsUndefined() && !info[1].IsNull()) {
+        if (!info[1].IsTypedArray() || info[1].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+            throw Napi::TypeError::New(env, "Expected Float32Array for output");
+        }
+        target = info[1].As<Napi::Float32Array>();
+        if (target.ElementLength() < ids.size() * static_cast<size_t>(dims_)) {
+            throw Napi::RangeError::New(env,
+                "output must hold at least " + std::to_string(ids.size() * static_cast<size_t>(dims_)) + " floats");
+        }
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedReconstructWorker* worker = new ShardedReconstructWorker(
+        info.This().As<Napi::Object>(), index_.get(), std::move(ids), false, target, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value FaissShardedIndexJS::RemoveIds(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    std::vector<int64_t> ids = ReadIdArray(env, info[0]);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedRemoveIdsWorker* worker = new ShardedRemoveIdsWorker(
+        info.This().As<Napi::Object>(), index_.get(), std::move(ids), deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value FaissShardedIndexJS::SetNprobe(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    if (!info[0].IsNumber()) {
+        throw Napi::TypeError::New(env, "Expected number for nprobe");
+    }
+    int nprobe = info[0].As<Napi::Number>().Int32Value();
+    if (nprobe <= 0) {
+        throw Napi::RangeError::New(env, "nprobe must be positive");
+    }
+
+    try {
+        index_->SetNprobe(nprobe);
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    }
+    return env.Undefined();
+}
+
+Napi::Value FaissShardedIndexJS::Reset(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    try {
+        index_->Reset();
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    }
+    return env.Undefined();
+}
+
+Napi::Value FaissShardedIndexJS::GetStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    try {
+        const std::vector<size_t> sizes = index_->GetShardSizes();
+        Napi::Array shardSizes = Napi::Array::New(env, sizes.size());
+        size_t ntotal = 0;
+        for (size_t i = 0; i < sizes.size(); i++) {
+            shardSizes.Set(static_cast<uint32_t>(i), Napi::Number::New(env, static_cast<double>(sizes[i])));
+            ntotal += sizes[i];
+        }
+
+        Napi::Object stats = Napi::Object::New(env);
+        stats.Set("ntotal", Napi::Number::New(env, static_cast<double>(ntotal)));
+        stats.Set("dims", Napi::Number::New(env, dims_));
+        stats.Set("isTrained", Napi::Boolean::New(env, index_->IsTrained()));
+        stats.Set("type", Napi::String::New(env, index_->GetIndexType()));
+        stats.Set("factory", Napi::String::New(env, index_->GetFactoryDescription()));
+        stats.Set("metric", Napi::String::New(env, index_->GetMetricName()));
+        stats.Set("idMap", Napi::Boolean::New(env, true));
+        stats.Set("readOnly", Napi::Boolean::New(env, false));
+        stats.Set("mmap", Napi::Boolean::New(env, false));
+        float kFactor = index_->GetRefineKFactor();
+        stats.Set("kFactor", kFactor > 0 ? Napi::Value(Napi::Number::New(env, kFactor)) : env.Null());
+        stats.Set("numThreads", Napi::Number::New(env, EffectiveOmpThreads()));
+        stats.Set("shards", Napi::Number::New(env, static_cast<double>(sizes.size())));
+        stats.Set("shardSizes", shardSizes);
+        stats.Set("replicas", Napi::Number::New(env, static_cast<double>(index_->ReplicaCount())));
+        stats.Set("nextId", Napi::Number::New(env, static_cast<double>(index_->NextId())));
+        return stats;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    }
+}
+
+Napi::Value FaissShardedIndexJS::ResetAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedResetWorker* worker = new ShardedResetWorker(info.This().As<Napi::Object>(), index_.get(), deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value FaissShardedIndexJS::Dispose(const Napi::CallbackInfo& info) {
+    if (index_) {
+        index_->Dispose();
+    }
+    return info.Env().Undefined();
+}
+
+// Same contract as FaissIndexWrapper.disposeAsync(): later calls fail, earlier ones finish
+Napi::Value FaissShardedIndexJS::DisposeAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+
+    if (!index_ || closing_ || index_->IsDisposed()) {
+        deferred.Resolve(env.Undefined());
+        return deferred.Promise();
+    }
+
+    closing_ = true;
+    ShardedDisposeWorker* worker = new ShardedDisposeWorker(info.This().As<Napi::Object>(), index_.get(), deferred);
+    in_flight_->WhenIdle([worker]() { worker->Queue(); });
+    return deferred.Promise();
+}
+
+Napi::Value FaissShardedIndexJS::Save(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    if (!info[0].IsString()) {
+        throw Napi::TypeError::New(env, "Expected string for filename");
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedSaveWorker* worker = new ShardedSaveWorker(
+        info.This().As<Napi::Object>(), index_.get(), info[0].As<Napi::String>().Utf8Value(), deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value FaissShardedIndexJS::ToBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedToBufferWorker* worker = new ShardedToBufferWorker(info.This().As<Napi::Object>(), index_.get(), -1, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+size_t FaissShardedIndexJS::ReadShardArgument(Napi::Env env, const Napi::Value& value) const {
+    if (!value.IsNumber()) {
+        throw Napi::TypeError::New(env, "Expected number for shard");
+    }
+    const double shard = value.As<Napi::Number>().DoubleValue();
+    if (shard < 0 || shard >= static_cast<double>(index_->ShardCount()) || shard != static_cast<int64_t>(shard)) {
+        throw Napi::RangeError::New(env, "shard must be an integer below " + std::to_string(index_->ShardCount()));
+    }
+    return static_cast<size_t>(shard);
+}
+
+// shardToBuffer(shard): one shard in the single-index format, loadable with FaissIndex.fromBuffer
+Napi::Value FaissShardedIndexJS::ShardToBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    size_t shard = ReadShardArgument(env, info[0]);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedToBufferWorker* worker = new ShardedToBufferWorker(
+        info.This().As<Napi::Object>(), index_.get(), static_cast<int64_t>(shard), deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// replaceShard(shard, buffer): swaps in a shard rebuilt elsewhere; searches keep running
+Napi::Value FaissShardedIndexJS::ReplaceShard(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ValidateNotDisposed(env);
+
+    size_t shard = ReadShardArgument(env, info[0]);
+    if (!info[1].IsBuffer()) {
+        throw Napi::TypeError::New(env, "Expected Buffer");
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ShardedReplaceWorker* worker = new ShardedReplaceWorker(
+        info.This().As<Napi::Object>(), index_.get(), shard, info[1].As<Napi::Buffer<uint8_t>>(), deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Object FaissShardedIndexJS::Wrap(Napi::Env env, std::unique_ptr<FaissShardedIndex> index) {
+    Napi::Object config = Napi::Object::New(env);
+    config.Set("dims", Napi::Number::New(env, index->GetDimensions()));
+    config.Set("shards", Napi::Number::New(env, 0));
+    Napi::Object obj = constructor.New({config});
+    FaissShardedIndexJS* instance = Napi::ObjectWrap<FaissShardedIndexJS>::Unwrap(obj);
+    instance->dims_ = index->GetDimensions();
+    instance->index_ = std::move(index);
+    return obj;
+}
+
+Napi::Value FaissShardedIndexJS::Load(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!info[0].IsString()) {
+        throw Napi::TypeError::New(env, "Expected string for filename");
+    }
+
+    try {
+        size_t replicas = ReadReplicasOption(env, info[1]);
+        return Wrap(env, FaissShardedIndex::Load(info[0].As<Napi::String>().Utf8Value(), replicas));
+    } catch (const Napi::Error& e) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    }
+}
+
+Napi::Value FaissShardedIndexJS::FromBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!info[0].IsBuffer()) {
+        throw Napi::TypeError::New(env, "Expected Buffer");
+    }
+
+    try {
+        Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
+        size_t replicas = ReadReplicasOption(env, info[1]);
+        return Wrap(env, FaissShardedIndex::FromBuffer(buffer.Data(), buffer.Length(), replicas));
+    } catch (const Napi::Error& e) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("FAISS error: ") + e.what());
+    }
+}
+
 // Module initialization
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
     FaissIndexWrapperJS::Init(env, exports);
+    FaissShardedIndexJS::Init(env, exports);
+    IngestPipelineJS::Init(env);
     InitFaissBinaryIndexWrapper(env, exports);
+    InitVectorUtilities(env, exports);
     return exports;
 }
 
@@ -0,0 +1,116 @@
+#ifndef FAISS_NODE_NAPI_EXECUTOR_H
+#define FAISS_NODE_NAPI_EXECUTOR_H
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <napi.h>
+
+#include "executor.h"
+
+/**
+ * Drop-in replacement for Napi::AsyncWorker that runs Execute() on an Executor lane
+ * instead of the libuv pool. The result comes back through a ThreadSafeFunction,
+ * so OnOK/OnError (and the destructor, which releases any pinned arrays) run on the
+ * JS thread just as they do for AsyncWorker. Like AsyncWorker, the worker deletes
+ * itself after completion; allocate it with new and call Queue() once.
+ */
+class LaneWorker {
+public:
+    virtual ~LaneWorker() = default;
+
+    LaneWorker(const LaneWorker&) = delete;
+    LaneWorker& operator=(const LaneWorker&) = delete;
+
+    void Queue() {
+        // The function keeps the event loop alive until the call completes.
+        tsfn_ = Napi::ThreadSafeFunction::New(
+            env_, Napi::Function::New(env_, Noop), name_, 0, 1);
+        Executor::Instance().Submit(lane_, [this] { Run(); }, [this] { Deliver(); });
+    }
+
+protected:
+    LaneWorker(Napi::Env env, const char* name, ExecutorLane lane)
+        : env_(env), name_(name), lane_(lane) {}
+
+    Napi::Env Env() const {
+        return env_;
+    }
+
+    void SetError(const std::string& error) {
+        error_ = error;
+        failed_ = true;
+    }
+
+    // Queues fn to run on the JS thread, e.g. to report progress. Calls are delivered
+    // in order and before OnOK/OnError; fn gets a null env if the environment shuts
+    // down first. Returns false, without calling fn, if the call was refused. Only
+    // call from Execute().
+    bool RunOnJsThread(std::function<void(Napi::Env)> fn) {
+        auto* call = new std::function<void(Napi::Env)>(std::move(fn));
+        if (tsfn_.BlockingCall(call, CallOnJsThread) != napi_ok) {
+            delete call;
+            return false;
+        }
+        return true;
+    }
+
+    virtual void Execute() = 0;
+    virtual void OnOK() {}
+    virtual void OnError(const Napi::Error&) {}
+
+private:
+    void Run() {
+        try {
+            Execute();
+        } catch (const std::exception& e) {
+            SetError(e.what());
+        } catch (...) {
+            SetError("Unknown native error");
+        }
+    }
+
+    // Runs after the executor has counted the task, so a settled promise is always
+    // reflected in getExecutorStats()
+    void Deliver() {
+        Napi::ThreadSafeFunction tsfn = tsfn_;
+        // If the environment is already shutting down the call is refused and the
+        // worker is leaked: its references may only be released on the JS thread.
+        tsfn.BlockingCall(this, Complete);
+        tsfn.Release();
+    }
+
+    static void Noop(const Napi::CallbackInfo&) {}
+
+    static void CallOnJsThread(Napi::Env env, Napi::Function, std::function<void(Napi::Env)>* call) {
+        std::unique_ptr<std::function<void(Napi::Env)>> owned(call);
+        (*owned)(env);
+    }
+
+    static void Complete(Napi::Env env, Napi::Function, LaneWorker* worker) {
+        if (env == nullptr) {
+            return;
+        }
+        std::unique_ptr<LaneWorker> owned(worker);
+        try {
+            if (owned->failed_) {
+                owned->OnError(Napi::Error::New(env, owned->error_));
+            } else {
+                owned->OnOK();
+            }
+        } catch (const Napi::Error& e) {
+            e.ThrowAsJavaScriptException();
+        }
+    }
+
+    Napi::Env env_;
+    const char* name_;
+    ExecutorLane lane_;
+    Napi::ThreadSafeFunction tsfn_;
+    std::string error_;
+    bool failed_ = false;
+};
+
+#endif // FAISS_NODE_NAPI_EXECUTOR_H
@@ -0,0 +1,123 @@
+#ifndef FAISS_NODE_NAPI_EXTERNAL_H
+#define FAISS_NODE_NAPI_EXTERNAL_H
+
+#include <napi.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Hands a worker-owned vector to JS without copying: the ArrayBuffer points at the
+// vector's storage and its finalizer frees the vector once the buffer is collected.
+// Runtimes that forbid external buffers (e.g. Electron's V8 sandbox) get a copy.
+template <typename T>
+inline Napi::ArrayBuffer ExternalArrayBuffer(Napi::Env env, std::vector<T>&& data) {
+    size_t byteLength = data.size() * sizeof(T);
+    if (byteLength == 0) {
+        return Napi::ArrayBuffer::New(env, 0);
+    }
+
+    auto* owned = new std::vector<T>(std::move(data));
+    try {
+        return Napi::ArrayBuffer::New(
+            env,
+            owned->data(),
+            byteLength,
+            [](Napi::Env, void*, std::vector<T>* hint) { delete hint; },
+            owned);
+    } catch (const Napi::Error&) {
+        Napi::ArrayBuffer copy = Napi::ArrayBuffer::New(env, byteLength);
+        memcpy(copy.Data(), owned->data(), byteLength);
+        delete owned;
+        return copy;
+    }
+}
+
+// Array-owning variant for buffers allocated with new[] (e.g. taken from a FAISS result).
+template <typename T>
+inline Napi::ArrayBuffer ExternalArrayBuffer(Napi::Env env, std::unique_ptr<T[]>&& data, size_t length) {
+    size_t byteLength = length * sizeof(T);
+    if (byteLength == 0 || !data) {
+        return Napi::ArrayBuffer::New(env, 0);
+    }
+
+    T* owned = data.release();
+    try {
+        return Napi::ArrayBuffer::New(
+            env,
+            owned,
+            byteLength,
+            [](Napi::Env, void* buffer) { delete[] static_cast<T*>(buffer); });
+    } catch (const Napi::Error&) {
+        Napi::ArrayBuffer copy = Napi::ArrayBuffer::New(env, byteLength);
+        memcpy(copy.Data(), owned, byteLength);
+        delete[] owned;
+        return copy;
+    }
+}
+
+// Same ownership transfer for serialized indexes returned as a Node.js Buffer.
+inline Napi::Buffer<uint8_t> ExternalBuffer(Napi::Env env, std::vector<uint8_t>&& data) {
+    if (data.empty()) {
+        return Napi::Buffer<uint8_t>::New(env, 0);
+    }
+
+    auto* owned = new std::vector<uint8_t>(std::move(data));
+    try {
+        return Napi::Buffer<uint8_t>::New(
+            env,
+            owned->data(),
+            owned->size(),
+            [](Napi::Env, uint8_t*, std::vector<uint8_t>* hint) { delete hint; },
+            owned);
+    } catch (const Napi::Error&) {
+        Napi::Buffer<uint8_t> copy = Napi::Buffer<uint8_t>::Copy(env, owned->data(), owned->size());
+        delete owned;
+        return copy;
+    }
+}
+
+inline Napi::Float32Array ExternalFloat32Array(Napi::Env env, std::vector<float>&& data) {
+    size_t length = data.size();
+    return Napi::Float32Array::New(env, length, ExternalArrayBuffer(env, std::move(data)), 0);
+}
+
+// Search labels: Int32Array by default, BigInt64Array for labelType 'bigint' (the default
+// for id-mapped indexes, whose caller-supplied ids may not fit in 32 bits).
+inline Napi::TypedArray CreateLabelArray(Napi::Env env, const int64_t* data, size_t length, bool bigint) {
+    if (bigint) {
+        Napi::BigInt64Array labels = Napi::BigInt64Array::New(env, length);
+        if (length > 0) {
+            memcpy(labels.Data(), data, length * sizeof(int64_t));
+        }
+        return labels;
+    }
+
+    Napi::Int32Array labels = Napi::Int32Array::New(env, length);
+    int32_t* labelsData = labels.Data();
+    for (size_t i = 0; i < length; i++) {
+        labelsData[i] = static_cast<int32_t>(data[i]);
+    }
+    return labels;
+}
+
+// BigInt64Array labels take ownership of the worker's idx_t storage, skipping the narrowing pass.
+inline Napi::TypedArray CreateLabelArray(Napi::Env env, std::vector<int64_t>&& labels, bool bigint) {
+    if (!bigint) {
+        return CreateLabelArray(env, labels.data(), labels.size(), false);
+    }
+
+    size_t length = labels.size();
+    return Napi::BigInt64Array::New(env, length, ExternalArrayBuffer(env, std::move(labels)), 0);
+}
+
+inline Napi::TypedArray CreateLabelArray(Napi::Env env, std::unique_ptr<int64_t[]>&& labels, size_t length, bool bigint) {
+    if (!bigint) {
+        return CreateLabelArray(env, labels.get(), length, false);
+    }
+
+    return Napi::BigInt64Array::New(env, length, ExternalArrayBuffer(env, std::move(labels), length), 0);
+}
+
+#endif // FAISS_NODE_NAPI_EXTERNAL_H
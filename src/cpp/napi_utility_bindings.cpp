@@ -0,0 +1,514 @@
+#include <napi.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "distance_kernels.h"
+#include "napi_executor.h"
+#include "napi_external.h"
+#include "napi_utility_bindings.h"
+#include "thread_control.h"
+#include "vector_kernels.h"
+
+// The validation kernels run synchronously on the calling thread: they are memory-bound
+// single passes, cheaper than the cost of scheduling a worker for them. Distance
+// computations are O(n * m * d) and run on workers.
+
+static Napi::Float32Array ReadFloat32Array(Napi::Env env, const Napi::Value& value, const char* name) {
+    if (!value.IsTypedArray() || value.As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+        throw Napi::TypeError::New(env, std::string("Expected Float32Array for ") + name);
+    }
+    return value.As<Napi::Float32Array>();
+}
+
+static size_t ReadDimensions(Napi::Env env, const Napi::Value& value, size_t length) {
+    if (!value.IsNumber()) {
+        throw Napi::TypeError::New(env, "Expected number for dims");
+    }
+    const int64_t dims = value.As<Napi::Number>().Int64Value();
+    if (dims <= 0) {
+        throw Napi::RangeError::New(env, "dims must be a positive integer");
+    }
+    if (length % static_cast<size_t>(dims) != 0) {
+        throw Napi::RangeError::New(
+            env, "Vector length must be a multiple of dims (" + std::to_string(dims) + ")");
+    }
+    return static_cast<size_t>(dims);
+}
+
+// findNonFinite(vectors) -> index of the first NaN/Infinity, or -1
+static Napi::Value FindNonFiniteJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Float32Array vectors = ReadFloat32Array(env, info[0], "vectors");
+    const size_t length = vectors.ElementLength();
+    const size_t found = FindNonFinite(vectors.Data(), length);
+    return Napi::Number::New(env, found == length ? -1.0 : static_cast<double>(found));
+}
+
+// scanVectors(vectors, dims) -> Uint8Array of per-vector flags (1 = non-finite, 2 = zero)
+static Napi::Value ScanVectorsJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Float32Array vectors = ReadFloat32Array(env, info[0], "vectors");
+    const size_t dims = ReadDimensions(env, info[1], vectors.ElementLength());
+    const size_t n = vectors.ElementLength() / dims;
+    Napi::Uint8Array flags = Napi::Uint8Array::New(env, n);
+    ScanVectors(vectors.Data(), n, dims, flags.Data());
+    return flags;
+}
+
+// normalizeL2(vectors, dims, output) -> -1, or the index of the first non-finite component
+static Napi::Value NormalizeL2JS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Float32Array vectors = ReadFloat32Array(env, info[0], "vectors");
+    const size_t length = vectors.ElementLength();
+    const size_t dims = ReadDimensions(env, info[1], length);
+    Napi::Float32Array output = ReadFloat32Array(env, info[2], "output");
+    if (output.ElementLength() < length) {
+        throw Napi::RangeError::New(
+            env, "output must hold at least " + std::to_string(length) + " floats");
+    }
+
+    const size_t found = NormalizeL2Vectors(vectors.Data(), length / dims, dims, output.Data());
+    return Napi::Number::New(env, found == length ? -1.0 : static_cast<double>(found));
+}
+
+class PairwiseDistancesWorker : public LaneWorker {
+public:
+    PairwiseDistancesWorker(std::vector<float> left, std::vector<float> right, size_t dims,
+                            DistanceMetric metric, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "PairwiseDistancesWorker", ExecutorLane::Interactive),
+          left_(std::move(left)),
+          right_(std::move(right)),
+          dims_(dims),
+          metric_(metric),
+          deferred_(deferred) {
+    }
+
+    void Execute() override {
+        ScopedOmpThreads scope;
+        try {
+            const size_t n = left_.size() / dims_;
+            const size_t m = right_.size() / dims_;
+            output_.resize(n * m);
+            PairwiseDistances(left_.data(), n, right_.data(), m, dims_, metric_, output_.data());
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        deferred_.Resolve(ExternalFloat32Array(env, std::move(output_)));
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    std::vector<float> left_;
+    std::vector<float> right_;
+    size_t dims_;
+    DistanceMetric metric_;
+    std::vector<float> output_;
+    Napi::Promise::Deferred deferred_;
+};
+
+static std::vector<float> CopyFloats(const Napi::Float32Array& array) {
+    return std::vector<float>(array.Data(), array.Data() + array.ElementLength());
+}
+
+// pairwiseDistances(left, right, dims, metric) -> Promise<Float32Array> of n * m distances
+static Napi::Value PairwiseDistancesJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Float32Array left = ReadFloat32Array(env, info[0], "left");
+    Napi::Float32Array right = ReadFloat32Array(env, info[1], "right");
+    const size_t dims = ReadDimensions(env, info[2], left.ElementLength());
+    ReadDimensions(env, info[2], right.ElementLength());
+    if (!info[3].IsString()) {
+        throw Napi::TypeError::New(env, "Expected string for metric");
+    }
+
+    DistanceMetric metric;
+    try {
+        metric = ParseDistanceMetric(info[3].As<Napi::String>().Utf8Value());
+    } catch (const std::invalid_argument& e) {
+        throw Napi::TypeError::New(env, e.what());
+    }
+
+    // Inputs are copied so the caller may reuse its arrays while the worker runs
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto* worker = new PairwiseDistancesWorker(CopyFloats(left), CopyFloats(right), dims, metric, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// Reads the caller's arrays in place, as borrow mode does for index calls: both are pinned
+// until the promise settles and must not be modified before then.
+class KnnWorker : public LaneWorker {
+public:
+    KnnWorker(const Napi::Float32Array& queries, const Napi::Float32Array& database, size_t dims, size_t k,
+              DistanceMetric metric, bool bigintLabels, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "KnnWorker", ExecutorLane::Interactive),
+          queries_(queries.Data()),
+          nq_(queries.ElementLength() / dims),
+          database_(database.Data()),
+          nb_(database.ElementLength() / dims),
+          queries_ref_(Napi::Persistent(static_cast<const Napi::Object&>(queries))),
+          database_ref_(Napi::Persistent(static_cast<const Napi::Object&>(database))),
+          dims_(dims),
+          k_(k),
+          metric_(metric),
+          bigint_labels_(bigintLabels),
+          deferred_(deferred) {
+    }
+
+    void Execute() override {
+        ScopedOmpThreads scope;
+        try {
+            distances_.resize(nq_ * k_);
+            labels_.resize(nq_ * k_);
+            KnnSearch(queries_, nq_, database_, nb_, dims_, k_, metric_, distances_.data(), labels_.data());
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("distances", ExternalFloat32Array(env, std::move(distances_)));
+        result.Set("labels", CreateLabelArray(env, std::move(labels_), bigint_labels_));
+        result.Set("nq", Napi::Number::New(env, static_cast<double>(nq_)));
+        result.Set("k", Napi::Number::New(env, static_cast<double>(k_)));
+        deferred_.Resolve(result);
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    const float* queries_;
+    size_t nq_;
+    const float* database_;
+    size_t nb_;
+    Napi::ObjectReference queries_ref_;
+    Napi::ObjectReference database_ref_;
+    size_t dims_;
+    size_t k_;
+    DistanceMetric metric_;
+    bool bigint_labels_;
+    std::vector<float> distances_;
+    std::vector<int64_t> labels_;
+    Napi::Promise::Deferred deferred_;
+};
+
+// knn(queries, database, dims, k, metric, bigintLabels) -> Promise<{ distances, labels, nq, k }>
+// k is clamped to the database size, as searchBatch clamps it to ntotal.
+static Napi::Value KnnJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Float32Array queries = ReadFloat32Array(env, info[0], "queries");
+    Napi::Float32Array database = ReadFloat32Array(env, info[1], "database");
+    const size_t dims = ReadDimensions(env, info[2], queries.ElementLength());
+    ReadDimensions(env, info[2], database.ElementLength());
+    if (!info[3].IsNumber() || info[3].As<Napi::Number>().Int64Value() <= 0) {
+        throw Napi::RangeError::New(env, "k must be a positive integer");
+    }
+    if (!info[4].IsString()) {
+        throw Napi::TypeError::New(env, "Expected string for metric");
+    }
+
+    DistanceMetric metric;
+    try {
+        metric = ParseDistanceMetric(info[4].As<Napi::String>().Utf8Value());
+    } catch (const std::invalid_argument& e) {
+        throw Napi::TypeError::New(env, e.what());
+    }
+
+    const size_t nb = database.ElementLength() / dims;
+    if (nb == 0) {
+        throw Napi::RangeError::New(env, "database cannot be empty");
+    }
+    const size_t k = std::min(static_cast<size_t>(info[3].As<Napi::Number>().Int64Value()), nb);
+    const bool bigintLabels = info[5].IsBoolean() && info[5].As<Napi::Boolean>().Value();
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto* worker = new KnnWorker(queries, database, dims, k, metric, bigintLabels, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+static Napi::Uint8Array ReadUint8Array(Napi::Env env, const Napi::Value& value, const char* name) {
+    if (!value.IsTypedArray() || value.As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+        throw Napi::TypeError::New(env, std::string("Expected Uint8Array for ") + name);
+    }
+    return value.As<Napi::Uint8Array>();
+}
+
+// Binary dims are in bits, as for FaissBinaryIndex; returns the code size in bytes
+static size_t ReadCodeSize(Napi::Env env, const Napi::Value& value, size_t length) {
+    if (!value.IsNumber()) {
+        throw Napi::TypeError::New(env, "Expected number for dims");
+    }
+    const int64_t dims = value.As<Napi::Number>().Int64Value();
+    if (dims <= 0 || dims % 8 != 0) {
+        throw Napi::RangeError::New(env, "Binary dims must be a positive multiple of 8");
+    }
+    const size_t codeSize = static_cast<size_t>(dims / 8);
+    if (length % codeSize != 0) {
+        throw Napi::RangeError::New(
+            env, "Code length must be a multiple of " + std::to_string(codeSize) + " bytes");
+    }
+    return codeSize;
+}
+
+class HammingDistancesWorker : public LaneWorker {
+public:
+    HammingDistancesWorker(std::vector<uint8_t> a, std::vector<uint8_t> b, size_t codeSize,
+                           Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "HammingDistancesWorker", ExecutorLane::Interactive),
+          a_(std::move(a)),
+          b_(std::move(b)),
+          code_size_(codeSize),
+          deferred_(deferred) {
+    }
+
+    void Execute() override {
+        ScopedOmpThreads scope;
+        try {
+            const size_t na = a_.size() / code_size_;
+            const size_t nb = b_.size() / code_size_;
+            output_.resize(na * nb);
+            HammingDistances(a_.data(), na, b_.data(), nb, code_size_, output_.data());
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        const size_t length = output_.size();
+        deferred_.Resolve(Napi::Int32Array::New(env, length, ExternalArrayBuffer(env, std::move(output_)), 0));
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    std::vector<uint8_t> a_;
+    std::vector<uint8_t> b_;
+    size_t code_size_;
+    std::vector<int32_t> output_;
+    Napi::Promise::Deferred deferred_;
+};
+
+// hammingDistances(a, b, dims) -> Promise<Int32Array> of na * nb distances
+static Napi::Value HammingDistancesJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Uint8Array a = ReadUint8Array(env, info[0], "a");
+    Napi::Uint8Array b = ReadUint8Array(env, info[1], "b");
+    const size_t codeSize = ReadCodeSize(env, info[2], a.ElementLength());
+    ReadCodeSize(env, info[2], b.ElementLength());
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto* worker = new HammingDistancesWorker(
+        std::vector<uint8_t>(a.Data(), a.Data() + a.ElementLength()),
+        std::vector<uint8_t>(b.Data(), b.Data() + b.ElementLength()),
+        codeSize, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// Reads both code arrays in place and pins them until the promise settles, like KnnWorker.
+class HammingKnnWorker : public LaneWorker {
+public:
+    HammingKnnWorker(const Napi::Uint8Array& queries, const Napi::Uint8Array& database, size_t codeSize,
+                     size_t k, Napi::Promise::Deferred deferred)
+        : LaneWorker(deferred.Env(), "HammingKnnWorker", ExecutorLane::Interactive),
+          queries_(queries.Data()),
+          nq_(queries.ElementLength() / codeSize),
+          database_(database.Data()),
+          nb_(database.ElementLength() / codeSize),
+          queries_ref_(Napi::Persistent(static_cast<const Napi::Object&>(queries))),
+          database_ref_(Napi::Persistent(static_cast<const Napi::Object&>(database))),
+          code_size_(codeSize),
+          k_(k),
+          deferred_(deferred) {
+    }
+
+    void Execute() override {
+        ScopedOmpThreads scope;
+        try {
+            distances_.resize(nq_ * k_);
+            labels_.resize(nq_ * k_);
+            HammingKnn(queries_, nq_, database_, nb_, code_size_, k_, distances_.data(), labels_.data());
+        } catch (const std::exception& e) {
+            SetError(std::string("FAISS error: ") + e.what());
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        Napi::Object result = Napi::Object::New(env);
+        const size_t length = distances_.size();
+        result.Set("distances", Napi::Int32Array::New(env, length, ExternalArrayBuffer(env, std::move(distances_)), 0));
+        result.Set("labels", CreateLabelArray(env, std::move(labels_), false));
+        result.Set("nq", Napi::Number::New(env, static_cast<double>(nq_)));
+        result.Set("k", Napi::Number::New(env, static_cast<double>(k_)));
+        deferred_.Resolve(result);
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    const uint8_t* queries_;
+    size_t nq_;
+    const uint8_t* database_;
+    size_t nb_;
+    Napi::ObjectReference queries_ref_;
+    Napi::ObjectReference database_ref_;
+    size_t code_size_;
+    size_t k_;
+    std::vector<int32_t> distances_;
+    std::vector<int64_t> labels_;
+    Napi::Promise::Deferred deferred_;
+};
+
+// hammingKnn(queries, database, dims, k) -> Promise<{ distances, labels, nq, k }>, k clamped
+// to the database size
+static Napi::Value HammingKnnJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Uint8Array queries = ReadUint8Array(env, info[0], "queries");
+    Napi::Uint8Array database = ReadUint8Array(env, info[1], "database");
+    const size_t codeSize = ReadCodeSize(env, info[2], queries.ElementLength());
+    ReadCodeSize(env, info[2], database.ElementLength());
+    if (!info[3].IsNumber() || info[3].As<Napi::Number>().Int64Value() <= 0) {
+        throw Napi::RangeError::New(env, "k must be a positive integer");
+    }
+
+    const size_t nb = database.ElementLength() / codeSize;
+    if (nb == 0) {
+        throw Napi::RangeError::New(env, "database cannot be empty");
+    }
+    const size_t k = std::min(static_cast<size_t>(info[3].As<Napi::Number>().Int64Value()), nb);
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto* worker = new HammingKnnWorker(queries, database, codeSize, k, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+static Napi::Value SimdLevelJS(const Napi::CallbackInfo& info) {
+    return Napi::String::New(info.Env(), VectorKernelSimdLevel());
+}
+
+// setNumThreads(n): OpenMP threads per FAISS call from any worker; 0 restores the default
+static Napi::Value SetNumThreadsJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!info[0].IsNumber()) {
+        throw Napi::TypeError::New(env, "Expected number for threads");
+    }
+    const double threads = info[0].As<Napi::Number>().DoubleValue();
+    if (threads < 0 || threads > 4096 || threads != static_cast<int>(threads)) {
+        throw Napi::RangeError::New(env, "threads must be an integer between 0 and 4096");
+    }
+    if (threads > 1 && !OmpAvailable()) {
+        throw Napi::Error::New(env, "threads > 1 is not supported: this build has no OpenMP");
+    }
+    ProcessOmpThreads().store(static_cast<int>(threads));
+    return env.Undefined();
+}
+
+// getNumThreads() -> { threads: effective count, configured: setNumThreads value or 0,
+//                     openmp: whether FAISS calls can use more than one thread }
+static Napi::Value GetNumThreadsJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("threads", Napi::Number::New(env, EffectiveOmpThreads()));
+    result.Set("configured", Napi::Number::New(env, ProcessOmpThreads().load()));
+    result.Set("openmp", Napi::Boolean::New(env, OmpAvailable()));
+    return result;
+}
+
+static Napi::Object LaneStatsObject(Napi::Env env, ExecutorLane lane) {
+    const ExecutorLaneStats stats = Executor::Instance().Stats(lane);
+    const uint64_t dequeued = stats.completed + stats.running;
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("threads", Napi::Number::New(env, static_cast<double>(stats.threads)));
+    result.Set("activeThreads", Napi::Number::New(env, static_cast<double>(stats.started)));
+    result.Set("queued", Napi::Number::New(env, static_cast<double>(stats.queued)));
+    result.Set("running", Napi::Number::New(env, static_cast<double>(stats.running)));
+    result.Set("completed", Napi::Number::New(env, static_cast<double>(stats.completed)));
+    result.Set("avgWaitMs", Napi::Number::New(env, dequeued > 0 ? stats.totalWaitMs / dequeued : 0.0));
+    result.Set("maxWaitMs", Napi::Number::New(env, stats.maxWaitMs));
+    return result;
+}
+
+// getExecutorStats() -> { interactive, background }: size, queue depth and queue wait per lane
+static Napi::Value GetExecutorStatsJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("interactive", LaneStatsObject(env, ExecutorLane::Interactive));
+    result.Set("background", LaneStatsObject(env, ExecutorLane::Background));
+    return result;
+}
+
+// configureExecutor({ interactive?, background? }): resizes the native lanes
+static Napi::Value ConfigureExecutorJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!info[0].IsObject()) {
+        throw Napi::TypeError::New(env, "Expected object for executor options");
+    }
+    Napi::Object options = info[0].As<Napi::Object>();
+    const struct {
+        const char* name;
+        ExecutorLane lane;
+    } lanes[] = {{"interactive", ExecutorLane::Interactive}, {"background", ExecutorLane::Background}};
+
+    size_t sizes[2] = {0, 0};
+    for (size_t i = 0; i < 2; i++) {
+        Napi::Value value = options.Get(lanes[i].name);
+        if (value.IsUndefined()) {
+            continue;
+        }
+        if (!value.IsNumber()) {
+            throw Napi::TypeError::New(env, std::string("Expected number for ") + lanes[i].name);
+        }
+        const double threads = value.As<Napi::Number>().DoubleValue();
+        if (threads < 1 || threads > 4096 || threads != static_cast<int>(threads)) {
+            throw Napi::RangeError::New(env, std::string(lanes[i].name) + " must be an integer between 1 and 4096");
+        }
+        sizes[i] = static_cast<size_t>(threads);
+    }
+    for (size_t i = 0; i < 2; i++) {
+        if (sizes[i] > 0) {
+            Executor::Instance().Resize(lanes[i].lane, sizes[i]);
+        }
+    }
+    return env.Undefined();
+}
+
+Napi::Object InitVectorUtilities(Napi::Env env, Napi::Object exports) {
+    Napi::Object kernels = Napi::Object::New(env);
+    kernels.Set("findNonFinite", Napi::Function::New(env, FindNonFiniteJS, "findNonFinite"));
+    kernels.Set("scanVectors", Napi::Function::New(env, ScanVectorsJS, "scanVectors"));
+    kernels.Set("normalizeL2", Napi::Function::New(env, NormalizeL2JS, "normalizeL2"));
+    kernels.Set("simdLevel", Napi::Function::New(env, SimdLevelJS, "simdLevel"));
+    kernels.Set("pairwiseDistances", Napi::Function::New(env, PairwiseDistancesJS, "pairwiseDistances"));
+    kernels.Set("knn", Napi::Function::New(env, KnnJS, "knn"));
+    kernels.Set("hammingDistances", Napi::Function::New(env, HammingDistancesJS, "hammingDistances"));
+    kernels.Set("hammingKnn", Napi::Function::New(env, HammingKnnJS, "hammingKnn"));
+    exports.Set("vectorKernels", kernels);
+    exports.Set("setNumThreads", Napi::Function::New(env, SetNumThreadsJS, "setNumThreads"));
+    exports.Set("getNumThreads", Napi::Function::New(env, GetNumThreadsJS, "getNumThreads"));
+    exports.Set("getExecutorStats", Napi::Function::New(env, GetExecutorStatsJS, "getExecutorStats"));
+    exports.Set("configureExecutor", Napi::Function::New(env, ConfigureExecutorJS, "configureExecutor"));
+    return exports;
+}
@@ -0,0 +1,8 @@
+#ifndef FAISS_NODE_NAPI_UTILITY_BINDINGS_H
+#define FAISS_NODE_NAPI_UTILITY_BINDINGS_H
+
+#include <napi.h>
+
+Napi::Object InitVectorUtilities(Napi::Env env, Napi::Object exports);
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef FAISS_NODE_PARALLEL_FOR_H
+#define FAISS_NODE_PARALLEL_FOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+
+#ifndef _OPENMP
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+
+#include "executor.h"
+#endif
+
+// Below this many items, OpenMP thread start-up costs more than the work it spreads.
+constexpr size_t kParallelForMinItems = 64;
+
+#ifndef _OPENMP
+// Builds without OpenMP spread a loop over the calling thread's executor lane instead:
+// up to width - 1 helper tasks are queued, and every participant claims items from a
+// shared counter. The calling thread claims items too, so the loop finishes even when
+// every other lane thread is busy; a helper that starts after the last item is claimed
+// returns at once. The first exception is rethrown once every item has finished.
+template <typename Body>
+void ExecutorParallelFor(size_t n, size_t width, const Body& body) {
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+    };
+    if (n == 0) {
+        return;
+    }
+    auto state = std::make_shared<State>();
+
+    // body is only touched for claimed items, all of which finish before this returns
+    auto drain = [state, n, &body]() {
+        for (size_t i = state->next.fetch_add(1); i < n; i = state->next.fetch_add(1)) {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(state->mutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+            if (state->done.fetch_add(1) + 1 == n) {
+                std::lock_guard<std::mutex> guard(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    const ExecutorLane lane = Executor::CurrentLane();
+    const size_t helpers = std::min(std::max<size_t>(width, 1), n) - 1;
+    for (size_t h = 0; h < helpers; h++) {
+        Executor::Instance().Submit(lane, drain);
+    }
+    drain();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&]() { return state->done.load() == n; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+#endif
+
+// Runs body(i) for every i in [0, n), spread over the OpenMP pool when parallel is true
+// (over the executor lane in builds without OpenMP). Exceptions cannot leave an OpenMP
+// region, so the first one is captured and rethrown on the calling thread once the loop
+// finishes.
+template <typename Body>
+void ParallelFor(size_t n, bool parallel, Body&& body) {
+#ifndef _OPENMP
+    if (parallel && n >= kParallelForMinItems) {
+        ExecutorParallelFor(n, Executor::Instance().Stats(Executor::CurrentLane()).threads, body);
+        return;
+    }
+#endif
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    const int64_t count = static_cast<int64_t>(n);
+
+#pragma omp parallel for if (parallel && n >= kParallelForMinItems)
+    for (int64_t i = 0; i < count; i++) {
+        try {
+            body(static_cast<size_t>(i));
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+#endif // FAISS_NODE_PARALLEL_FOR_H
@@ -0,0 +1,95 @@
+#ifndef FAISS_NODE_THREAD_CONTROL_H
+#define FAISS_NODE_THREAD_CONTROL_H
+
+#include <atomic>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * OpenMP thread counts for FAISS calls made from worker threads. Every worker is an
+ * OpenMP master thread, so with the defaults a pool of P workers can start P times
+ * the core count of OpenMP threads. omp_set_num_threads only affects the calling
+ * thread, which lets each worker run with its own count for the span of one call.
+ */
+
+// Whether this build was compiled with OpenMP. Without it every FAISS call runs on the
+// calling thread, so thread counts above 1 are rejected rather than silently ignored.
+inline constexpr bool OmpAvailable() {
+#ifdef _OPENMP
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Process-wide count applied to every worker; 0 keeps the OpenMP default
+// (OMP_NUM_THREADS, or one per core).
+inline std::atomic<int>& ProcessOmpThreads() {
+    static std::atomic<int> threads{0};
+    return threads;
+}
+
+// Threads a call would use: the per-call request, else the process setting, else the
+// OpenMP default. Always 1 without OpenMP.
+inline int EffectiveOmpThreads(int requested = 0) {
+    if (!OmpAvailable()) {
+        return 1;
+    }
+    if (requested > 0) {
+        return requested;
+    }
+    const int process = ProcessOmpThreads().load();
+    if (process > 0) {
+        return process;
+    }
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Threads an OpenMP region started on the current thread would use right now,
+// including any ScopedOmpThreads in effect.
+inline int CurrentOmpThreads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Applies a per-call (or else the process-wide) thread count to the current thread
+// and restores the previous one on scope exit.
+class ScopedOmpThreads {
+public:
+    explicit ScopedOmpThreads(int requested = 0) {
+#ifdef _OPENMP
+        const int threads = requested > 0 ? requested : ProcessOmpThreads().load();
+        if (threads > 0) {
+            previous_ = omp_get_max_threads();
+            omp_set_num_threads(threads);
+        }
+#else
+        (void)requested;
+#endif
+    }
+
+    ~ScopedOmpThreads() {
+#ifdef _OPENMP
+        if (previous_ > 0) {
+            omp_set_num_threads(previous_);
+        }
+#endif
+    }
+
+    ScopedOmpThreads(const ScopedOmpThreads&) = delete;
+    ScopedOmpThreads& operator=(const ScopedOmpThreads&) = delete;
+
+private:
+    int previous_ = 0;
+};
+
+#endif // FAISS_NODE_THREAD_CONTROL_H
@@ -0,0 +1,203 @@
+#include "vector_file_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Returns the raw text of key's value in a .npy header dict, e.g. "'<f4'" or "(10, 4)".
+std::string NpyHeaderValue(const std::string& header, const std::string& key) {
+    size_t pos = header.find("'" + key + "'");
+    if (pos != std::string::npos) {
+        pos = header.find(':', pos);
+    }
+    if (pos != std::string::npos) {
+        pos = header.find_first_not_of(' ', pos + 1);
+    }
+    if (pos == std::string::npos) {
+        throw std::runtime_error("npy header has no " + key + " field");
+    }
+
+    size_t end = header[pos] == '(' ? header.find(')', pos) : header.find_first_of(",}", pos);
+    if (end == std::string::npos) {
+        throw std::runtime_error("npy header has a malformed " + key + " field");
+    }
+    return header.substr(pos, header[pos] == '(' ? end - pos + 1 : end - pos);
+}
+
+std::vector<uint64_t> ParseNpyShape(const std::string& shape) {
+    std::vector<uint64_t> extents;
+    size_t pos = 1;  // past '('
+    while (pos < shape.size()) {
+        pos = shape.find_first_of("0123456789", pos);
+        if (pos == std::string::npos) {
+            break;
+        }
+        size_t end = shape.find_first_not_of("0123456789", pos);
+        extents.push_back(std::stoull(shape.substr(pos, end - pos)));
+        pos = end;
+    }
+    return extents;
+}
+
+}  // namespace
+
+VectorFileReader::Format VectorFileReader::ParseFormat(const std::string& name) {
+    if (name == "fvecs") {
+        return Format::Fvecs;
+    }
+    if (name == "npy") {
+        return Format::Npy;
+    }
+    if (name == "raw") {
+        return Format::Raw;
+    }
+    throw std::invalid_argument("Unsupported vector file format: " + name + ". Supported: fvecs, npy, raw");
+}
+
+VectorFileReader::VectorFileReader(const std::string& path, Format format, int dims)
+    : path_(path), format_(format), dims_(dims) {
+    if (dims <= 0) {
+        throw std::invalid_argument("Dimensions must be positive");
+    }
+
+    file_.open(path, std::ios::binary);
+    if (!file_) {
+        throw std::runtime_error("Cannot open vector file: " + path);
+    }
+
+    file_.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(file_.tellg());
+    file_.seekg(0, std::ios::beg);
+
+    switch (format_) {
+        case Format::Fvecs:
+            OpenFvecs(fileSize);
+            break;
+        case Format::Npy:
+            OpenNpy(fileSize);
+            break;
+        case Format::Raw:
+            OpenRaw(fileSize);
+            break;
+    }
+}
+
+void VectorFileReader::OpenFvecs(uint64_t fileSize) {
+    const uint64_t recordBytes = sizeof(int32_t) + sizeof(float) * static_cast<uint64_t>(dims_);
+    if (fileSize == 0) {
+        return;
+    }
+
+    int32_t firstDims = 0;
+    if (!file_.read(reinterpret_cast<char*>(&firstDims), sizeof(firstDims))) {
+        throw std::runtime_error("Truncated fvecs file: " + path_);
+    }
+    file_.seekg(0, std::ios::beg);
+
+    if (firstDims != dims_) {
+        throw std::runtime_error(
+            "fvecs file has dimension " + std::to_string(firstDims) +
+            ", index expects " + std::to_string(dims_));
+    }
+
+    if (fileSize % recordBytes != 0) {
+        throw std::runtime_error("fvecs file size is not a whole number of records: " + path_);
+    }
+    count_ = static_cast<size_t>(fileSize / recordBytes);
+}
+
+void VectorFileReader::OpenNpy(uint64_t fileSize) {
+    char preamble[10];
+    if (!file_.read(preamble, sizeof(preamble)) || memcmp(preamble, "\x93NUMPY", 6) != 0) {
+        throw std::runtime_error("Not a .npy file: " + path_);
+    }
+
+    const unsigned char major = static_cast<unsigned char>(preamble[6]);
+    uint64_t headerLength = 0;
+    uint64_t dataOffset = 0;
+    if (major == 1) {
+        headerLength = static_cast<unsigned char>(preamble[8]) |
+                       (static_cast<uint64_t>(static_cast<unsigned char>(preamble[9])) << 8);
+        dataOffset = 10 + headerLength;
+    } else if (major == 2 || major == 3) {
+        char extra[2];
+        if (!file_.read(extra, sizeof(extra))) {
+            throw std::runtime_error("Truncated .npy header: " + path_);
+        }
+        const unsigned char bytes[4] = {
+            static_cast<unsigned char>(preamble[8]), static_cast<unsigned char>(preamble[9]),
+            static_cast<unsigned char>(extra[0]), static_cast<unsigned char>(extra[1])};
+        headerLength = bytes[0] | (bytes[1] << 8) | (static_cast<uint64_t>(bytes[2]) << 16) |
+                       (static_cast<uint64_t>(bytes[3]) << 24);
+        dataOffset = 12 + headerLength;
+    } else {
+        throw std::runtime_error("Unsupported .npy version " + std::to_string(major) + ": " + path_);
+    }
+
+    std::string header(static_cast<size_t>(headerLength), '\0');
+    if (!file_.read(&header[0], static_cast<std::streamsize>(headerLength))) {
+        throw std::runtime_error("Truncated .npy header: " + path_);
+    }
+
+    if (NpyHeaderValue(header, "descr") != "'<f4'") {
+        throw std::runtime_error(".npy data must be little-endian float32 ('<f4'): " + path_);
+    }
+    if (NpyHeaderValue(header, "fortran_order") != "False") {
+        throw std::runtime_error(".npy data must be in C order: " + path_);
+    }
+
+    std::vector<uint64_t> shape = ParseNpyShape(NpyHeaderValue(header, "shape"));
+    if (shape.size() != 2 || shape[1] != static_cast<uint64_t>(dims_)) {
+        throw std::runtime_error(
+            ".npy array must have shape (n, " + std::to_string(dims_) + "): " + path_);
+    }
+
+    if (fileSize < dataOffset || (fileSize - dataOffset) / sizeof(float) / shape[1] < shape[0]) {
+        throw std::runtime_error("Truncated .npy data: " + path_);
+    }
+    count_ = static_cast<size_t>(shape[0]);
+}
+
+void VectorFileReader::OpenRaw(uint64_t fileSize) {
+    const uint64_t vectorBytes = sizeof(float) * static_cast<uint64_t>(dims_);
+    if (fileSize % vectorBytes != 0) {
+        throw std::runtime_error(
+            "Raw vector file size is not a multiple of " + std::to_string(vectorBytes) + " bytes: " + path_);
+    }
+    count_ = static_cast<size_t>(fileSize / vectorBytes);
+}
+
+size_t VectorFileReader::Read(float* output, size_t maxVectors) {
+    size_t n = std::min(maxVectors, count_ - position_);
+    if (n == 0) {
+        return 0;
+    }
+
+    const size_t vectorBytes = sizeof(float) * static_cast<size_t>(dims_);
+    if (format_ == Format::Fvecs) {
+        const size_t recordBytes = sizeof(int32_t) + vectorBytes;
+        records_.resize(n * recordBytes);
+        if (!file_.read(records_.data(), static_cast<std::streamsize>(records_.size()))) {
+            throw std::runtime_error("Unexpected end of vector file: " + path_);
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            const char* record = records_.data() + i * recordBytes;
+            int32_t recordDims = 0;
+            memcpy(&recordDims, record, sizeof(recordDims));
+            if (recordDims != dims_) {
+                throw std::runtime_error(
+                    "fvecs record " + std::to_string(position_ + i) + " has dimension " +
+                    std::to_string(recordDims) + ", index expects " + std::to_string(dims_));
+            }
+            memcpy(output + i * static_cast<size_t>(dims_), record + sizeof(int32_t), vectorBytes);
+        }
+    } else if (!file_.read(reinterpret_cast<char*>(output), static_cast<std::streamsize>(n * vectorBytes))) {
+        throw std::runtime_error("Unexpected end of vector file: " + path_);
+    }
+
+    position_ += n;
+    return n;
+}
@@ -0,0 +1,55 @@
+#ifndef FAISS_NODE_VECTOR_FILE_READER_H
+#define FAISS_NODE_VECTOR_FILE_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Sequential reader for float32 vector files, so datasets can be added to an
+ * index in chunks without ever being loaded whole. Supported layouts:
+ *   - fvecs: per vector, an int32 dimension followed by that many floats
+ *   - npy:   a NumPy (v1-v3) '<f4' array in C order with shape (n, dims)
+ *   - raw:   headerless float32 values, n * dims of them
+ * Values are read in host byte order, i.e. little-endian files on little-endian hosts.
+ */
+class VectorFileReader {
+public:
+    enum class Format { Fvecs, Npy, Raw };
+
+    // "fvecs", "npy", or "raw"; throws std::invalid_argument otherwise
+    static Format ParseFormat(const std::string& name);
+
+    // Opens path and validates its header and size against dims.
+    // Throws std::runtime_error if the file cannot be read or does not match.
+    VectorFileReader(const std::string& path, Format format, int dims);
+
+    VectorFileReader(const VectorFileReader&) = delete;
+    VectorFileReader& operator=(const VectorFileReader&) = delete;
+
+    // Number of vectors in the file
+    size_t Count() const {
+        return count_;
+    }
+
+    // Reads up to maxVectors vectors into output (room for maxVectors * dims floats).
+    // Returns the number read, 0 once the file is exhausted.
+    size_t Read(float* output, size_t maxVectors);
+
+private:
+    void OpenFvecs(uint64_t fileSize);
+    void OpenNpy(uint64_t fileSize);
+    void OpenRaw(uint64_t fileSize);
+
+    std::string path_;
+    std::ifstream file_;
+    Format format_;
+    int dims_;
+    size_t count_ = 0;
+    size_t position_ = 0;       // vectors read so far
+    std::vector<char> records_;  // fvecs: raw records, headers interleaved
+};
+
+#endif // FAISS_NODE_VECTOR_FILE_READER_H
@@ -0,0 +1,262 @@
+#include "vector_kernels.h"
+
+#include <cmath>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FAISS_NODE_AVX2_DISPATCH 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define FAISS_NODE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr uint32_t kExponentMask = 0x7f800000u;
+constexpr uint32_t kMagnitudeMask = 0x7fffffffu;
+
+inline uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+size_t FindNonFiniteScalar(const float* x, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if ((FloatBits(x[i]) & kExponentMask) == kExponentMask) {
+            return i;
+        }
+    }
+    return n;
+}
+
+bool IsZeroScalar(const float* x, size_t n) {
+    uint32_t any = 0;
+    for (size_t i = 0; i < n; i++) {
+        any |= FloatBits(x[i]) & kMagnitudeMask;
+    }
+    return any == 0;
+}
+
+double SquaredNormScalar(const float* x, size_t n) {
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += static_cast<double>(x[i]) * x[i];
+    }
+    return sum;
+}
+
+#if defined(FAISS_NODE_AVX2_DISPATCH)
+
+__attribute__((target("avx2"))) size_t FindNonFiniteAvx2(const float* x, size_t n) {
+    const __m256i mask = _mm256_set1_epi32(static_cast<int>(kExponentMask));
+    size_t i = 0;
+    // 32 floats per iteration; the exact position is only located once a block trips.
+    for (; i + 32 <= n; i += 32) {
+        __m256i hit = _mm256_setzero_si256();
+        for (size_t k = 0; k < 32; k += 8) {
+            const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i + k));
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(_mm256_and_si256(bits, mask), mask));
+        }
+        if (!_mm256_testz_si256(hit, hit)) {
+            return i + FindNonFiniteScalar(x + i, 32);
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        const __m256i hit = _mm256_cmpeq_epi32(_mm256_and_si256(bits, mask), mask);
+        if (!_mm256_testz_si256(hit, hit)) {
+            return i + FindNonFiniteScalar(x + i, 8);
+        }
+    }
+    return i + FindNonFiniteScalar(x + i, n - i);
+}
+
+__attribute__((target("avx2"))) bool IsZeroAvx2(const float* x, size_t n) {
+    const __m256i mask = _mm256_set1_epi32(static_cast<int>(kMagnitudeMask));
+    __m256i any = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        any = _mm256_or_si256(any, _mm256_and_si256(bits, mask));
+    }
+    return _mm256_testz_si256(any, any) && IsZeroScalar(x + i, n - i);
+}
+
+// Squares are summed in double lanes so the result matches the scalar path to
+// within rounding, whatever the dimensionality.
+__attribute__((target("avx2,fma"))) double SquaredNormAvx2(const float* x, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 v = _mm256_loadu_ps(x + i);
+        const __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        const __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        acc0 = _mm256_fmadd_pd(lo, lo, acc0);
+        acc1 = _mm256_fmadd_pd(hi, hi, acc1);
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + SquaredNormScalar(x + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(const float* x, size_t n, float scale, float* out) {
+    const __m256 s = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(x + i), s));
+    }
+    for (; i < n; i++) {
+        out[i] = x[i] * scale;
+    }
+}
+
+bool HasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+
+#elif defined(FAISS_NODE_NEON)
+
+size_t FindNonFiniteNeon(const float* x, size_t n) {
+    const uint32x4_t mask = vdupq_n_u32(kExponentMask);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint32x4_t hit = vdupq_n_u32(0);
+        for (size_t k = 0; k < 16; k += 4) {
+            const uint32x4_t bits = vreinterpretq_u32_f32(vld1q_f32(x + i + k));
+            hit = vorrq_u32(hit, vceqq_u32(vandq_u32(bits, mask), mask));
+        }
+        if (vmaxvq_u32(hit) != 0) {
+            return i + FindNonFiniteScalar(x + i, 16);
+        }
+    }
+    return i + FindNonFiniteScalar(x + i, n - i);
+}
+
+bool IsZeroNeon(const float* x, size_t n) {
+    const uint32x4_t mask = vdupq_n_u32(kMagnitudeMask);
+    uint32x4_t any = vdupq_n_u32(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        any = vorrq_u32(any, vandq_u32(vreinterpretq_u32_f32(vld1q_f32(x + i)), mask));
+    }
+    return vmaxvq_u32(any) == 0 && IsZeroScalar(x + i, n - i);
+}
+
+double SquaredNormNeon(const float* x, size_t n) {
+    float64x2_t acc0 = vdupq_n_f64(0);
+    float64x2_t acc1 = vdupq_n_f64(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t v = vld1q_f32(x + i);
+        const float64x2_t lo = vcvt_f64_f32(vget_low_f32(v));
+        const float64x2_t hi = vcvt_high_f64_f32(v);
+        acc0 = vfmaq_f64(acc0, lo, lo);
+        acc1 = vfmaq_f64(acc1, hi, hi);
+    }
+    return vaddvq_f64(vaddq_f64(acc0, acc1)) + SquaredNormScalar(x + i, n - i);
+}
+
+void ScaleNeon(const float* x, size_t n, float scale, float* out) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(out + i, vmulq_n_f32(vld1q_f32(x + i), scale));
+    }
+    for (; i < n; i++) {
+        out[i] = x[i] * scale;
+    }
+}
+
+#endif
+
+bool IsZero(const float* x, size_t n) {
+#if defined(FAISS_NODE_AVX2_DISPATCH)
+    if (HasAvx2()) {
+        return IsZeroAvx2(x, n);
+    }
+#elif defined(FAISS_NODE_NEON)
+    return IsZeroNeon(x, n);
+#endif
+    return IsZeroScalar(x, n);
+}
+
+double SquaredNorm(const float* x, size_t n) {
+#if defined(FAISS_NODE_AVX2_DISPATCH)
+    if (HasAvx2()) {
+        return SquaredNormAvx2(x, n);
+    }
+#elif defined(FAISS_NODE_NEON)
+    return SquaredNormNeon(x, n);
+#endif
+    return SquaredNormScalar(x, n);
+}
+
+void Scale(const float* x, size_t n, float scale, float* out) {
+#if defined(FAISS_NODE_AVX2_DISPATCH)
+    if (HasAvx2()) {
+        ScaleAvx2(x, n, scale, out);
+        return;
+    }
+#elif defined(FAISS_NODE_NEON)
+    ScaleNeon(x, n, scale, out);
+    return;
+#endif
+    for (size_t i = 0; i < n; i++) {
+        out[i] = x[i] * scale;
+    }
+}
+
+} // namespace
+
+const char* VectorKernelSimdLevel() {
+#if defined(FAISS_NODE_AVX2_DISPATCH)
+    if (HasAvx2()) {
+        return "avx2";
+    }
+#elif defined(FAISS_NODE_NEON)
+    return "neon";
+#endif
+    return "scalar";
+}
+
+size_t FindNonFinite(const float* x, size_t n) {
+#if defined(FAISS_NODE_AVX2_DISPATCH)
+    if (HasAvx2()) {
+        return FindNonFiniteAvx2(x, n);
+    }
+#elif defined(FAISS_NODE_NEON)
+    return FindNonFiniteNeon(x, n);
+#endif
+    return FindNonFiniteScalar(x, n);
+}
+
+void ScanVectors(const float* x, size_t n, size_t d, uint8_t* flags) {
+    for (size_t i = 0; i < n; i++) {
+        const float* vector = x + i * d;
+        uint8_t flag = 0;
+        if (FindNonFinite(vector, d) != d) {
+            flag |= kVectorNonFinite;
+        }
+        if (IsZero(vector, d)) {
+            flag |= kVectorZero;
+        }
+        flags[i] = flag;
+    }
+}
+
+size_t NormalizeL2Vectors(const float* x, size_t n, size_t d, float* out) {
+    for (size_t i = 0; i < n; i++) {
+        const float* vector = x + i * d;
+        const size_t bad = FindNonFinite(vector, d);
+        if (bad != d) {
+            return i * d + bad;
+        }
+
+        const double norm = std::sqrt(SquaredNorm(vector, d));
+        Scale(vector, d, norm > 0 ? static_cast<float>(1.0 / norm) : 0.0f, out + i * d);
+    }
+    return n * d;
+}
@@ -0,0 +1,30 @@
+#ifndef FAISS_NODE_VECTOR_KERNELS_H
+#define FAISS_NODE_VECTOR_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Input checks run on every add and search, vectorized with AVX2 (selected at
+ * runtime on x86-64 GCC/Clang builds) or NEON (AArch64), with a scalar fallback.
+ * A value is non-finite when its exponent bits are all set, i.e. NaN or +/-Infinity.
+ */
+
+// Instruction set the kernels use on this machine: "avx2", "neon", or "scalar"
+const char* VectorKernelSimdLevel();
+
+// Index of the first NaN or Infinity among n floats, or n if all are finite
+size_t FindNonFinite(const float* x, size_t n);
+
+constexpr uint8_t kVectorNonFinite = 1;  // some component is NaN or Infinity
+constexpr uint8_t kVectorZero = 2;       // every component is +/-0
+
+// Writes one flags byte per vector of n vectors of d floats
+void ScanVectors(const float* x, size_t n, size_t d, uint8_t* flags);
+
+// Writes each vector divided by its L2 norm to out, which may alias x; zero vectors
+// are written as zeros. Returns n * d, or the index of the first non-finite component,
+// in which case out is only partially written.
+size_t NormalizeL2Vectors(const float* x, size_t n, size_t d, float* out);
+
+#endif // FAISS_NODE_VECTOR_KERNELS_H
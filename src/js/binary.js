@@ -15,16 +15,12 @@ const {
   validateBinaryVectors,
 } = require('./utils');
 
-let FaissBinaryIndexWrapper;
-try {
-  FaissBinaryIndexWrapper = require('../../build/Release/faiss_node.node').FaissBinaryIndexWrapper;
-} catch (e) {
-  try {
-    FaissBinaryIndexWrapper = require('../../build/faiss_node.node').FaissBinaryIndexWrapper;
-  } catch (e2) {
-    throw new Error('Native module not found. Run "npm run build" first.');
-  }
+const native = require('./native');
+
+if (!native) {
+  throw new Error('Native module not found. Run "npm run build" first.');
 }
+const { FaissBinaryIndexWrapper } = native;
 
 const VALID_BINARY_TYPES = ['BINARY_FLAT', 'BINARY_HNSW', 'BINARY_IVF', 'BINARY_HASH'];
 const GPU_SUPPORT = Object.freeze({
@@ -621,13 +617,26 @@ class FaissBinaryIndex {
     });
   }
 
-  async reconstructBatch(ids) {
+  async reconstructBatch(ids, output) {
     this._ensureActive();
     const normalizedIds = normalizeIdArray(ids);
-    return this._runAsync('reconstructBatch', () => this._native.reconstructBatch(normalizedIds), {
+    const needed = normalizedIds.length * this._bytesPerVector;
+    if (output !== undefined && output !== null) {
+      if (!(output instanceof Uint8Array)) {
+        throw new ValidationError('output must be a Uint8Array');
+      }
+      if (output.length < needed) {
+        throw new ValidationError(`output must hold at least ${needed} bytes`, {
+          details: { required: needed, length: output.length },
+        });
+      }
+    }
+
+    const result = await this._runAsync('reconstructBatch', () => this._native.reconstructBatch(normalizedIds, output), {
       details: { count: normalizedIds.length },
       suggestion: 'Older binary IVF indexes saved without a FAISS direct map may need to be rebuilt before batch reconstruction works.',
     });
+    return result.length > needed ? result.subarray(0, needed) : result;
   }
 
   async getVectorById(id) {
@@ -1,4 +1,5 @@
 const fs = require('fs/promises');
+const { Writable } = require('stream');
 const { FaissBinaryIndex } = require('./binary');
 
 const {
@@ -17,26 +18,28 @@ const {
   validateVectors,
   splitVectors,
   computeDistances,
+  pairwiseDistances,
+  knn,
+  hammingDistances,
+  hammingKnn,
   validateBinaryVectors,
   getVectorCount: getVectorCountForArray,
 } = require('./utils');
 
-// Try to load the native module (path may vary based on build system)
-let FaissIndexWrapper;
-try {
-  FaissIndexWrapper = require('../../build/Release/faiss_node.node').FaissIndexWrapper;
-} catch (e) {
-  try {
-    FaissIndexWrapper = require('../../build/faiss_node.node').FaissIndexWrapper;
-  } catch (e2) {
-    throw new Error('Native module not found. Run "npm run build" first.');
-  }
+const native = require('./native');
+
+if (!native) {
+  throw new Error('Native module not found. Run "npm run build" first.');
 }
+const { FaissIndexWrapper, FaissShardedIndexWrapper, vectorKernels } = native;
 
 const VALID_TYPES = ['FLAT_L2', 'FLAT_IP', 'IVF_FLAT', 'HNSW', 'PQ', 'IVF_PQ', 'IVF_SQ'];
 const IVF_TYPES = new Set(['IVF_FLAT', 'IVF_PQ', 'IVF_SQ']);
 const PQ_TYPES = new Set(['PQ', 'IVF_PQ']);
+const REFINE_TYPES = new Set(['PQ', 'IVF_PQ', 'IVF_SQ']);
+const VECTOR_FILE_FORMATS = new Set(['fvecs', 'npy', 'raw']);
 const VALID_METRICS = new Set(['l2', 'ip']);
+const VALID_LABEL_TYPES = new Set(['int32', 'bigint']);
 const GPU_SUPPORT = Object.freeze({
   compiled: false,
   available: false,
@@ -51,6 +54,24 @@ function validatePositiveInteger(name, value) {
   }
 }
 
+// OpenMP thread counts: builds without OpenMP run every FAISS call on one thread
+function validateThreads(value) {
+  validatePositiveInteger('threads', value);
+  if (value > 1 && !native.getNumThreads().openmp) {
+    throw new UnsupportedOperationError('threads > 1 is not supported: this build has no OpenMP', {
+      details: { threads: value },
+    });
+  }
+}
+
+function validateKFactor(value) {
+  if (typeof value !== 'number' || !Number.isFinite(value) || value < 1 || value > 65536) {
+    throw new ValidationError('kFactor must be a number between 1 and 65536', {
+      details: { kFactor: value },
+    });
+  }
+}
+
 function validateNonEmptyString(name, value) {
   if (typeof value !== 'string' || value.trim().length === 0) {
     throw new ValidationError(`${name} must be a non-empty string`, {
@@ -85,7 +106,7 @@ function validateFactoryConfig(config) {
     throw new ValidationError('type cannot be combined with factory; use one or the other');
   }
 
-  const factoryEncodedOptions = ['nlist', 'M', 'efConstruction', 'efSearch', 'pqSegments', 'pqBits', 'sqType'];
+  const factoryEncodedOptions = ['nlist', 'M', 'efConstruction', 'efSearch', 'pqSegments', 'pqBits', 'sqType', 'refine'];
   for (const key of factoryEncodedOptions) {
     if (config[key] !== undefined) {
       throw new ValidationError(
@@ -97,6 +118,10 @@ function validateFactoryConfig(config) {
   if (config.nprobe !== undefined) {
     validatePositiveInteger('nprobe', config.nprobe);
   }
+
+  if (config.kFactor !== undefined) {
+    validateKFactor(config.kFactor);
+  }
 }
 
 function validateIndexSpecificOptions(type, config) {
@@ -140,6 +165,20 @@ function validateIndexSpecificOptions(type, config) {
     throw new ValidationError('sqType is only supported for IVF_SQ indexes');
   }
 
+  if (config.refine !== undefined) {
+    if (!REFINE_TYPES.has(type)) {
+      throw new ValidationError('refine is only supported for PQ, IVF_PQ, and IVF_SQ indexes');
+    }
+    validateNonEmptyString('refine', config.refine);
+  }
+
+  if (config.kFactor !== undefined) {
+    if (config.refine === undefined) {
+      throw new ValidationError('kFactor requires refine');
+    }
+    validateKFactor(config.kFactor);
+  }
+
   for (const key of ['nlist', 'nprobe', 'M', 'efConstruction', 'efSearch', 'pqSegments', 'pqBits']) {
     if (config[key] !== undefined) {
       validatePositiveInteger(key, config[key]);
@@ -158,8 +197,69 @@ function validateIndexSpecificOptions(type, config) {
   }
 }
 
+function validateLabelType(labelType) {
+  if (labelType !== undefined && !VALID_LABEL_TYPES.has(labelType)) {
+    throw new ValidationError(`labelType must be one of: ${Array.from(VALID_LABEL_TYPES).join(', ')}`, {
+      details: { labelType },
+    });
+  }
+}
+
+function validateOptionalBoolean(name, value) {
+  if (value !== undefined && typeof value !== 'boolean') {
+    throw new ValidationError(`${name} must be a boolean`, { details: { [name]: value } });
+  }
+}
+
+function normalizeCoalesceOptions(options) {
+  if (options === undefined || options === null || options === false) {
+    return null;
+  }
+
+  if (options === true) {
+    return { maxBatchSize: 64, windowMs: 1 };
+  }
+
+  if (typeof options !== 'object') {
+    throw new ValidationError('coalesce must be a boolean or { maxBatchSize, windowMs }', {
+      details: { coalesce: options },
+    });
+  }
+
+  const normalized = {
+    maxBatchSize: options.maxBatchSize === undefined ? 64 : options.maxBatchSize,
+    windowMs: options.windowMs === undefined ? 1 : options.windowMs,
+  };
+
+  validatePositiveInteger('coalesce.maxBatchSize', normalized.maxBatchSize);
+  if (typeof normalized.windowMs !== 'number' || !Number.isFinite(normalized.windowMs) || normalized.windowMs < 0) {
+    throw new ValidationError('coalesce.windowMs must be a non-negative number', {
+      details: { windowMs: normalized.windowMs },
+    });
+  }
+
+  return normalized;
+}
+
+function inferVectorFileFormat(path) {
+  const extension = path.slice(path.lastIndexOf('.') + 1).toLowerCase();
+  if (extension === 'fvecs' || extension === 'npy') {
+    return extension;
+  }
+  if (extension === 'f32' || extension === 'bin' || extension === 'raw') {
+    return 'raw';
+  }
+
+  throw new ValidationError(`Cannot infer the vector file format of ${path}; pass { format: 'fvecs' | 'npy' | 'raw' }`, {
+    details: { path },
+  });
+}
+
 function buildNativeConfig(config, indexType) {
   const nativeConfig = { dims: config.dims };
+  if (config.idMap) {
+    nativeConfig.idMap = true;
+  }
 
   if (config.factory !== undefined) {
     nativeConfig.factory = config.factory;
@@ -169,11 +269,14 @@ function buildNativeConfig(config, indexType) {
     if (config.nprobe !== undefined) {
       nativeConfig.nprobe = config.nprobe;
     }
+    if (config.kFactor !== undefined) {
+      nativeConfig.kFactor = config.kFactor;
+    }
     return nativeConfig;
   }
 
   nativeConfig.type = indexType;
-  for (const key of ['nlist', 'nprobe', 'M', 'efConstruction', 'efSearch', 'pqSegments', 'pqBits', 'sqType', 'metric']) {
+  for (const key of ['nlist', 'nprobe', 'M', 'efConstruction', 'efSearch', 'pqSegments', 'pqBits', 'sqType', 'metric', 'refine', 'kFactor']) {
     if (config[key] !== undefined) {
       nativeConfig[key] = config[key];
     }
@@ -233,7 +336,59 @@ function normalizeIdArray(ids, name = 'ids') {
   return Int32Array.from(values);
 }
 
+function normalizeIdArray64(ids, name = 'ids') {
+  let values;
+  if (ids instanceof BigInt64Array) {
+    values = ids;
+  } else if (ids instanceof Int32Array || ids instanceof Uint32Array || Array.isArray(ids)) {
+    values = ids;
+  } else {
+    throw new ValidationError(`${name} must be an array, BigInt64Array, Int32Array, or Uint32Array`);
+  }
+
+  if (values.length === 0) {
+    throw new ValidationError(`${name} cannot be empty`);
+  }
+
+  const normalized = new BigInt64Array(values.length);
+  for (let i = 0; i < values.length; i++) {
+    const value = values[i];
+    const valid = typeof value === 'bigint'
+      ? value >= 0n && value <= 0x7fffffffffffffffn
+      : Number.isSafeInteger(value) && value >= 0;
+    if (!valid) {
+      throw new ValidationError(`${name} must contain non-negative 64-bit integers`, {
+        details: { value: typeof value === 'bigint' ? value.toString() : value },
+      });
+    }
+    normalized[i] = BigInt(value);
+  }
+
+  return normalized;
+}
+
+// Search filters go to native as-is when already typed (native checks the sign),
+// so large allow lists are not re-encoded on every query.
+function normalizeFilterIds(ids, name) {
+  if (ids instanceof BigInt64Array || ids instanceof Int32Array) {
+    return ids;
+  }
+
+  if (Array.isArray(ids) && ids.length === 0) {
+    return new BigInt64Array(0);
+  }
+
+  return normalizeIdArray64(ids, name);
+}
+
 function toSingleId(id) {
+  if (typeof id === 'bigint') {
+    if (id < 0n || id > 0x7fffffffffffffffn) {
+      throw new ValidationError('id must be a non-negative 64-bit integer', { details: { id: id.toString() } });
+    }
+    return id;
+  }
+
   if (!Number.isInteger(id) || id < 0) {
     throw new ValidationError('id must be a non-negative integer', { details: { id } });
   }
@@ -321,12 +476,24 @@ class FaissIndex {
       validateIndexSpecificOptions(indexType, config);
     }
 
+    if (config.idMap !== undefined && typeof config.idMap !== 'boolean') {
+      throw new ValidationError('idMap must be a boolean', { details: { idMap: config.idMap } });
+    }
+
+    validateLabelType(config.labelType);
+    validateOptionalBoolean('borrowInputs', config.borrowInputs);
+    validateOptionalBoolean('validateInWorker', config.validateInWorker);
+    if (config.threads !== undefined) {
+      validateThreads(config.threads);
+    }
+    normalizeCoalesceOptions(config.coalesce);
     this._initializeRuntime(config);
 
     try {
       const nativeConfig = buildNativeConfig(config, indexType);
-      this._native = new FaissIndexWrapper(nativeConfig);
+      this._native = this._createNative(nativeConfig);
       this._syncStats(this._native.getStats());
+      this._applySearchCoalescing(config.coalesce);
     } catch (error) {
       throw wrapNativeError(error, {
         operation: 'constructor',
@@ -335,20 +502,109 @@ class FaissIndex {
     }
   }
 
+  _createNative(nativeConfig) {
+    return new FaissIndexWrapper(nativeConfig);
+  }
+
   _initializeRuntime(config = {}) {
     this._config = { ...config };
     this._debug = Boolean(config.debug);
     this._collectMetrics = config.collectMetrics !== false;
     this._logger = typeof config.logger === 'function' ? config.logger : defaultLogger;
     this._metadata = config.metadata || null;
+    validateLabelType(config.labelType);
+    this._labelType = config.labelType;
+    validateOptionalBoolean('borrowInputs', config.borrowInputs);
+    this._borrowInputs = config.borrowInputs === true;
+    validateOptionalBoolean('validateInWorker', config.validateInWorker);
+    this._validateInWorker = config.validateInWorker === true;
+    if (config.threads !== undefined) {
+      validateThreads(config.threads);
+    }
+    this._threads = config.threads;
     this.resetMetrics();
   }
 
+  _inputOptions(options) {
+    if (!options || typeof options !== 'object') {
+      throw new ValidationError('options must be an object');
+    }
+
+    validateOptionalBoolean('borrow', options.borrow);
+    validateOptionalBoolean('validateInWorker', options.validateInWorker);
+    const nativeOptions = {
+      borrow: options.borrow === undefined ? this._borrowInputs : options.borrow,
+      validate: this._validatesInWorker(options),
+    };
+
+    // OpenMP threads for this call; otherwise the index's config.threads, then setNumThreads()
+    const threads = options.threads === undefined ? this._threads : options.threads;
+    if (threads !== undefined) {
+      validateThreads(threads);
+      nativeOptions.threads = threads;
+    }
+    return nativeOptions;
+  }
+
+  // Whether the NaN/Infinity scan is left to the native worker instead of the calling thread
+  _validatesInWorker(options) {
+    if (options && typeof options === 'object' && typeof options.validateInWorker === 'boolean') {
+      return options.validateInWorker;
+    }
+    return this._validateInWorker;
+  }
+
+  _searchOptions(options) {
+    if (!options || typeof options !== 'object') {
+      throw new ValidationError('search options must be an object');
+    }
+
+    const labelType = options.labelType === undefined ? this._labelType : options.labelType;
+    validateLabelType(labelType);
+    const nativeOptions = this._inputOptions(options);
+    if (labelType !== undefined) {
+      nativeOptions.labelType = labelType;
+    }
+
+    // Per-call tuning is applied through FAISS SearchParameters, leaving the shared index untouched
+    for (const key of ['nprobe', 'efSearch', 'maxCodes']) {
+      if (options[key] !== undefined) {
+        validatePositiveInteger(key, options[key]);
+        nativeOptions[key] = options[key];
+      }
+    }
+    if (options.kFactor !== undefined) {
+      validateKFactor(options.kFactor);
+      nativeOptions.kFactor = options.kFactor;
+    }
+
+    const filters = ['allowIds', 'denyIds', 'bitmap'].filter((key) => options[key] !== undefined);
+    if (filters.length > 1) {
+      throw new ValidationError('Only one of allowIds, denyIds, or bitmap may be given', {
+        details: { filters },
+      });
+    }
+
+    if (options.allowIds !== undefined) {
+      nativeOptions.allowIds = normalizeFilterIds(options.allowIds, 'allowIds');
+    } else if (options.denyIds !== undefined) {
+      nativeOptions.denyIds = normalizeFilterIds(options.denyIds, 'denyIds');
+    } else if (options.bitmap !== undefined) {
+      if (!(options.bitmap instanceof Uint8Array)) {
+        throw new ValidationError('bitmap must be a Uint8Array');
+      }
+      nativeOptions.bitmap = options.bitmap;
+    }
+    return nativeOptions;
+  }
+
   _syncStats(stats) {
     this._dims = stats.dims;
     this._type = stats.type;
     this._factory = stats.factory || null;
     this._metric = stats.metric;
+    this._idMap = Boolean(stats.idMap);
+    this._readOnly = Boolean(stats.readOnly);
   }
 
   _ensureActive() {
@@ -357,6 +613,16 @@ class FaissIndex {
     }
   }
 
+  _ensureWritable(operation) {
+    this._ensureActive();
+    if (this._readOnly) {
+      throw new UnsupportedOperationError(`${operation}() is not supported on a read-only index`, {
+        operation,
+        suggestion: 'Load the index without { mmap, readOnly } to modify it.',
+      });
+    }
+  }
+
   _debugLog(operation, message, extra = {}) {
     if (!this._debug) {
       return;
@@ -442,7 +708,7 @@ class FaissIndex {
     }
   }
 
-  _validateVectorArray(name, vectors, expectedCount = null) {
+  _validateVectorArray(name, vectors, expectedCount = null, options = null) {
     ensureFloat32Array(name, vectors);
 
     if (vectors.length === 0) {
@@ -457,6 +723,15 @@ class FaissIndex {
       );
     }
 
+    if (options && this._validatesInWorker(options)) {
+      return count;
+    }
+
+    // The native scan settles the common all-finite case; the full report is only built on failure
+    if (vectorKernels && vectorKernels.findNonFinite(vectors) === -1) {
+      return count;
+    }
+
     const report = validateVectors(vectors, this._dims);
     if (report.hasNaNOrInfinity) {
       throw new InvalidVectorError(`${name} contains NaN or Infinity values`, { details: report });
@@ -493,60 +768,190 @@ class FaissIndex {
     return this.getStats().ntotal;
   }
 
-  async add(vectors, ids) {
-    this._ensureActive();
-    if (ids !== undefined) {
+  _normalizeAddIds(ids, vectorCount) {
+    if (ids === undefined || ids === null) {
+      if (this._idMap) {
+        throw new ValidationError('ids are required when adding to an idMap index');
+      }
+      return null;
+    }
+
+    if (!this._idMap) {
       throw new UnsupportedOperationError(
-        'Explicit vector ids are not supported by this wrapper yet',
-        { suggestion: 'Use sequential internal ids, or wrap the underlying FAISS index with an ID map in a future revision.' }
+        'Explicit vector ids require an index created with idMap: true',
+        { suggestion: 'Create the index with { idMap: true } to store your own 64-bit ids.' }
       );
     }
 
-    const vectorCount = this._validateVectorArray('vectors', vectors);
+    const normalized = normalizeIdArray64(ids);
+    if (normalized.length !== vectorCount) {
+      throw new ValidationError(
+        `ids length must match the number of vectors. Got ${normalized.length}, expected ${vectorCount}`,
+        { details: { ids: normalized.length, vectorCount } }
+      );
+    }
+
+    return normalized;
+  }
+
+  async add(vectors, ids, options = {}) {
+    this._ensureWritable('add');
+    const vectorCount = this._validateVectorArray('vectors', vectors, null, options);
+    const normalizedIds = this._normalizeAddIds(ids, vectorCount);
+    const nativeOptions = this._inputOptions(options);
+
     return this._runAsync('add', async () => {
-      await this._native.add(vectors);
+      if (normalizedIds) {
+        await this._native.addWithIds(vectors, normalizedIds, nativeOptions);
+      } else {
+        await this._native.add(vectors, nativeOptions);
+      }
     }, { vectorCount });
   }
 
+  /**
+   * Adds vectors in batches of `batchSize` on a native worker, calling onProgress
+   * after each batch. Each batch is one parallel FAISS add (HNSW inserts it across
+   * OpenMP threads) and takes the write lock on its own, so searches run in between.
+   * Aborting `signal` stops the add before the next batch; batches already added stay.
+   */
   async addWithProgress(vectors, options = {}) {
-    this._ensureActive();
-    const vectorCount = this._validateVectorArray('vectors', vectors);
+    this._ensureWritable('addWithProgress');
+    const vectorCount = this._validateVectorArray('vectors', vectors, null, options);
     const batchSize = options.batchSize || 10000;
     validatePositiveInteger('batchSize', batchSize);
+    if (options.onProgress !== undefined && typeof options.onProgress !== 'function') {
+      throw new ValidationError('onProgress must be a function');
+    }
+    const { signal } = options;
+    if (signal !== undefined && !(signal instanceof AbortSignal)) {
+      throw new ValidationError('signal must be an AbortSignal');
+    }
+    if (signal && signal.aborted) {
+      throw signal.reason;
+    }
 
-    const chunks = splitVectors(vectors, this._dims, batchSize);
-    const totalVectors = vectorCount;
-    let processed = 0;
+    const ids = this._normalizeAddIds(options.ids, vectorCount);
+    const nativeOptions = this._inputOptions(options);
 
-    return this._runAsync('addWithProgress', async () => {
-      for (let i = 0; i < chunks.length; i++) {
-        await this._native.add(chunks[i]);
-        processed += chunks[i].length / this._dims;
-
-        if (typeof options.onProgress === 'function') {
-          options.onProgress({
-            operation: 'add',
-            batch: i + 1,
-            totalBatches: chunks.length,
-            processed,
-            total: totalVectors,
-            percentage: totalVectors === 0 ? 100 : (processed / totalVectors) * 100,
-          });
-        }
+    try {
+      return await this._runAsync('addWithProgress', async () => {
+        await this._addInBatches(vectors, ids, batchSize, nativeOptions, options.onProgress, signal);
+      }, { vectorCount, batchSize });
+    } catch (error) {
+      if (signal && signal.aborted) {
+        throw signal.reason;
       }
-    }, { vectorCount: totalVectors, batchSize });
+      throw error;
+    }
   }
 
-  async train(vectors) {
-    this._ensureActive();
-    const vectorCount = this._validateVectorArray('vectors', vectors);
+  _addInBatches(vectors, ids, batchSize, nativeOptions, onProgress, signal) {
+    return this._native.addWithProgress(vectors, ids, { ...nativeOptions, batchSize, onProgress, signal });
+  }
+
+  async addFromFile(path, options = {}) {
+    this._ensureWritable('addFromFile');
+    validateNonEmptyString('path', path);
+    if (!options || typeof options !== 'object') {
+      throw new ValidationError('options must be an object');
+    }
+    if (this._idMap) {
+      throw new ValidationError('addFromFile cannot supply ids; use add(vectors, ids) for idMap indexes');
+    }
+
+    const format = options.format === undefined ? inferVectorFileFormat(path) : options.format;
+    if (!VECTOR_FILE_FORMATS.has(format)) {
+      throw new ValidationError(`format must be one of: ${Array.from(VECTOR_FILE_FORMATS).join(', ')}`, {
+        details: { format },
+      });
+    }
+
+    const batchSize = options.batchSize === undefined ? 10000 : options.batchSize;
+    validatePositiveInteger('batchSize', batchSize);
+    if (options.onProgress !== undefined && typeof options.onProgress !== 'function') {
+      throw new ValidationError('onProgress must be a function');
+    }
+
+    const nativeOptions = { format, batchSize };
+    if (options.onProgress) {
+      nativeOptions.onProgress = options.onProgress;
+    }
+
+    return this._runAsync('addFromFile', () => this._native.addFromFile(path, nativeOptions), {
+      details: { path, format, batchSize },
+      suggestion: 'Check that the file exists and holds float32 vectors with the index dimensions.',
+    });
+  }
+
+  createIngestStream(options = {}) {
+    this._ensureWritable('createIngestStream');
+    if (!options || typeof options !== 'object') {
+      throw new ValidationError('options must be an object');
+    }
+    if (this._idMap) {
+      throw new ValidationError('createIngestStream cannot supply ids; use add(vectors, ids) for idMap indexes');
+    }
+
+    validateOptionalBoolean('validate', options.validate);
+    validateOptionalBoolean('normalize', options.normalize);
+    const queueDepth = options.queueDepth === undefined ? 4 : options.queueDepth;
+    validatePositiveInteger('queueDepth', queueDepth);
+
+    const pipeline = this._native.createIngestPipeline({
+      validate: options.validate !== false,
+      normalize: options.normalize === true,
+      queueDepth,
+    });
+    const dims = this._dims;
+    const start = process.hrtime.bigint();
+    const fail = (error) => wrapNativeError(error, {
+      operation: 'createIngestStream',
+      details: { added: pipeline.getAdded() },
+    });
+
+    // Each written chunk is copied into the native pipeline; write callbacks complete
+    // once the pipeline has room, which is how backpressure reaches the producer.
+    const stream = new Writable({
+      objectMode: true,
+      highWaterMark: queueDepth,
+      write: (chunk, _encoding, callback) => {
+        if (!(chunk instanceof Float32Array) || chunk.length === 0 || chunk.length % dims !== 0) {
+          callback(new ValidationError(`Ingest chunks must be Float32Arrays holding a multiple of ${dims} values`, {
+            details: { length: chunk && chunk.length },
+          }));
+          return;
+        }
+        pipeline.push(chunk).then(() => callback(), (error) => callback(fail(error)));
+      },
+      final: (callback) => {
+        pipeline.finish().then((added) => {
+          stream.added = added;
+          const durationMs = Number(process.hrtime.bigint() - start) / 1e6;
+          this._recordMetric('createIngestStream', durationMs, { vectorCount: added });
+          callback();
+        }, (error) => callback(fail(error)));
+      },
+      destroy: (error, callback) => {
+        pipeline.abort();
+        callback(error);
+      },
+    });
+    stream.added = 0;
+    return stream;
+  }
+
+  async train(vectors, options = {}) {
+    this._ensureWritable('train');
+    const vectorCount = this._validateVectorArray('vectors', vectors, null, options);
+    const nativeOptions = this._inputOptions(options);
     return this._runAsync('train', async () => {
-      await this._native.train(vectors);
+      await this._native.train(vectors, nativeOptions);
     }, { vectorCount });
   }
 
   async trainWithProgress(vectors, options = {}) {
-    this._ensureActive();
+    this._ensureWritable('trainWithProgress');
     const vectorCount = this._validateVectorArray('vectors', vectors);
     const notify = typeof options.onProgress === 'function' ? options.onProgress : null;
 
@@ -573,13 +978,36 @@ class FaissIndex {
     return this._runSync('setNprobe', () => this._native.setNprobe(nprobe), { nprobe });
   }
 
-  async search(query, k) {
+  setSearchCoalescing(options) {
+    this._ensureActive();
+    const normalized = normalizeCoalesceOptions(options);
+    this._runSync('setSearchCoalescing', () => this._applySearchCoalescing(normalized), {
+      coalesce: normalized,
+    });
+    this._config.coalesce = normalized || false;
+  }
+
+  _applySearchCoalescing(options) {
+    const normalized = normalizeCoalesceOptions(options);
+    if (!normalized) {
+      this._native.setSearchCoalescing(null);
+      return;
+    }
+
+    this._native.setSearchCoalescing({
+      maxBatchSize: normalized.maxBatchSize,
+      windowUs: Math.round(normalized.windowMs * 1000),
+    });
+  }
+
+  async search(query, k, options = {}) {
     this._ensureActive();
-    this._validateVectorArray('query', query, 1);
+    this._validateVectorArray('query', query, 1, options);
     validatePositiveInteger('k', k);
+    const nativeOptions = this._searchOptions(options);
 
     return this._runAsync('search', async () => {
-      const results = await this._native.search(query, k);
+      const results = await this._native.search(query, k, nativeOptions);
       return {
         distances: results.distances,
         labels: results.labels,
@@ -587,13 +1015,14 @@ class FaissIndex {
     }, { k });
   }
 
-  async searchBatch(queries, k) {
+  async searchBatch(queries, k, options = {}) {
     this._ensureActive();
-    const nq = this._validateVectorArray('queries', queries);
+    const nq = this._validateVectorArray('queries', queries, null, options);
     validatePositiveInteger('k', k);
+    const nativeOptions = this._searchOptions(options);
 
     return this._runAsync('searchBatch', async () => {
-      const results = await this._native.searchBatch(queries, k);
+      const results = await this._native.searchBatch(queries, k, nativeOptions);
       return {
         distances: results.distances,
         labels: results.labels,
@@ -603,16 +1032,17 @@ class FaissIndex {
     }, { k, nq });
   }
 
-  async rangeSearch(query, radius) {
+  async rangeSearch(query, radius, options = {}) {
     this._ensureActive();
-    this._validateVectorArray('query', query, 1);
+    this._validateVectorArray('query', query, 1, options);
 
     if (typeof radius !== 'number' || radius < 0 || !Number.isFinite(radius)) {
       throw new ValidationError('radius must be a non-negative finite number');
     }
+    const nativeOptions = this._searchOptions(options);
 
     return this._runAsync('rangeSearch', async () => {
-      const results = await this._native.rangeSearch(query, radius);
+      const results = await this._native.rangeSearch(query, radius, nativeOptions);
       return {
         distances: results.distances,
         labels: results.labels,
@@ -622,6 +1052,26 @@ class FaissIndex {
     }, { radius });
   }
 
+  async rangeSearchBatch(queries, radius, options = {}) {
+    this._ensureActive();
+    const nq = this._validateVectorArray('queries', queries, null, options);
+
+    if (typeof radius !== 'number' || radius < 0 || !Number.isFinite(radius)) {
+      throw new ValidationError('radius must be a non-negative finite number');
+    }
+    const nativeOptions = this._searchOptions(options);
+
+    return this._runAsync('rangeSearchBatch', async () => {
+      const results = await this._native.rangeSearchBatch(queries, radius, nativeOptions);
+      return {
+        distances: results.distances,
+        labels: results.labels,
+        nq: results.nq,
+        lims: results.lims,
+      };
+    }, { radius, nq });
+  }
+
   async reconstruct(id) {
     this._ensureActive();
     const normalizedId = toSingleId(id);
@@ -631,13 +1081,26 @@ class FaissIndex {
     });
   }
 
-  async reconstructBatch(ids) {
+  async reconstructBatch(ids, output) {
     this._ensureActive();
-    const normalizedIds = normalizeIdArray(ids);
-    return this._runAsync('reconstructBatch', () => this._native.reconstructBatch(normalizedIds), {
+    const normalizedIds = this._idMap ? normalizeIdArray64(ids) : normalizeIdArray(ids);
+    const needed = normalizedIds.length * this._dims;
+    if (output !== undefined && output !== null) {
+      if (!(output instanceof Float32Array)) {
+        throw new ValidationError('output must be a Float32Array');
+      }
+      if (output.length < needed) {
+        throw new ValidationError(`output must hold at least ${needed} floats`, {
+          details: { required: needed, length: output.length },
+        });
+      }
+    }
+
+    const result = await this._runAsync('reconstructBatch', () => this._native.reconstructBatch(normalizedIds, output), {
       details: { count: normalizedIds.length },
       suggestion: 'Older IVF indexes saved without a FAISS direct map may need to be rebuilt before batch reconstruction works.',
     });
+    return result.length > needed ? result.subarray(0, needed) : result;
   }
 
   async getVectorById(id) {
@@ -645,8 +1108,8 @@ class FaissIndex {
   }
 
   async removeIds(ids) {
-    this._ensureActive();
-    const normalizedIds = normalizeIdArray(ids);
+    this._ensureWritable('removeIds');
+    const normalizedIds = this._idMap ? normalizeIdArray64(ids) : normalizeIdArray(ids);
     return this._runAsync('removeIds', async () => {
       return await this._native.removeIds(normalizedIds);
     }, {
@@ -660,6 +1123,9 @@ class FaissIndex {
     return this._runSync('getStats', () => {
       const stats = this._native.getStats();
       this._syncStats(stats);
+      if (this._threads !== undefined) {
+        stats.numThreads = this._threads;
+      }
       return stats;
     });
   }
@@ -722,7 +1188,27 @@ class FaissIndex {
       message: `ntotal=${stats.ntotal}`,
     });
 
-    if (stats.ntotal > 0 && options.sampleSize !== 0) {
+    if (stats.ntotal > 0 && options.sampleSize !== 0 && stats.idMap) {
+      // Custom ids are not positional, so sample through search instead of reconstruct
+      try {
+        const results = await this.search(new Float32Array(this._dims), 1);
+        const passed = results.labels.length > 0 && results.labels[0] >= 0;
+        checks.push({
+          name: 'selfSearch',
+          passed,
+          message: passed ? 'search returned at least one label' : 'search returned no labels',
+        });
+        valid = valid && passed;
+      } catch (error) {
+        valid = false;
+        checks.push({
+          name: 'selfSearch',
+          passed: false,
+          message: error.message,
+        });
+        warnings.push(`Could not run validation search: ${error.message}`);
+      }
+    } else if (stats.ntotal > 0 && options.sampleSize !== 0) {
       const sampleSize = Math.min(options.sampleSize || 3, stats.ntotal);
       const sampleIds = [];
       const step = Math.max(1, Math.floor(stats.ntotal / sampleSize));
@@ -785,10 +1271,19 @@ class FaissIndex {
   }
 
   reset() {
-    this._ensureActive();
+    this._ensureWritable('reset');
     return this._runSync('reset', () => this._native.reset());
   }
 
+  /**
+   * Like reset(), but frees the stored vectors on the background lane instead of the
+   * event loop. Calls submitted earlier see the index before or after the reset.
+   */
+  async resetAsync() {
+    this._ensureWritable('resetAsync');
+    return this._runAsync('resetAsync', () => this._native.resetAsync());
+  }
+
   dispose() {
     if (this._native) {
       try {
@@ -799,6 +1294,25 @@ class FaissIndex {
     }
   }
 
+  /**
+   * Graceful counterpart to dispose(): new calls fail straight away, calls already
+   * submitted run to completion, and the index is then freed off the event loop.
+   * Resolves once the memory has been released.
+   */
+  async disposeAsync() {
+    const native = this._native;
+    if (!native) {
+      return;
+    }
+
+    this._native = null;
+    await this._runAsync('disposeAsync', () => native.disposeAsync());
+  }
+
+  async close() {
+    return this.disposeAsync();
+  }
+
   async save(filename) {
     this._ensureActive();
     validateNonEmptyString('filename', filename);
@@ -836,11 +1350,14 @@ class FaissIndex {
   }
 
   async mergeFrom(otherIndex) {
-    this._ensureActive();
+    this._ensureWritable('mergeFrom');
 
     if (!otherIndex || !otherIndex._native) {
       throw new ValidationError('otherIndex must be a valid FaissIndex');
     }
+    if (otherIndex instanceof FaissShardedIndex) {
+      throw unsupportedOnShards('mergeFrom');
+    }
 
     if (otherIndex._dims !== this._dims) {
       throw new DimensionMismatchError(
@@ -853,6 +1370,34 @@ class FaissIndex {
     }, { otherType: otherIndex._type });
   }
 
+  /**
+   * Replace this index with newIndex in one step, e.g. after retraining a copy. Calls
+   * already submitted finish on the previous index, new calls go to newIndex, and
+   * nothing waits for either. newIndex is consumed and behaves as disposed; the
+   * previous index is freed once its last running call completes.
+   */
+  swap(newIndex) {
+    this._ensureActive();
+    if (!(newIndex instanceof FaissIndex) || !newIndex._native) {
+      throw new ValidationError('newIndex must be an active FaissIndex');
+    }
+    if (newIndex === this) {
+      throw new ValidationError('Cannot swap an index with itself');
+    }
+    if (newIndex._dims !== this._dims) {
+      throw new DimensionMismatchError(
+        `Swapped index must have the same dimensions. Got ${newIndex._dims}, expected ${this._dims}`
+      );
+    }
+
+    this._runSync('swap', () => this._native.swap(newIndex._native), {
+      details: { type: newIndex._type },
+    });
+    newIndex._native = null;
+    this._syncStats(this._native.getStats());
+    return this;
+  }
+
   async toGpu(device = 0) {
     this._ensureActive();
     if (!Number.isInteger(device) || device < 0) {
@@ -886,18 +1431,24 @@ class FaissIndex {
   }
 
   static _fromNative(native, runtimeConfig = {}) {
-    const index = Object.create(FaissIndex.prototype);
+    const index = Object.create(this.prototype);
     index._native = native;
     index._initializeRuntime(runtimeConfig);
     index._syncStats(native.getStats());
+    index._applySearchCoalescing(runtimeConfig.coalesce);
     return index;
   }
 
   static async load(filename, runtimeConfig = {}) {
     validateNonEmptyString('filename', filename);
+    validateOptionalBoolean('mmap', runtimeConfig.mmap);
+    validateOptionalBoolean('readOnly', runtimeConfig.readOnly);
 
     try {
-      const native = FaissIndexWrapper.load(filename);
+      const native = FaissIndexWrapper.load(filename, {
+        mmap: runtimeConfig.mmap === true,
+        readOnly: runtimeConfig.readOnly === true,
+      });
       return FaissIndex._fromNative(native, runtimeConfig);
     } catch (error) {
       throw wrapNativeError(error, {
@@ -908,7 +1459,7 @@ class FaissIndex {
   }
 
   static async loadWithMetadata(filename, runtimeConfig = {}) {
-    const index = await FaissIndex.load(filename, runtimeConfig);
+    const index = await this.load(filename, runtimeConfig);
     index._metadata = await readJsonIfExists(`${filename}.meta.json`);
     return index;
   }
@@ -930,14 +1481,306 @@ class FaissIndex {
   }
 }
 
+// `await using index = new FaissIndex(...)` closes the index gracefully where supported
+if (typeof Symbol.asyncDispose === 'symbol') {
+  FaissIndex.prototype[Symbol.asyncDispose] = function asyncDispose() {
+    return this.disposeAsync();
+  };
+}
+
+function validateReplicas(replicas) {
+  if (replicas !== undefined && (!Number.isInteger(replicas) || replicas < 1 || replicas > 256)) {
+    throw new ValidationError('replicas must be an integer between 1 and 256', { details: { replicas } });
+  }
+}
+
+function unsupportedOnShards(operation) {
+  return new UnsupportedOperationError(`${operation}() is not supported on a sharded index`, {
+    operation,
+    suggestion: 'Use a single FaissIndex for this operation.',
+  });
+}
+
+/**
+ * An index split into `shards` id-mapped sub-indexes built from the same config. Each
+ * vector lives on the shard its id hashes to; searches run every shard in parallel and
+ * merge the per-shard top-k natively. Adds without ids draw consecutive ids from a
+ * shared counter. Labels are global ids.
+ *
+ * With `replicas: K` every shard is kept as K in-memory copies. Reads go to the least
+ * busy copy and writes roll through the copies one at a time, so searches keep running
+ * while the index is updated. `{ shards: 1, replicas: K }` is a replicated index.
+ *
+ * A shard can be rebuilt offline and swapped in with replaceShard() while searches
+ * continue. Range search, merges, swap(), file/stream ingest, coalescing and GPU
+ * transfer are not supported.
+ */
+class FaissShardedIndex extends FaissIndex {
+  constructor(config) {
+    if (!config || typeof config !== 'object') {
+      throw new ValidationError('Expected config object');
+    }
+    if (!Number.isInteger(config.shards) || config.shards < 1 || config.shards > 1024) {
+      throw new ValidationError('shards must be an integer between 1 and 1024', {
+        details: { shards: config.shards },
+      });
+    }
+    validateReplicas(config.replicas);
+    super(config);
+  }
+
+  _createNative(nativeConfig) {
+    return new FaissShardedIndexWrapper({
+      ...nativeConfig,
+      shards: this._config.shards,
+      replicas: this._config.replicas,
+    });
+  }
+
+  _normalizeAddIds(ids, vectorCount) {
+    if (ids === undefined || ids === null) {
+      return null;
+    }
+    return super._normalizeAddIds(ids, vectorCount);
+  }
+
+  _applySearchCoalescing(options) {
+    if (normalizeCoalesceOptions(options)) {
+      throw unsupportedOnShards('setSearchCoalescing');
+    }
+  }
+
+  setSearchCoalescing() {
+    throw unsupportedOnShards('setSearchCoalescing');
+  }
+
+  // Shards have no native batched add, so batches are awaited one by one from JS
+  async _addInBatches(vectors, ids, batchSize, nativeOptions, onProgress, signal) {
+    const chunks = splitVectors(vectors, this._dims, batchSize);
+    const total = vectors.length / this._dims;
+    const start = Date.now();
+    let processed = 0;
+
+    for (let i = 0; i < chunks.length; i++) {
+      if (signal && signal.aborted) {
+        throw signal.reason;
+      }
+      const chunkCount = chunks[i].length / this._dims;
+      if (ids) {
+        await this._native.addWithIds(chunks[i], ids.subarray(processed, processed + chunkCount), nativeOptions);
+      } else {
+        await this._native.add(chunks[i], nativeOptions);
+      }
+      processed += chunkCount;
+
+      if (onProgress) {
+        const elapsedMs = Date.now() - start;
+        onProgress({
+          operation: 'add',
+          batch: i + 1,
+          totalBatches: chunks.length,
+          processed,
+          total,
+          percentage: total === 0 ? 100 : (processed / total) * 100,
+          elapsedMs,
+          etaMs: processed >= total ? 0 : (elapsedMs * (total - processed)) / processed,
+        });
+      }
+    }
+  }
+
+  async addFromFile() {
+    throw unsupportedOnShards('addFromFile');
+  }
+
+  createIngestStream() {
+    throw unsupportedOnShards('createIngestStream');
+  }
+
+  async rangeSearch() {
+    throw unsupportedOnShards('rangeSearch');
+  }
+
+  async rangeSearchBatch() {
+    throw unsupportedOnShards('rangeSearchBatch');
+  }
+
+  async mergeFrom() {
+    throw unsupportedOnShards('mergeFrom');
+  }
+
+  swap() {
+    throw unsupportedOnShards('swap');
+  }
+
+  async toGpu() {
+    throw unsupportedOnShards('toGpu');
+  }
+
+  async toCpu() {
+    throw unsupportedOnShards('toCpu');
+  }
+
+  _validateShard(shard) {
+    const count = this._native.getStats().shards;
+    if (!Number.isInteger(shard) || shard < 0 || shard >= count) {
+      throw new ValidationError(`shard must be an integer between 0 and ${count - 1}`, {
+        details: { shard, shards: count },
+      });
+    }
+  }
+
+  /**
+   * Serialize one shard in the single-index format, e.g. to rebuild it with
+   * FaissIndex.fromBuffer and hand it back through replaceShard.
+   */
+  async shardToBuffer(shard) {
+    this._ensureActive();
+    this._validateShard(shard);
+    return this._runAsync('shardToBuffer', () => this._native.shardToBuffer(shard), { shard });
+  }
+
+  /**
+   * Swap in a rebuilt shard, given as a FaissIndex or its toBuffer() output, copied into
+   * every replica. The replacement must be id-mapped with the same dims and metric, and
+   * should only hold ids that route to this shard. Searches already running finish on
+   * the old shard.
+   */
+  async replaceShard(shard, replacement) {
+    this._ensureWritable('replaceShard');
+    this._validateShard(shard);
+    if (replacement instanceof FaissIndex && !(replacement instanceof FaissShardedIndex)) {
+      replacement = await replacement.toBuffer();
+    }
+    if (!Buffer.isBuffer(replacement)) {
+      throw new ValidationError('replacement must be a FaissIndex or a Node.js Buffer');
+    }
+
+    return this._runAsync('replaceShard', () => this._native.replaceShard(shard, replacement), {
+      shard,
+      suggestion: 'The replacement must be an idMap index with the same dimensions and metric.',
+    });
+  }
+
+  static async load(filename, runtimeConfig = {}) {
+    validateNonEmptyString('filename', filename);
+    validateReplicas(runtimeConfig.replicas);
+
+    try {
+      const native = FaissShardedIndexWrapper.load(filename, { replicas: runtimeConfig.replicas });
+      return FaissShardedIndex._fromNative(native, runtimeConfig);
+    } catch (error) {
+      throw wrapNativeError(error, {
+        operation: 'load',
+        suggestion: 'Verify the file was written by FaissShardedIndex.save().',
+      });
+    }
+  }
+
+  static async fromBuffer(buffer, runtimeConfig = {}) {
+    if (!Buffer.isBuffer(buffer)) {
+      throw new ValidationError('buffer must be a Node.js Buffer');
+    }
+
+    validateReplicas(runtimeConfig.replicas);
+
+    try {
+      const native = FaissShardedIndexWrapper.fromBuffer(buffer, { replicas: runtimeConfig.replicas });
+      return FaissShardedIndex._fromNative(native, runtimeConfig);
+    } catch (error) {
+      throw wrapNativeError(error, {
+        operation: 'fromBuffer',
+        suggestion: 'Verify the buffer was produced by FaissShardedIndex.toBuffer().',
+      });
+    }
+  }
+}
+
+/**
+ * Set the OpenMP thread count each FAISS call uses, process-wide. Every executor
+ * thread runs its own OpenMP team, so several concurrent calls at full width
+ * oversubscribe the CPU; pass 1 for latency-sensitive single-query traffic. 0 restores the OpenMP
+ * default (OMP_NUM_THREADS, or one per core). A per-call or per-index `threads`
+ * option overrides it.
+ *
+ * @param {number} threads
+ */
+function setNumThreads(threads) {
+  if (!Number.isInteger(threads) || threads < 0) {
+    throw new ValidationError('threads must be a non-negative integer', { details: { threads } });
+  }
+  if (threads > 1) {
+    validateThreads(threads);
+  }
+  native.setNumThreads(threads);
+}
+
+/**
+ * @returns {{ threads: number, configured: number, openmp: boolean }} The effective thread
+ *   count, the value given to setNumThreads (0 when unset), and whether the addon was built
+ *   with OpenMP (without it every call runs on one thread)
+ */
+function getNumThreads() {
+  return native.getNumThreads();
+}
+
+/**
+ * @typedef {Object} ExecutorLaneStats
+ * @property {number} threads - Configured lane size
+ * @property {number} activeThreads - Threads started so far (they start on demand)
+ * @property {number} queued - Calls waiting for a thread
+ * @property {number} running - Calls executing
+ * @property {number} completed - Calls finished since startup
+ * @property {number} avgWaitMs - Mean time a call spent queued
+ * @property {number} maxWaitMs - Longest time a call spent queued
+ */
+
+/**
+ * Resize the native executor lanes. Index work runs on its own threads rather than the
+ * libuv pool: searches, reconstructs and distance kernels on the interactive lane;
+ * add, train, save, merge and removal on the background lane. Defaults come from
+ * FAISS_NODE_INTERACTIVE_THREADS and FAISS_NODE_BACKGROUND_THREADS when set.
+ *
+ * @param {{ interactive?: number, background?: number }} options - Threads per lane (1-4096)
+ */
+function configureExecutor(options) {
+  if (!options || typeof options !== 'object') {
+    throw new ValidationError('configureExecutor expects an options object');
+  }
+  for (const lane of ['interactive', 'background']) {
+    const threads = options[lane];
+    if (threads !== undefined && (!Number.isInteger(threads) || threads < 1 || threads > 4096)) {
+      throw new ValidationError(`${lane} must be an integer between 1 and 4096`, { details: { [lane]: threads } });
+    }
+  }
+  native.configureExecutor(options);
+}
+
+/**
+ * @returns {{ interactive: ExecutorLaneStats, background: ExecutorLaneStats }} Per-lane
+ *   size, queue depth and time spent queued
+ */
+function getExecutorStats() {
+  return native.getExecutorStats();
+}
+
 module.exports = {
   FaissIndex,
+  FaissShardedIndex,
   FaissBinaryIndex,
   normalizeVectors,
   validateVectors,
   splitVectors,
   computeDistances,
+  pairwiseDistances,
+  knn,
+  hammingDistances,
+  hammingKnn,
   validateBinaryVectors,
+  setNumThreads,
+  getNumThreads,
+  configureExecutor,
+  getExecutorStats,
   FaissError,
   ValidationError,
   DimensionMismatchError,
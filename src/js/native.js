@@ -0,0 +1,15 @@
+// Loads the compiled addon once for every module (path may vary based on build system).
+// Exports null when it has not been built, so the pure-JS helpers in utils.js keep
+// working; index.js and binary.js report the missing build themselves.
+function loadNative() {
+  for (const path of ['../../build/Release/faiss_node.node', '../../build/faiss_node.node']) {
+    try {
+      return require(path);
+    } catch (e) {
+      // Try the next build layout
+    }
+  }
+  return null;
+}
+
+module.exports = loadNative();
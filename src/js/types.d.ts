@@ -1,3 +1,5 @@
+import { Writable } from 'stream';
+
 export interface FaissIndexConfig {
   type?: 'FLAT_L2' | 'FLAT_IP' | 'IVF_FLAT' | 'HNSW' | 'PQ' | 'IVF_PQ' | 'IVF_SQ';
   factory?: string;
@@ -11,12 +13,43 @@ export interface FaissIndexConfig {
   pqSegments?: number;
   pqBits?: number;
   sqType?: string;
+  /** Re-rank candidates against 'Flat' (exact) vectors or a finer codec such as 'SQ8'. PQ, IVF_PQ, IVF_SQ only. */
+  refine?: 'Flat' | 'SQ8' | string;
+  /** Candidates re-ranked per query, as a multiple of k (default 4 with refine). */
+  kFactor?: number;
+  idMap?: boolean;
+  labelType?: LabelType;
+  coalesce?: boolean | SearchCoalescingOptions;
+  borrowInputs?: boolean;
+  /** Default for the per-call validateInWorker option. */
+  validateInWorker?: boolean;
+  /** Default for the per-call threads option. */
+  threads?: number;
   debug?: boolean;
   collectMetrics?: boolean;
   logger?: (entry: unknown) => void;
   metadata?: Record<string, unknown>;
 }
 
+export interface IngestStreamOptions {
+  /** Reject chunks containing NaN or Infinity (default true). */
+  validate?: boolean;
+  /** L2-normalize each vector before adding it (default false). */
+  normalize?: boolean;
+  /** Chunks buffered between pipeline stages (default 4). */
+  queueDepth?: number;
+}
+
+export interface IngestStream extends Writable {
+  /** Vectors added, set once the stream finishes. */
+  added: number;
+}
+
+export interface SearchCoalescingOptions {
+  maxBatchSize?: number;
+  windowMs?: number;
+}
+
 export interface FaissBinaryIndexConfig {
   type?: 'BINARY_FLAT' | 'BINARY_HNSW' | 'BINARY_IVF' | 'BINARY_HASH';
   factory?: string;
@@ -37,9 +70,42 @@ export interface FaissBinaryIndexConfig {
 
 export interface SearchResults {
   distances: Float32Array;
-  labels: Int32Array;
+  /** BigInt64Array for labelType 'bigint', the default when the index was created with idMap. */
+  labels: Int32Array | BigInt64Array;
+}
+
+export type LabelType = 'int32' | 'bigint';
+
+export interface InputOptions {
+  /** Pin the caller's Float32Array instead of copying it. Do not mutate or transfer it until the promise settles. */
+  borrow?: boolean;
+  /** Check for NaN/Infinity on the worker thread instead of before the call is queued. */
+  validateInWorker?: boolean;
+  /** OpenMP threads FAISS may use for this call (coalesced searches use the process-wide setting). */
+  threads?: number;
 }
 
+export interface SearchOptions extends InputOptions {
+  /** 'bigint' returns labels as a BigInt64Array backed by the native result buffer. */
+  labelType?: LabelType;
+  /** IVF lists to visit for this call only; the index's nprobe is unchanged. */
+  nprobe?: number;
+  /** IVF cap on codes scanned per query for this call. */
+  maxCodes?: number;
+  /** HNSW search breadth for this call only. */
+  efSearch?: number;
+  /** Refine-stage candidate multiple for this call only. */
+  kFactor?: number;
+  /** Only return these labels. Mutually exclusive with denyIds and bitmap. */
+  allowIds?: VectorIds;
+  /** Never return these labels. */
+  denyIds?: VectorIds;
+  /** Packed filter: label i is kept when bit (i & 7) of byte (i >> 3) is set. */
+  bitmap?: Uint8Array;
+}
+
+export type VectorIds = BigInt64Array | Int32Array | Uint32Array | Array<number | bigint>;
+
 export interface BatchSearchResults extends SearchResults {
   nq: number;
   k: number;
@@ -57,11 +123,19 @@ export interface BinaryBatchSearchResults extends BinarySearchResults {
 
 export interface RangeSearchResults {
   distances: Float32Array;
-  labels: Int32Array;
+  labels: Int32Array | BigInt64Array;
   nq: number;
   lims: Uint32Array;
 }
 
+export interface RangeSearchBatchResults {
+  distances: Float32Array;
+  labels: Int32Array | BigInt64Array;
+  nq: number;
+  /** nq + 1 offsets; query i's results are at [lims[i], lims[i + 1]). */
+  lims: BigUint64Array;
+}
+
 export interface IndexStats {
   ntotal: number;
   dims: number;
@@ -69,6 +143,20 @@ export interface IndexStats {
   type: string;
   factory: string;
   metric: 'l2' | 'ip';
+  idMap: boolean;
+  readOnly: boolean;
+  mmap: boolean;
+  /** Refine-stage candidate multiple, or null without a refine stage. */
+  kFactor: number | null;
+  /** OpenMP threads each FAISS call uses without a per-call threads option. */
+  numThreads: number;
+}
+
+export interface LoadOptions {
+  /** Map IVF list data from the file instead of reading it into heap. Implies readOnly. */
+  mmap?: boolean;
+  /** Reject add, train, removeIds, reset, and mergeFrom on the loaded index. */
+  readOnly?: boolean;
 }
 
 export interface BinaryIndexStats {
@@ -79,6 +167,7 @@ export interface BinaryIndexStats {
   type: string;
   factory: string;
   metric: 'hamming';
+  numThreads: number;
 }
 
 export interface OperationMetricEntry {
@@ -115,6 +204,10 @@ export interface ProgressUpdate {
   processed?: number;
   total?: number;
   percentage?: number;
+  /** Time since the operation started (native adds). */
+  elapsedMs?: number;
+  /** Remaining time extrapolated from the rate so far (native adds). */
+  etaMs?: number;
 }
 
 export interface ValidationCheck {
@@ -180,28 +273,42 @@ export declare class BinaryVectorError extends ValidationError {}
 export declare class FaissIndex {
   constructor(config: FaissIndexConfig);
 
-  add(vectors: Float32Array, ids?: Int32Array): Promise<void>;
-  addWithProgress(vectors: Float32Array, options?: {
+  add(vectors: Float32Array, ids?: VectorIds | null, options?: InputOptions): Promise<void>;
+  /** Adds natively in batches of batchSize with per-batch progress; abort stops before the next batch. */
+  addWithProgress(vectors: Float32Array, options?: InputOptions & {
+    ids?: VectorIds;
     batchSize?: number;
     onProgress?: (update: ProgressUpdate) => void;
+    signal?: AbortSignal;
   }): Promise<void>;
+  /** Streams float32 vectors from disk into the index natively; resolves to the number added. */
+  addFromFile(path: string, options?: {
+    /** Inferred from the extension (.fvecs, .npy, .f32/.bin/.raw) when omitted. */
+    format?: 'fvecs' | 'npy' | 'raw';
+    batchSize?: number;
+    onProgress?: (update: ProgressUpdate) => void;
+  }): Promise<number>;
+  /** Writable that validates and adds Float32Array chunks on native threads. */
+  createIngestStream(options?: IngestStreamOptions): IngestStream;
 
-  train(vectors: Float32Array): Promise<void>;
+  train(vectors: Float32Array, options?: InputOptions): Promise<void>;
   trainWithProgress(vectors: Float32Array, options?: {
     onProgress?: (update: ProgressUpdate) => void;
   }): Promise<void>;
 
-  search(query: Float32Array, k: number): Promise<SearchResults>;
-  searchBatch(queries: Float32Array, k: number): Promise<BatchSearchResults>;
-  rangeSearch(query: Float32Array, radius: number): Promise<RangeSearchResults>;
+  search(query: Float32Array, k: number, options?: SearchOptions): Promise<SearchResults>;
+  searchBatch(queries: Float32Array, k: number, options?: SearchOptions): Promise<BatchSearchResults>;
+  rangeSearch(query: Float32Array, radius: number, options?: SearchOptions): Promise<RangeSearchResults>;
+  rangeSearchBatch(queries: Float32Array, radius: number, options?: SearchOptions): Promise<RangeSearchBatchResults>;
 
-  reconstruct(id: number): Promise<Float32Array>;
-  reconstructBatch(ids: number[] | Int32Array | Uint32Array): Promise<Float32Array>;
-  removeIds(ids: number[] | Int32Array | Uint32Array): Promise<number>;
-  getVectorById(id: number): Promise<Float32Array>;
+  reconstruct(id: number | bigint): Promise<Float32Array>;
+  reconstructBatch(ids: VectorIds, output?: Float32Array): Promise<Float32Array>;
+  removeIds(ids: VectorIds): Promise<number>;
+  getVectorById(id: number | bigint): Promise<Float32Array>;
   getVectorCount(): number;
 
   setNprobe(nprobe: number): void;
+  setSearchCoalescing(options: boolean | SearchCoalescingOptions): void;
   getStats(): IndexStats;
   getConfig(): Record<string, unknown>;
   getMetrics(): IndexMetrics;
@@ -211,21 +318,58 @@ export declare class FaissIndex {
   setDebug(enabled: boolean): void;
 
   reset(): void;
+  /** reset() with the memory freed off the event loop. */
+  resetAsync(): Promise<void>;
   save(filename: string): Promise<void>;
   saveMetadata(filename: string, extra?: Record<string, unknown>): Promise<string>;
   saveWithMetadata(filename: string, extra?: Record<string, unknown>): Promise<string>;
   toBuffer(): Promise<Buffer>;
   mergeFrom(otherIndex: FaissIndex): Promise<void>;
+  /** Replace this index with newIndex; running calls finish on the old one. Consumes newIndex. */
+  swap(newIndex: FaissIndex): this;
   toGpu(device?: number): Promise<FaissIndex>;
   toCpu(): Promise<FaissIndex>;
   dispose(): void;
+  /** Rejects new calls, waits for submitted ones, then frees the index off the event loop. */
+  disposeAsync(): Promise<void>;
+  /** Alias for disposeAsync(). */
+  close(): Promise<void>;
 
-  static load(filename: string, runtimeConfig?: Partial<FaissIndexConfig>): Promise<FaissIndex>;
+  static load(filename: string, runtimeConfig?: Partial<FaissIndexConfig> & LoadOptions): Promise<FaissIndex>;
   static loadWithMetadata(filename: string, runtimeConfig?: Partial<FaissIndexConfig>): Promise<FaissIndex>;
   static fromBuffer(buffer: Buffer, runtimeConfig?: Partial<FaissIndexConfig>): Promise<FaissIndex>;
   static gpuSupport(): GpuSupportReport;
 }
 
+export interface FaissShardedIndexConfig extends FaissIndexConfig {
+  /** Number of id-mapped sub-indexes (1-1024), each built from the rest of the config. */
+  shards: number;
+  /** In-memory copies kept of each shard (1-256, default 1); reads go to the least busy copy. */
+  replicas?: number;
+}
+
+export interface ShardedIndexStats extends IndexStats {
+  shards: number;
+  /** Vectors held by each shard. */
+  shardSizes: number[];
+  replicas: number;
+  /** First id the next add() without ids will assign. */
+  nextId: number;
+}
+
+export declare class FaissShardedIndex extends FaissIndex {
+  constructor(config: FaissShardedIndexConfig);
+  /** Ids are optional; without them vectors get consecutive ids from nextId. */
+  add(vectors: Float32Array, ids?: VectorIds, options?: InputOptions): Promise<void>;
+  getStats(): ShardedIndexStats;
+  /** One shard in the single-index format, loadable with FaissIndex.fromBuffer. */
+  shardToBuffer(shard: number): Promise<Buffer>;
+  /** Swap in a rebuilt shard; in-flight searches finish on the old one. */
+  replaceShard(shard: number, replacement: FaissIndex | Buffer): Promise<void>;
+  static load(filename: string, runtimeConfig?: Partial<FaissShardedIndexConfig>): Promise<FaissShardedIndex>;
+  static fromBuffer(buffer: Buffer, runtimeConfig?: Partial<FaissShardedIndexConfig>): Promise<FaissShardedIndex>;
+}
+
 export declare class FaissBinaryIndex {
   constructor(config: FaissBinaryIndexConfig);
 
@@ -244,7 +388,7 @@ export declare class FaissBinaryIndex {
   searchBatch(queries: Uint8Array, k: number): Promise<BinaryBatchSearchResults>;
 
   reconstruct(id: number): Promise<Uint8Array>;
-  reconstructBatch(ids: number[] | Int32Array | Uint32Array): Promise<Uint8Array>;
+  reconstructBatch(ids: number[] | Int32Array | Uint32Array, output?: Uint8Array): Promise<Uint8Array>;
   removeIds(ids: number[] | Int32Array | Uint32Array): Promise<number>;
   getVectorById(id: number): Promise<Uint8Array>;
   getVectorCount(): number;
@@ -293,9 +437,49 @@ export declare function computeDistances(
   right: Float32Array,
   options: { dims: number; metric?: 'l2' | 'ip' | 'cosine' }
 ): Float32Array;
+/** Dense row-major n x m matrix comparing every left vector with every right vector. */
+export declare function pairwiseDistances(
+  left: Float32Array,
+  right: Float32Array,
+  options: { dims: number; metric?: 'l2' | 'ip' | 'cosine' }
+): Promise<Float32Array>;
+/** Exact kNN over plain arrays, read in place; do not modify them until the promise settles. */
+export declare function knn(
+  queries: Float32Array,
+  database: Float32Array,
+  k: number,
+  options: { dims: number; metric?: 'l2' | 'ip' | 'cosine'; labelType?: LabelType }
+): Promise<BatchSearchResults>;
 export declare function validateBinaryVectors(vectors: Uint8Array, dims: number): {
   valid: boolean;
   dims: number;
   vectorCount: number;
   bytesPerVector: number;
 };
+/** Dense row-major na x nb Hamming distance matrix; dims is bits per code. */
+export declare function hammingDistances(a: Uint8Array, b: Uint8Array, dims: number): Promise<Int32Array>;
+/** Exact Hamming kNN over plain code arrays, read in place; do not modify them until the promise settles. */
+export declare function hammingKnn(
+  queries: Uint8Array,
+  database: Uint8Array,
+  k: number,
+  options: { dims: number }
+): Promise<BinaryBatchSearchResults>;
+
+/** Process-wide OpenMP threads per FAISS call; 0 restores the OpenMP default. */
+export declare function setNumThreads(threads: number): void;
+/** `openmp` is false when the addon was built without OpenMP; thread counts above 1 are then rejected. */
+export declare function getNumThreads(): { threads: number; configured: number; openmp: boolean };
+
+export interface ExecutorLaneStats {
+  threads: number;
+  activeThreads: number;
+  queued: number;
+  running: number;
+  completed: number;
+  avgWaitMs: number;
+  maxWaitMs: number;
+}
+/** Resizes the native interactive (search) and background (add/train/save) lanes. */
+export declare function configureExecutor(options: { interactive?: number; background?: number }): void;
+export declare function getExecutorStats(): { interactive: ExecutorLaneStats; background: ExecutorLaneStats };
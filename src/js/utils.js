@@ -4,6 +4,13 @@ const {
   BinaryVectorError,
 } = require('./errors');
 
+// SIMD scans from the addon; the JS loops below are the fallback when it is unavailable
+const native = require('./native');
+
+const vectorKernels = native && native.vectorKernels ? native.vectorKernels : null;
+const NON_FINITE_FLAG = 1;
+const ZERO_FLAG = 2;
+
 /**
  * @typedef {Object} ValidateVectorsOptions
  * @property {boolean} [throwOnError=false]
@@ -33,6 +40,13 @@ const {
  * @property {'l2' | 'ip' | 'cosine'} [metric='l2']
  */
 
+/**
+ * @typedef {Object} KnnOptions
+ * @property {number} dims
+ * @property {'l2' | 'ip' | 'cosine'} [metric='l2'] ip and cosine rank by descending similarity
+ * @property {'int32' | 'bigint'} [labelType='int32']
+ */
+
 function ensurePositiveInteger(name, value) {
   if (!Number.isInteger(value) || value <= 0) {
     throw new TypeError(`${name} must be a positive integer`);
@@ -74,6 +88,16 @@ function normalizeVectors(vectors, dims) {
   const count = getVectorCount(vectors.length, dims);
   const normalized = new Float32Array(vectors.length);
 
+  if (vectorKernels) {
+    const bad = vectorKernels.normalizeL2(vectors, dims, normalized);
+    if (bad >= 0) {
+      throw new InvalidVectorError('Cannot normalize vectors with NaN or Infinity values', {
+        details: { vectorIndex: Math.floor(bad / dims), componentIndex: bad % dims, value: vectors[bad] },
+      });
+    }
+    return normalized;
+  }
+
   for (let i = 0; i < count; i++) {
     let norm = 0;
     const offset = i * dims;
@@ -116,9 +140,19 @@ function validateVectors(vectors, dims, options = {}) {
   const nonFinite = [];
   const invalidDimensions = [];
 
+  // With the native scan, only vectors it flags as non-finite are walked in JS
+  const flags = vectorKernels ? vectorKernels.scanVectors(vectors, dims) : null;
+
   for (let i = 0; i < count; i++) {
-    let norm = 0;
     const offset = i * dims;
+    if (flags && !(flags[i] & NON_FINITE_FLAG)) {
+      if (flags[i] & ZERO_FLAG) {
+        zeroNormIndices.push(i);
+      }
+      continue;
+    }
+
+    let norm = 0;
     for (let j = 0; j < dims; j++) {
       const value = vectors[offset + j];
       if (!Number.isFinite(value)) {
@@ -247,6 +281,98 @@ function computeDistances(left, right, options = {}) {
   return distances;
 }
 
+/**
+ * Compute the dense n x m distance matrix between every left and every right vector
+ * on a worker thread. `l2` distances are squared, as in computeDistances.
+ *
+ * @param {Float32Array} left
+ * @param {Float32Array} right
+ * @param {DistanceOptions} options
+ * @returns {Promise<Float32Array>} Row-major: entry i * m + j compares left[i] with right[j]
+ */
+async function pairwiseDistances(left, right, options = {}) {
+  ensureFloat32Array('left', left);
+  ensureFloat32Array('right', right);
+
+  const dims = options.dims;
+  ensurePositiveInteger('dims', dims);
+
+  const metric = options.metric || 'l2';
+  if (metric !== 'l2' && metric !== 'ip' && metric !== 'cosine') {
+    throw new TypeError('metric must be one of: l2, ip, cosine');
+  }
+
+  const leftCount = getVectorCount(left.length, dims);
+  const rightCount = getVectorCount(right.length, dims);
+
+  if (vectorKernels) {
+    return vectorKernels.pairwiseDistances(left, right, dims, metric);
+  }
+
+  const distances = new Float32Array(leftCount * rightCount);
+  for (let i = 0; rightCount > 0 && i < leftCount; i++) {
+    const row = computeDistances(left.subarray(i * dims, (i + 1) * dims), right, { dims, metric });
+    distances.set(row, i * rightCount);
+  }
+  return distances;
+}
+
+/**
+ * Exact k-nearest-neighbour search of `database` for each query, without building an
+ * index. Both arrays are read in place on a worker thread and must not be modified
+ * until the promise settles.
+ *
+ * @param {Float32Array} queries
+ * @param {Float32Array} database
+ * @param {number} k Clamped to the database size
+ * @param {KnnOptions} options
+ * @returns {Promise<{ distances: Float32Array, labels: Int32Array | BigInt64Array, nq: number, k: number }>}
+ *   The searchBatch layout: row i holds the k best database rows for query i, best first
+ */
+async function knn(queries, database, k, options = {}) {
+  ensureFloat32Array('queries', queries);
+  ensureFloat32Array('database', database);
+  ensurePositiveInteger('k', k);
+
+  const dims = options.dims;
+  ensurePositiveInteger('dims', dims);
+
+  const metric = options.metric || 'l2';
+  if (metric !== 'l2' && metric !== 'ip' && metric !== 'cosine') {
+    throw new TypeError('metric must be one of: l2, ip, cosine');
+  }
+
+  const labelType = options.labelType || 'int32';
+  if (labelType !== 'int32' && labelType !== 'bigint') {
+    throw new TypeError("labelType must be 'int32' or 'bigint'");
+  }
+
+  const nq = getVectorCount(queries.length, dims);
+  const nb = getVectorCount(database.length, dims);
+  if (nq === 0 || nb === 0) {
+    throw new InvalidVectorError('queries and database cannot be empty', { details: { nq, nb } });
+  }
+
+  if (vectorKernels) {
+    return vectorKernels.knn(queries, database, dims, k, metric, labelType === 'bigint');
+  }
+
+  const actualK = Math.min(k, nb);
+  const matrix = await pairwiseDistances(queries, database, { dims, metric });
+  const distances = new Float32Array(nq * actualK);
+  const labels = labelType === 'bigint' ? new BigInt64Array(nq * actualK) : new Int32Array(nq * actualK);
+  const order = metric === 'l2' ? (a, b) => a.d - b.d : (a, b) => b.d - a.d;
+
+  for (let i = 0; i < nq; i++) {
+    const row = Array.from(matrix.subarray(i * nb, (i + 1) * nb), (d, j) => ({ d, j })).sort(order);
+    for (let r = 0; r < actualK; r++) {
+      distances[i * actualK + r] = row[r].d;
+      labels[i * actualK + r] = labelType === 'bigint' ? BigInt(row[r].j) : row[r].j;
+    }
+  }
+  return { distances, labels, nq, k: actualK };
+}
+
 /**
  * Validate one or more binary vectors packed into a Uint8Array.
  *
@@ -280,11 +406,94 @@ function validateBinaryVectors(vectors, dims) {
   };
 }
 
+// Bits set in each byte value, for the JS Hamming fallback
+const POPCOUNT = Uint8Array.from({ length: 256 }, (_, byte) => {
+  let bits = 0;
+  for (let v = byte; v !== 0; v >>= 1) {
+    bits += v & 1;
+  }
+  return bits;
+});
+
+/**
+ * Compute the dense Hamming distance matrix between two sets of binary codes on a
+ * worker thread, without building a binary index.
+ *
+ * @param {Uint8Array} a
+ * @param {Uint8Array} b
+ * @param {number} dims Bits per code, a multiple of 8
+ * @returns {Promise<Int32Array>} Row-major: entry i * nb + j compares a[i] with b[j]
+ */
+async function hammingDistances(a, b, dims) {
+  const { bytesPerVector, vectorCount: na } = validateBinaryVectors(a, dims);
+  const { vectorCount: nb } = validateBinaryVectors(b, dims);
+
+  if (vectorKernels) {
+    return vectorKernels.hammingDistances(a, b, dims);
+  }
+
+  const distances = new Int32Array(na * nb);
+  for (let i = 0; i < na; i++) {
+    for (let j = 0; j < nb; j++) {
+      let bits = 0;
+      for (let byte = 0; byte < bytesPerVector; byte++) {
+        bits += POPCOUNT[a[i * bytesPerVector + byte] ^ b[j * bytesPerVector + byte]];
+      }
+      distances[i * nb + j] = bits;
+    }
+  }
+  return distances;
+}
+
+/**
+ * Exact Hamming k-nearest-neighbour search over binary codes, without building a
+ * binary index. Both arrays are read in place on a worker thread and must not be
+ * modified until the promise settles.
+ *
+ * @param {Uint8Array} queries
+ * @param {Uint8Array} database
+ * @param {number} k Clamped to the database size
+ * @param {{ dims: number }} options dims is bits per code, a multiple of 8
+ * @returns {Promise<{ distances: Int32Array, labels: Int32Array, nq: number, k: number }>}
+ *   The FaissBinaryIndex searchBatch layout, nearest first
+ */
+async function hammingKnn(queries, database, k, options = {}) {
+  ensurePositiveInteger('k', k);
+  const dims = options.dims;
+  const { vectorCount: nq } = validateBinaryVectors(queries, dims);
+  const { vectorCount: nb } = validateBinaryVectors(database, dims);
+  if (nq === 0 || nb === 0) {
+    throw new BinaryVectorError('queries and database cannot be empty', { details: { nq, nb } });
+  }
+
+  if (vectorKernels) {
+    return vectorKernels.hammingKnn(queries, database, dims, k);
+  }
+
+  const actualK = Math.min(k, nb);
+  const matrix = await hammingDistances(queries, database, dims);
+  const distances = new Int32Array(nq * actualK);
+  const labels = new Int32Array(nq * actualK);
+  for (let i = 0; i < nq; i++) {
+    const row = Array.from(matrix.subarray(i * nb, (i + 1) * nb), (d, j) => ({ d, j }))
+      .sort((x, y) => x.d - y.d || x.j - y.j);
+    for (let r = 0; r < actualK; r++) {
+      distances[i * actualK + r] = row[r].d;
+      labels[i * actualK + r] = row[r].j;
+    }
+  }
+  return { distances, labels, nq, k: actualK };
+}
+
 module.exports = {
   normalizeVectors,
   validateVectors,
   splitVectors,
   computeDistances,
+  pairwiseDistances,
+  knn,
   validateBinaryVectors,
+  hammingDistances,
+  hammingKnn,
   getVectorCount,
 };
@@ -0,0 +1,96 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { FaissIndex } = require('../../src/js/index');
+
+const dims = 4;
+const count = 25;
+
+function createVectors() {
+  const vectors = new Float32Array(count * dims);
+  for (let i = 0; i < vectors.length; i++) {
+    vectors[i] = (i % 13) / 7;
+  }
+  return vectors;
+}
+
+function writeFvecs(file, vectors) {
+  const buffer = Buffer.alloc((vectors.length / dims) * (4 + dims * 4));
+  for (let i = 0; i < vectors.length / dims; i++) {
+    const offset = i * (4 + dims * 4);
+    buffer.writeInt32LE(dims, offset);
+    for (let j = 0; j < dims; j++) {
+      buffer.writeFloatLE(vectors[i * dims + j], offset + 4 + j * 4);
+    }
+  }
+  fs.writeFileSync(file, buffer);
+}
+
+function writeNpy(file, vectors) {
+  let header = `{'descr': '<f4', 'fortran_order': False, 'shape': (${vectors.length / dims}, ${dims}), }`;
+  header += ' '.repeat(63 - ((10 + header.length) % 64)) + '\n';
+  const preamble = Buffer.alloc(10);
+  Buffer.from('\x93NUMPY', 'latin1').copy(preamble);
+  preamble[6] = 1;
+  preamble.writeUInt16LE(header.length, 8);
+  fs.writeFileSync(file, Buffer.concat([preamble, Buffer.from(header, 'latin1'), Buffer.from(vectors.buffer)]));
+}
+
+describe('addFromFile', () => {
+  const tempDir = fs.mkdtempSync(path.join(os.tmpdir(), 'faiss-add-from-file-'));
+  const vectors = createVectors();
+
+  afterAll(() => {
+    fs.rmSync(tempDir, { recursive: true, force: true });
+  });
+
+  test.each([
+    ['fvecs', 'base.fvecs', writeFvecs],
+    ['npy', 'base.npy', writeNpy],
+    ['raw', 'base.f32', (file, data) => fs.writeFileSync(file, Buffer.from(data.buffer))],
+  ])('streams %s files in batches', async (format, name, write) => {
+    const file = path.join(tempDir, name);
+    write(file, vectors);
+
+    const index = new FaissIndex({ type: 'FLAT_L2', dims });
+    const updates = [];
+    const added = await index.addFromFile(file, {
+      batchSize: 10,
+      onProgress: (update) => updates.push(update),
+    });
+
+    expect(added).toBe(count);
+    expect(index.getStats().ntotal).toBe(count);
+    expect(Array.from(await index.reconstructBatch([0, count - 1])))
+      .toEqual(Array.from(vectors.subarray(0, dims)).concat(Array.from(vectors.subarray((count - 1) * dims))));
+    expect(updates.map((update) => update.processed)).toEqual([10, 20, 25]);
+    expect(updates[2]).toMatchObject({ batch: 3, totalBatches: 3, total: count, percentage: 100 });
+    index.dispose();
+  });
+
+  test('rejects files that do not match the index', async () => {
+    const file = path.join(tempDir, 'wide.fvecs');
+    writeFvecs(file, vectors);
+
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 8 });
+    await expect(index.addFromFile(file)).rejects.toThrow(/dimension/);
+    await expect(index.addFromFile(path.join(tempDir, 'missing.npy'))).rejects.toThrow(/Cannot open/);
+    await expect(index.addFromFile(path.join(tempDir, 'base.txt'))).rejects.toThrow(/format/);
+    expect(index.getStats().ntotal).toBe(0);
+    index.dispose();
+  });
+
+  test('a throwing progress callback rejects the ingest', async () => {
+    const file = path.join(tempDir, 'stop.f32');
+    fs.writeFileSync(file, Buffer.from(vectors.buffer));
+
+    const index = new FaissIndex({ type: 'FLAT_L2', dims });
+    await expect(index.addFromFile(file, {
+      batchSize: 5,
+      onProgress: () => {
+        throw new Error('stop');
+      },
+    })).rejects.toThrow('stop');
+    index.dispose();
+  });
+});
@@ -64,6 +64,32 @@ describe('Additional index types', () => {
     expect(results.distances.length).toBe(5);
   });
 
+  test('re-ranks PQ candidates with an exact refine stage', async () => {
+    const index = new FaissIndex({ type: 'PQ', dims: 8, pqSegments: 2, pqBits: 4, refine: 'Flat', kFactor: 8 });
+    const stats = index.getStats();
+
+    expect(stats.type).toBe('PQ');
+    expect(stats.factory).toBe('PQ2x4,RFlat');
+    expect(stats.kFactor).toBe(8);
+
+    await index.train(createVectors(64, 8));
+    const vectors = createVectors(24, 8);
+    await index.add(vectors);
+
+    const query = vectors.slice(8, 16);
+    const results = await index.search(query, 3);
+    expect(results.distances[0]).toBeCloseTo(0, 5);
+    expect(Array.from(await index.reconstruct(results.labels[0]))).toEqual(Array.from(query));
+
+    const wide = await index.search(query, 3, { kFactor: 16 });
+    expect(wide.distances[0]).toBeCloseTo(0, 5);
+    expect(index.getStats().kFactor).toBe(8);
+
+    expect(() => new FaissIndex({ type: 'FLAT_L2', dims: 8, refine: 'Flat' })).toThrow(/refine/);
+    expect(() => new FaissIndex({ type: 'PQ', dims: 8, pqSegments: 2, kFactor: 4 })).toThrow(/requires refine/);
+    await expect(index.search(query, 3, { kFactor: 0.5 })).rejects.toThrow(/kFactor/);
+  });
+
   test('trains, adds, and searches with IVF_SQ', async () => {
     const index = new FaissIndex({
       type: 'IVF_SQ',
@@ -54,6 +54,61 @@ describe('Async Operations - Edge Cases (100+ cases)', () => {
             index.dispose();
         });
 
+        test('concurrent searches match sequential results', async () => {
+            const index = new FaissIndex({ dims: 8 });
+            const vectors = new Float32Array(500 * 8);
+            for (let i = 0; i < vectors.length; i++) {
+                vectors[i] = Math.random();
+            }
+            await index.add(vectors);
+
+            const queries = [];
+            for (let i = 0; i < 32; i++) {
+                queries.push(vectors.slice(i * 8, (i + 1) * 8));
+            }
+
+            const sequential = [];
+            for (const query of queries) {
+                sequential.push(await index.search(query, 5));
+            }
+            const concurrent = await Promise.all(queries.map(query => index.search(query, 5)));
+
+            concurrent.forEach((result, i) => {
+                expect(Array.from(result.labels)).toEqual(Array.from(sequential[i].labels));
+                expect(Array.from(result.distances)).toEqual(Array.from(sequential[i].distances));
+            });
+
+            index.dispose();
+        });
+
+        test('borrowed inputs give the same results as copied inputs', async () => {
+            const vectors = new Float32Array(200 * 8);
+            for (let i = 0; i < vectors.length; i++) {
+                vectors[i] = Math.random();
+            }
+            const queries = vectors.slice(0, 10 * 8);
+
+            const copied = new FaissIndex({ dims: 8 });
+            const borrowed = new FaissIndex({ dims: 8, borrowInputs: true });
+            await copied.add(vectors);
+            await borrowed.add(vectors);
+            expect(borrowed.getStats().ntotal).toBe(200);
+
+            const expected = await copied.searchBatch(queries, 5);
+            const actual = await borrowed.searchBatch(queries, 5);
+            const single = await copied.search(queries.subarray(0, 8), 5, { borrow: true });
+
+            expect(Array.from(actual.labels)).toEqual(Array.from(expected.labels));
+            expect(Array.from(actual.distances)).toEqual(Array.from(expected.distances));
+            expect(Array.from(single.labels)).toEqual(Array.from(expected.labels.subarray(0, 5)));
+
+            await expect(copied.add(vectors, null, { borrow: 'yes' })).rejects.toThrow('borrow must be a boolean');
+            expect(() => new FaissIndex({ dims: 8, borrowInputs: 1 })).toThrow('borrowInputs must be a boolean');
+
+            copied.dispose();
+            borrowed.dispose();
+        });
+
         test('concurrent add and search operations', async () => {
             const index = new FaissIndex({ dims: 4 });
             
@@ -225,4 +225,145 @@ describe('FaissIndex - Batch Search', () => {
       expect(results.labels.length).toBe(3);
     });
   });
+
+  describe('Label Types', () => {
+    test('returns BigInt64Array labels when labelType is bigint', async () => {
+      const queries = new Float32Array([
+        1, 0, 0, 0,
+        0, 0, 1, 0
+      ]);
+      const int32 = await index.searchBatch(queries, 3);
+      const bigint = await index.searchBatch(queries, 3, { labelType: 'bigint' });
+
+      expect(bigint.labels).toBeInstanceOf(BigInt64Array);
+      expect(bigint.distances).toBeInstanceOf(Float32Array);
+      expect(Array.from(bigint.labels, Number)).toEqual(Array.from(int32.labels));
+      expect(Array.from(bigint.distances)).toEqual(Array.from(int32.distances));
+    });
+
+    test('honours the index-level labelType and per-call overrides', async () => {
+      const bigintIndex = new FaissIndex({ type: 'FLAT_L2', dims, labelType: 'bigint' });
+      await bigintIndex.add(vectors);
+      const query = new Float32Array([0, 1, 0, 0]);
+
+      expect((await bigintIndex.search(query, 1)).labels).toBeInstanceOf(BigInt64Array);
+      expect((await bigintIndex.search(query, 1, { labelType: 'int32' })).labels).toBeInstanceOf(Int32Array);
+      expect((await bigintIndex.rangeSearch(query, 0.5)).labels).toBeInstanceOf(BigInt64Array);
+      bigintIndex.dispose();
+    });
+
+    test('rejects unknown label types', async () => {
+      await expect(index.search(new Float32Array([1, 0, 0, 0]), 1, { labelType: 'int64' })).rejects.toThrow();
+      expect(() => new FaissIndex({ dims, labelType: 'uint8' })).toThrow();
+    });
+  });
+
+  describe('Filtered Search', () => {
+    const query = new Float32Array([1, 0, 0, 0]);
+
+    test('allowIds and denyIds restrict the returned labels', async () => {
+      const allowed = await index.search(query, 2, { allowIds: [2, 3] });
+      expect(Array.from(allowed.labels).sort()).toEqual([2, 3]);
+
+      const denied = await index.search(query, 1, { denyIds: new Int32Array([0]) });
+      expect(Array.from(denied.labels)).toEqual([4]);
+
+      const batch = await index.searchBatch(new Float32Array([1, 0, 0, 0, 0, 1, 0, 0]), 1, { denyIds: [0, 1] });
+      expect(Array.from(batch.labels)).toEqual([4, 4]);
+    });
+
+    test('bitmap filters and pads unmatched slots with -1', async () => {
+      const bitmap = new Uint8Array(1);
+      bitmap[0] = 1 << 2;
+      const results = await index.search(query, 3, { bitmap });
+      expect(Array.from(results.labels)).toEqual([2, -1, -1]);
+
+      const range = await index.rangeSearch(query, 10, { bitmap });
+      expect(Array.from(range.labels)).toEqual([2]);
+
+      const none = await index.search(query, 2, { allowIds: [] });
+      expect(Array.from(none.labels)).toEqual([-1, -1]);
+    });
+
+    test('filters HNSW and idMap indexes by stored id', async () => {
+      const hnsw = new FaissIndex({ type: 'HNSW', dims, idMap: true });
+      await hnsw.add(vectors, [10n, 11n, 12n, 13n, 14n]);
+
+      const results = await hnsw.search(query, 1, { allowIds: [12n, 13n], labelType: 'int32' });
+      expect(Array.from(results.labels).every(id => id === 12 || id === 13)).toBe(true);
+
+      const bigint = await hnsw.search(query, 1, { denyIds: [10n] });
+      expect(bigint.labels[0]).toBe(14n);
+      hnsw.dispose();
+    });
+
+    test('rejects conflicting or malformed filters', async () => {
+      await expect(index.search(query, 1, { allowIds: [1], denyIds: [2] })).rejects.toThrow('Only one of');
+      await expect(index.search(query, 1, { bitmap: [1, 2] })).rejects.toThrow('bitmap must be a Uint8Array');
+      await expect(index.search(query, 1, { allowIds: [-1] })).rejects.toThrow();
+    });
+  });
+
+  describe('Search Coalescing', () => {
+    test('coalesced concurrent searches match individual searches', async () => {
+      const queries = [
+        new Float32Array([1, 0, 0, 0]),
+        new Float32Array([0, 1, 0, 0]),
+        new Float32Array([0, 0, 1, 0]),
+        new Float32Array([1, 1, 0, 0]),
+      ];
+      const ks = [1, 3, 5, 2];
+      const expected = [];
+      for (let i = 0; i < queries.length; i++) {
+        expected.push(await index.search(queries[i], ks[i]));
+      }
+
+      index.setSearchCoalescing({ maxBatchSize: 3, windowMs: 5 });
+      const results = await Promise.all(queries.map((query, i) => index.search(query, ks[i])));
+
+      results.forEach((result, i) => {
+        expect(result.labels).toBeInstanceOf(Int32Array);
+        expect(result.labels.length).toBe(ks[i]);
+        expect(Array.from(result.labels)).toEqual(Array.from(expected[i].labels));
+        expect(Array.from(result.distances)).toEqual(Array.from(expected[i].distances));
+      });
+    });
+
+    test('settles every search submitted while a batch is in flight', async () => {
+      index.setSearchCoalescing({ maxBatchSize: 3, windowMs: 5 });
+
+      // The first three fill a batch immediately; the rest arrive while it runs
+      const inFlight = [0, 1, 2].map(i => index.search(vectors.subarray(i * dims, (i + 1) * dims), 1));
+      await new Promise(resolve => setImmediate(resolve));
+      const queued = [];
+      for (let i = 0; i < 20; i++) {
+        const id = i % 5;
+        queued.push(index.search(vectors.subarray(id * dims, (id + 1) * dims), 1));
+      }
+
+      const first = await Promise.all(inFlight);
+      first.forEach((result, i) => expect(result.labels[0]).toBe(i));
+      const rest = await Promise.all(queued);
+      rest.forEach((result, i) => expect(result.labels[0]).toBe(i % 5));
+    });
+
+    test('accepts coalesce in the constructor and can be disabled', async () => {
+      const coalesced = new FaissIndex({ type: 'FLAT_L2', dims, coalesce: true });
+      await coalesced.add(vectors);
+
+      const result = await coalesced.search(new Float32Array([0, 0, 0, 1]), 1);
+      expect(result.labels[0]).toBe(3);
+
+      coalesced.setSearchCoalescing(false);
+      const again = await coalesced.search(new Float32Array([0, 0, 0, 1]), 1);
+      expect(again.labels[0]).toBe(3);
+      coalesced.dispose();
+    });
+
+    test('rejects invalid coalescing options', () => {
+      expect(() => index.setSearchCoalescing({ maxBatchSize: 0 })).toThrow();
+      expect(() => index.setSearchCoalescing({ windowMs: -1 })).toThrow();
+      expect(() => new FaissIndex({ dims, coalesce: 'yes' })).toThrow();
+    });
+  });
 });
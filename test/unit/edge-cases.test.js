@@ -112,6 +112,24 @@ describe('FaissIndex - Edge Cases', () => {
       await expect(index.add(vectors)).rejects.toThrow(InvalidVectorError);
     });
 
+    test('validateInWorker rejects non-finite values from the worker thread', async () => {
+      const index = new FaissIndex({ dims: 4, validateInWorker: true });
+      const bad = new Float32Array([1, 0, 0, 0, 0, NaN, 0, 0]);
+
+      await expect(index.add(bad)).rejects.toThrow(InvalidVectorError);
+      await expect(index.add(bad, null, { borrow: true })).rejects.toThrow(/NaN or Infinity/);
+      expect(index.getStats().ntotal).toBe(0);
+
+      await index.add(bad.subarray(0, 4));
+      await expect(index.searchBatch(bad, 1)).rejects.toThrow(InvalidVectorError);
+      await expect(index.search(new Float32Array([0, Infinity, 0, 0]), 1)).rejects.toThrow(InvalidVectorError);
+
+      index.setSearchCoalescing(true);
+      await expect(index.search(new Float32Array([0, Infinity, 0, 0]), 1)).rejects.toThrow(InvalidVectorError);
+      await expect(index.add(bad, null, { validateInWorker: false })).rejects.toThrow(/vectors contains NaN/);
+      index.dispose();
+    });
+
     test('handles vectors with very large values', async () => {
       const index = new FaissIndex({ dims: 4 });
       const vectors = new Float32Array([
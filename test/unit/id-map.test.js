@@ -0,0 +1,92 @@
+const {
+  FaissIndex,
+  UnsupportedOperationError,
+  ValidationError,
+} = require('../../src/js');
+
+const vectors = new Float32Array([
+  1, 0, 0, 0,
+  0, 1, 0, 0,
+  0, 0, 1, 0,
+  0, 0, 0, 1,
+]);
+const ids = new BigInt64Array([10n, 2n ** 40n, 7n, 9007199254740993n]);
+
+describe('Custom 64-bit ids (idMap)', () => {
+  test('flat index returns caller ids as BigInt64Array labels', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4, idMap: true });
+    await index.add(vectors, ids);
+
+    const results = await index.search(new Float32Array([0, 1, 0, 0]), 2);
+    expect(results.labels).toBeInstanceOf(BigInt64Array);
+    expect(results.labels[0]).toBe(2n ** 40n);
+    expect(index.getStats().idMap).toBe(true);
+
+    const batch = await index.searchBatch(new Float32Array([0, 0, 0, 1, 0, 0, 1, 0]), 1);
+    expect(Array.from(batch.labels)).toEqual([9007199254740993n, 7n]);
+
+    index.dispose();
+  });
+
+  test('reconstruct and removeIds accept caller ids', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4, idMap: true });
+    await index.add(vectors, ids);
+
+    expect(Array.from(await index.reconstruct(7n))).toEqual([0, 0, 1, 0]);
+    expect(Array.from(await index.reconstructBatch([10, 9007199254740993n]))).toEqual([
+      1, 0, 0, 0,
+      0, 0, 0, 1,
+    ]);
+
+    const removed = await index.removeIds([2n ** 40n]);
+    expect(removed).toBe(1);
+    expect(index.getVectorCount()).toBe(3);
+
+    const results = await index.search(new Float32Array([0, 1, 0, 0]), 3);
+    expect(Array.from(results.labels)).not.toContain(2n ** 40n);
+    await expect(index.reconstruct(7n)).resolves.toBeInstanceOf(Float32Array);
+
+    index.dispose();
+  });
+
+  test('IVF index stores ids natively and supports removal', async () => {
+    const index = new FaissIndex({ type: 'IVF_FLAT', dims: 4, nlist: 2, nprobe: 2, idMap: true });
+    await index.train(vectors);
+    await index.add(vectors, [100, 200, 300, 400]);
+
+    const results = await index.search(new Float32Array([0, 0, 1, 0]), 1);
+    expect(results.labels[0]).toBe(300n);
+    expect(Array.from(await index.reconstruct(400))).toEqual([0, 0, 0, 1]);
+
+    expect(await index.removeIds([100])).toBe(1);
+    expect(index.getVectorCount()).toBe(3);
+
+    index.dispose();
+  });
+
+  test('id-mapped indexes survive serialization', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4, idMap: true });
+    await index.add(vectors, ids);
+
+    const restored = await FaissIndex.fromBuffer(await index.toBuffer());
+    const results = await restored.search(new Float32Array([1, 0, 0, 0]), 1);
+    expect(restored.getStats().idMap).toBe(true);
+    expect(results.labels[0]).toBe(10n);
+
+    index.dispose();
+    restored.dispose();
+  });
+
+  test('validates ids', async () => {
+    const plain = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+    await expect(plain.add(vectors, ids)).rejects.toThrow(UnsupportedOperationError);
+    plain.dispose();
+
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4, idMap: true });
+    await expect(index.add(vectors)).rejects.toThrow(ValidationError);
+    await expect(index.add(vectors, [1n, 2n])).rejects.toThrow(ValidationError);
+    await expect(index.add(vectors, [1, 2, 3, -4])).rejects.toThrow(ValidationError);
+    expect(() => new FaissIndex({ dims: 4, idMap: 'yes' })).toThrow(ValidationError);
+    index.dispose();
+  });
+});
@@ -239,6 +239,37 @@ describe('Range Search', () => {
     expect(results.lims[1]).toBeGreaterThan(0);
     expect(results.distances.length).toBe(results.labels.length);
   });
+
+  it('should range search a batch of queries in lims layout', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+    const vectors = new Float32Array([
+      1, 0, 0, 0,
+      0, 1, 0, 0,
+      0, 0, 1, 0,
+      0, 0, 0, 1
+    ]);
+    await index.add(vectors);
+
+    const queries = new Float32Array([
+      1, 0, 0, 0,
+      0, 0, 0, 1,
+      9, 9, 9, 9
+    ]);
+    const batch = await index.rangeSearchBatch(queries, 0.5);
+    expect(batch.nq).toBe(3);
+    expect(batch.lims).toBeInstanceOf(BigUint64Array);
+    expect(Array.from(batch.lims, Number)).toEqual([0, 1, 2, 2]);
+    expect(Array.from(batch.labels)).toEqual([0, 3]);
+    expect(batch.distances.length).toBe(2);
+
+    // Each query's slice matches a single-query range search
+    const single = await index.rangeSearch(queries.subarray(4, 8), 0.5);
+    expect(Array.from(single.labels)).toEqual([3]);
+
+    await expect(index.rangeSearchBatch(new Float32Array(3), 1)).rejects.toThrow();
+    await expect(index.rangeSearchBatch(queries, -1)).rejects.toThrow();
+    index.dispose();
+  });
 });
 
 describe('Reset Method', () => {
@@ -256,3 +287,58 @@ describe('Reset Method', () => {
     expect(index.getStats().ntotal).toBe(2);
   });
 });
+
+describe('resetAsync and disposeAsync', () => {
+  it('resets off the event loop and drains submitted calls before disposing', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+    await index.add(new Float32Array([1, 0, 0, 0, 0, 1, 0, 0]));
+    await index.resetAsync();
+    expect(index.getStats().ntotal).toBe(0);
+
+    await index.add(new Float32Array([1, 0, 0, 0, 0, 1, 0, 0]));
+    const pending = index.search(new Float32Array([0, 1, 0, 0]), 1);
+    await index.disposeAsync();
+
+    expect(Array.from((await pending).labels)).toEqual([1]);
+    expect(() => index.getStats()).toThrow(/disposed/);
+    await expect(index.disposeAsync()).resolves.toBeUndefined();
+    await expect(index.resetAsync()).rejects.toThrow(/disposed/);
+  });
+
+  it('waits for calls submitted through a swapped-in index', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+    const rebuilt = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+    await rebuilt.add(new Float32Array([1, 0, 0, 0, 0, 1, 0, 0]));
+
+    const pending = rebuilt.search(new Float32Array([0, 1, 0, 0]), 1);
+    index.swap(rebuilt);
+    await index.disposeAsync();
+
+    expect(Array.from((await pending).labels)).toEqual([1]);
+  });
+});
+
+describe('swap', () => {
+  it('publishes a rebuilt index while earlier searches finish on the old one', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+    await index.add(new Float32Array([1, 0, 0, 0, 0, 1, 0, 0]));
+    const query = new Float32Array([0, 0, 1, 0]);
+    const before = index.search(query, 1);
+
+    const rebuilt = new FaissIndex({ type: 'FLAT_IP', dims: 4 });
+    await rebuilt.add(new Float32Array([0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1]));
+    expect(index.swap(rebuilt)).toBe(index);
+
+    expect((await before).labels.length).toBe(1);
+    expect(index.getStats().ntotal).toBe(3);
+    expect(index.getStats().metric).toBe('ip');
+    expect(() => rebuilt.getStats()).toThrow(/disposed/);
+
+    const other = new FaissIndex({ type: 'FLAT_L2', dims: 8 });
+    expect(() => index.swap(other)).toThrow(/same dimensions/);
+    expect(() => index.swap(index)).toThrow(/itself/);
+
+    index.dispose();
+    other.dispose();
+  });
+});
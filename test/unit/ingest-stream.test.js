@@ -0,0 +1,104 @@
+const { Readable } = require('stream');
+const { pipeline } = require('stream/promises');
+const { FaissIndex, configureExecutor, getExecutorStats } = require('../../src/js/index');
+
+function* chunks(count, batchSize, dims) {
+  for (let start = 0; start < count; start += batchSize) {
+    const n = Math.min(batchSize, count - start);
+    const chunk = new Float32Array(n * dims);
+    for (let i = 0; i < n; i++) {
+      chunk[i * dims + ((start + i) % dims)] = start + i + 1;
+    }
+    yield chunk;
+  }
+}
+
+describe('createIngestStream', () => {
+  test('adds every chunk through the native pipeline', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+    const ingest = index.createIngestStream({ queueDepth: 2 });
+
+    await pipeline(Readable.from(chunks(103, 10, 4)), ingest);
+
+    expect(ingest.added).toBe(103);
+    expect(index.getStats().ntotal).toBe(103);
+    expect(Array.from(await index.reconstruct(102))).toEqual([0, 0, 103, 0]);
+    index.dispose();
+  });
+
+  test('normalizes vectors when asked', async () => {
+    const index = new FaissIndex({ type: 'FLAT_IP', dims: 4 });
+    const ingest = index.createIngestStream({ normalize: true });
+
+    await pipeline(Readable.from([new Float32Array([3, 0, 4, 0, 0, 0, 0, 0])]), ingest);
+
+    const first = await index.reconstruct(0);
+    expect(first[0]).toBeCloseTo(0.6, 6);
+    expect(first[2]).toBeCloseTo(0.8, 6);
+    expect(Array.from(await index.reconstruct(1))).toEqual([0, 0, 0, 0]);
+    index.dispose();
+  });
+
+  test('normalize without validate passes non-finite vectors through', async () => {
+    const index = new FaissIndex({ type: 'FLAT_IP', dims: 2 });
+    const ingest = index.createIngestStream({ normalize: true, validate: false });
+
+    await pipeline(Readable.from([new Float32Array([NaN, 1, 0, 2])]), ingest);
+
+    expect(ingest.added).toBe(2);
+    expect(Number.isNaN((await index.reconstruct(0))[0])).toBe(true);
+    expect(Array.from(await index.reconstruct(1))).toEqual([0, 1]);
+    index.dispose();
+  });
+
+  test('fails the stream on invalid vectors', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+
+    const bad = [new Float32Array([1, 2, 3, 4]), new Float32Array([1, NaN, 3, 4])];
+    await expect(pipeline(Readable.from(bad), index.createIngestStream())).rejects.toThrow(/Vector 1 contains NaN/);
+
+    await expect(pipeline(Readable.from([new Float32Array(3)]), index.createIngestStream()))
+      .rejects.toThrow(/multiple of 4/);
+    expect(() => index.createIngestStream({ queueDepth: 0 })).toThrow(/queueDepth/);
+    index.dispose();
+  });
+
+  test('open streams hold no executor threads while they wait for input', async () => {
+    const before = getExecutorStats().background.threads;
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+    const streams = [];
+    try {
+      configureExecutor({ background: 1 });
+      for (let i = 0; i < 4; i++) {
+        const ingest = index.createIngestStream({ queueDepth: 1 });
+        await new Promise((resolve, reject) => ingest.write(new Float32Array([i, 0, 0, 0]), (error) => (
+          error ? reject(error) : resolve())));
+        streams.push(ingest);
+      }
+
+      // With one background thread, this only completes if no stream is parked on it
+      await index.add(new Float32Array([0, 0, 0, 1]));
+
+      for (const ingest of streams) {
+        ingest.end();
+        await new Promise((resolve, reject) => ingest.on('finish', resolve).on('error', reject));
+        expect(ingest.added).toBe(1);
+      }
+      expect(index.getStats().ntotal).toBe(5);
+    } finally {
+      configureExecutor({ background: before });
+      index.dispose();
+    }
+  });
+
+  test('adds every chunk through a one-batch queue', async () => {
+    const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+    const ingest = index.createIngestStream({ queueDepth: 1 });
+
+    await pipeline(Readable.from(chunks(400, 2, 4)), ingest);
+
+    expect(ingest.added).toBe(400);
+    expect(Array.from(await index.reconstruct(399))).toEqual([0, 0, 0, 400]);
+    index.dispose();
+  });
+});
@@ -166,6 +166,37 @@ describe('IndexIVFFlat', () => {
             expect(results1.distances.length).toBe(5);
             expect(results2.distances.length).toBe(5);
         });
+
+        test('per-call nprobe overrides without changing the index', async () => {
+            const index = new FaissIndex({ type: 'IVF_FLAT', dims: 8, nlist: 16, nprobe: 1 });
+            const exact = new FaissIndex({ dims: 8 });
+            const vectors = new Float32Array(500 * 8);
+            for (let i = 0; i < vectors.length; i++) {
+                vectors[i] = Math.random();
+            }
+            await index.train(vectors);
+            await index.add(vectors);
+            await exact.add(vectors);
+
+            const queries = vectors.slice(0, 20 * 8);
+            const expected = await exact.searchBatch(queries, 5);
+            const [fast, accurate] = await Promise.all([
+                index.searchBatch(queries, 5),
+                index.searchBatch(queries, 5, { nprobe: 16 }),
+            ]);
+
+            // Visiting every list makes IVF exhaustive
+            expect(Array.from(accurate.labels)).toEqual(Array.from(expected.labels));
+            expect(fast.labels.length).toBe(accurate.labels.length);
+            const again = await index.searchBatch(queries, 5);
+            expect(Array.from(again.labels)).toEqual(Array.from(fast.labels));
+
+            await expect(index.search(queries.subarray(0, 8), 5, { nprobe: 0 })).rejects.toThrow();
+            await expect(index.search(queries.subarray(0, 8), 5, { maxCodes: 1.5 })).rejects.toThrow();
+
+            index.dispose();
+            exact.dispose();
+        });
     });
 
     describe('Edge Cases', () => {
@@ -287,9 +318,23 @@ describe('IndexHNSW', () => {
             
             const query = new Float32Array([1, 0, 0, 0]);
             const results = await index.search(query, 50);
-            
+
             expect(results.distances.length).toBe(50);
         });
+
+        test('accepts a per-call efSearch', async () => {
+            const index = new FaissIndex({ type: 'HNSW', dims: 4, efSearch: 16 });
+            const vectors = new Float32Array(Array(400).fill(0).map((_, i) => (i % 7) / 7));
+            await index.add(vectors);
+
+            const query = new Float32Array([1, 0, 0, 0]);
+            const wide = await index.search(query, 10, { efSearch: 256 });
+            expect(wide.labels.length).toBe(10);
+            expect(Array.from(wide.labels).every(label => label >= 0)).toBe(true);
+            await expect(index.search(query, 10, { efSearch: -5 })).rejects.toThrow();
+
+            index.dispose();
+        });
     });
 
     describe('Edge Cases', () => {
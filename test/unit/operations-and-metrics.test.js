@@ -1,6 +1,11 @@
 const {
   FaissIndex,
   GpuNotAvailableError,
+  ValidationError,
+  setNumThreads,
+  getNumThreads,
+  configureExecutor,
+  getExecutorStats,
 } = require('../../src/js');
 
 describe('Enhanced index operations', () => {
@@ -35,6 +40,30 @@ describe('Enhanced index operations', () => {
     expect(Array.from(reconstructed)).toEqual([1, 0, 0, 0, 0, 0, 1, 0]);
   });
 
+  test('reconstructBatch decodes large batches into a reusable output array', async () => {
+    const dims = 8;
+    const count = 200;
+    const index = new FaissIndex({ type: 'FLAT_L2', dims });
+    const vectors = new Float32Array(count * dims).map((_, i) => i % 97);
+    await index.add(vectors);
+
+    const ids = Array.from({ length: count }, (_, i) => count - 1 - i);
+    const scratch = new Float32Array((count + 1) * dims);
+    const first = await index.reconstructBatch(ids, scratch);
+    expect(first.buffer).toBe(scratch.buffer);
+    expect(first.length).toBe(count * dims);
+    for (const i of [0, 73, count - 1]) {
+      expect(Array.from(first.subarray(i * dims, (i + 1) * dims)))
+        .toEqual(Array.from(await index.reconstruct(ids[i])));
+    }
+
+    const second = await index.reconstructBatch([0, 1], scratch);
+    expect(Array.from(second)).toEqual(Array.from(vectors.subarray(0, 2 * dims)));
+
+    await expect(index.reconstructBatch([0, 1], new Float32Array(dims))).rejects.toThrow(/at least/);
+    await expect(index.reconstructBatch([0], new Float64Array(dims))).rejects.toThrow(/Float32Array/);
+  });
+
   test('removeIds works for flat indexes', async () => {
     const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
     const vectors = new Float32Array([
@@ -111,6 +140,40 @@ describe('Metrics, validation, and progress helpers', () => {
     expect(index.getVectorCount()).toBe(4);
   });
 
+  test('addWithProgress builds HNSW natively and stops when aborted', async () => {
+    const index = new FaissIndex({ type: 'HNSW', dims: 4 });
+    const vectors = new Float32Array(64 * 4).map((_, i) => Math.sin(i));
+
+    const progress = [];
+    await index.addWithProgress(vectors, {
+      batchSize: 16,
+      onProgress(update) {
+        progress.push(update);
+      },
+    });
+    expect(progress.map((update) => update.processed)).toEqual([16, 32, 48, 64]);
+    expect(progress[3].etaMs).toBe(0);
+    expect(index.getVectorCount()).toBe(64);
+
+    const controller = new AbortController();
+    const batches = [];
+    const aborted = index.addWithProgress(vectors, {
+      batchSize: 16,
+      signal: controller.signal,
+      onProgress(update) {
+        batches.push(update.batch);
+        controller.abort();
+      },
+    });
+    await expect(aborted).rejects.toThrow(/abort/i);
+    expect(batches).toEqual([1]);
+    expect(index.getVectorCount()).toBe(80);
+
+    await expect(index.addWithProgress(vectors, { signal: controller.signal })).rejects.toThrow(/abort/i);
+    expect(index.getVectorCount()).toBe(80);
+    index.dispose();
+  });
+
   test('inspect returns human-readable text', async () => {
     const index = new FaissIndex({ type: 'FLAT_IP', dims: 4 });
     const text = index.inspect({ format: 'text' });
@@ -125,4 +188,61 @@ describe('Metrics, validation, and progress helpers', () => {
     expect(FaissIndex.gpuSupport().available).toBe(false);
     await expect(index.toGpu()).rejects.toBeInstanceOf(GpuNotAvailableError);
   });
+
+  test('thread controls apply per process, per index and per call', async () => {
+    const defaultThreads = getNumThreads().threads;
+    expect(defaultThreads).toBeGreaterThan(0);
+
+    try {
+      setNumThreads(1);
+      expect(getNumThreads()).toEqual({ threads: 1, configured: 1, openmp: true });
+
+      const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+      expect(index.getStats().numThreads).toBe(1);
+      await index.add(new Float32Array([1, 0, 0, 0, 0, 1, 0, 0]), null, { threads: 2 });
+      const results = await index.searchBatch(new Float32Array([1, 0, 0, 0]), 1, { threads: 2 });
+      expect(Array.from(results.labels)).toEqual([0]);
+      await expect(index.search(new Float32Array([1, 0, 0, 0]), 1, { threads: 0 }))
+        .rejects.toBeInstanceOf(ValidationError);
+      expect(() => index._native.add(new Float32Array(4), { threads: NaN })).toThrow(/positive integer/);
+
+      const pinned = new FaissIndex({ type: 'FLAT_L2', dims: 4, threads: 3 });
+      expect(pinned.getStats().numThreads).toBe(3);
+      expect(() => new FaissIndex({ type: 'FLAT_L2', dims: 4, threads: 1.5 })).toThrow(ValidationError);
+      expect(() => setNumThreads(-1)).toThrow(ValidationError);
+    } finally {
+      setNumThreads(0);
+    }
+
+    expect(getNumThreads()).toEqual({ threads: defaultThreads, configured: 0, openmp: true });
+  });
+
+  test('index work runs on resizable executor lanes that report queue depth and wait', async () => {
+    const before = getExecutorStats();
+    expect(before.interactive.threads).toBeGreaterThan(0);
+    expect(before.background.threads).toBeGreaterThan(0);
+
+    try {
+      configureExecutor({ interactive: 2, background: 1 });
+      const index = new FaissIndex({ type: 'FLAT_L2', dims: 4 });
+      await index.add(new Float32Array([1, 0, 0, 0, 0, 1, 0, 0]));
+      const searches = [];
+      for (let i = 0; i < 8; i++) {
+        searches.push(index.search(new Float32Array([0, 1, 0, 0]), 1));
+      }
+      const results = await Promise.all(searches);
+      expect(results.every((r) => r.labels[0] === 1)).toBe(true);
+
+      const after = getExecutorStats();
+      expect(after.interactive.threads).toBe(2);
+      expect(after.background.threads).toBe(1);
+      expect(after.interactive.completed - before.interactive.completed).toBeGreaterThanOrEqual(8);
+      expect(after.background.completed - before.background.completed).toBeGreaterThanOrEqual(1);
+      expect(after.interactive.queued).toBe(0);
+      expect(after.interactive.maxWaitMs).toBeGreaterThanOrEqual(after.interactive.avgWaitMs);
+      expect(() => configureExecutor({ interactive: 0 })).toThrow(ValidationError);
+    } finally {
+      configureExecutor({ interactive: before.interactive.threads, background: before.background.threads });
+    }
+  });
 });
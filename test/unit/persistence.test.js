@@ -98,7 +98,53 @@ describe('FaissIndex - Persistence (Save/Load)', () => {
       const index2 = await FaissIndex.load(filename);
       expect(index2.getStats().ntotal).toBe(nVectors);
     });
-    
+
+    test('mmap load serves searches and rejects mutations', async () => {
+      const index1 = new FaissIndex({ type: 'IVF_FLAT', dims: 8, nlist: 4, nprobe: 4 });
+      const vectors = new Float32Array(200 * 8);
+      for (let i = 0; i < vectors.length; i++) {
+        vectors[i] = Math.random();
+      }
+      await index1.train(vectors);
+      await index1.add(vectors);
+
+      const filename = path.join(testDir, 'test-mmap.faiss');
+      await index1.save(filename);
+
+      const replica = await FaissIndex.load(filename, { mmap: true, readOnly: true });
+      const stats = replica.getStats();
+      expect(stats.ntotal).toBe(200);
+      expect(stats.mmap).toBe(true);
+      expect(stats.readOnly).toBe(true);
+
+      const query = vectors.subarray(0, 8);
+      const expected = await index1.search(query, 5);
+      const actual = await replica.search(query, 5);
+      expect(Array.from(actual.labels)).toEqual(Array.from(expected.labels));
+
+      await expect(replica.add(query)).rejects.toThrow('read-only');
+      await expect(replica.removeIds([0])).rejects.toThrow('read-only');
+      expect(() => replica.reset()).toThrow('read-only');
+
+      const heapReadOnly = await FaissIndex.load(filename, { readOnly: true });
+      expect(heapReadOnly.getStats().mmap).toBe(false);
+      await expect(heapReadOnly.train(vectors)).rejects.toThrow('read-only');
+
+      const flat = new FaissIndex({ type: 'FLAT_L2', dims: 8 });
+      await flat.add(vectors);
+      const flatFile = path.join(testDir, 'test-mmap-flat.faiss');
+      await flat.save(flatFile);
+      const flatLoaded = await FaissIndex.load(flatFile, { mmap: true });
+      expect(flatLoaded.getStats().mmap).toBe(false);
+      expect(flatLoaded.getStats().readOnly).toBe(true);
+
+      index1.dispose();
+      replica.dispose();
+      heapReadOnly.dispose();
+      flat.dispose();
+      flatLoaded.dispose();
+    });
+
     test('throws on invalid filename', async () => {
       await expect(FaissIndex.load(null)).rejects.toThrow();
       await expect(FaissIndex.load('')).rejects.toThrow();
@@ -146,7 +192,28 @@ describe('FaissIndex - Persistence (Save/Load)', () => {
       
       expect(index2.getStats().ntotal).toBe(nVectors);
     });
-    
+
+    test('serialized buffer outlives the source index and parses from a slice', async () => {
+      const index1 = new FaissIndex({ dims: 8 });
+      const vectors = new Float32Array(30 * 8);
+      for (let i = 0; i < vectors.length; i++) {
+        vectors[i] = Math.random();
+      }
+      await index1.add(vectors);
+
+      const buffer = await index1.toBuffer();
+      index1.dispose();
+
+      // Embed the bytes at a non-zero offset, as when read from a larger payload
+      const framed = Buffer.alloc(buffer.length + 16);
+      buffer.copy(framed, 7);
+      const index2 = await FaissIndex.fromBuffer(framed.subarray(7, 7 + buffer.length));
+      expect(index2.getStats().ntotal).toBe(30);
+
+      await expect(FaissIndex.fromBuffer(buffer.subarray(0, buffer.length - 4))).rejects.toThrow();
+      index2.dispose();
+    });
+
     test('throws on invalid buffer', async () => {
       await expect(FaissIndex.fromBuffer(null)).rejects.toThrow();
       await expect(FaissIndex.fromBuffer('string')).rejects.toThrow();
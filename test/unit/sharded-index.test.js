@@ -0,0 +1,134 @@
+const {
+  FaissIndex,
+  FaissShardedIndex,
+  UnsupportedOperationError,
+  ValidationError,
+} = require('../../src/js');
+
+function randomVectors(count, dims, seed) {
+  const out = new Float32Array(count * dims);
+  let state = seed;
+  for (let i = 0; i < out.length; i++) {
+    state = (state * 1103515245 + 12345) % 2147483648;
+    out[i] = state / 2147483648;
+  }
+  return out;
+}
+
+describe('FaissShardedIndex', () => {
+  const dims = 8;
+  const data = randomVectors(200, dims, 7);
+  const queries = randomVectors(5, dims, 11);
+
+  test('merged search matches a single flat index', async () => {
+    const sharded = new FaissShardedIndex({ type: 'FLAT_L2', dims, shards: 4 });
+    const flat = new FaissIndex({ type: 'FLAT_L2', dims });
+    await sharded.add(data);
+    await flat.add(data);
+
+    const stats = sharded.getStats();
+    expect(stats.shards).toBe(4);
+    expect(stats.ntotal).toBe(200);
+    expect(stats.shardSizes.reduce((a, b) => a + b, 0)).toBe(200);
+    expect(stats.shardSizes.every((size) => size > 0)).toBe(true);
+
+    const expected = await flat.searchBatch(queries, 10);
+    const actual = await sharded.searchBatch(queries, 10);
+    expect(actual.labels).toBeInstanceOf(BigInt64Array);
+    expect(Array.from(actual.labels, Number)).toEqual(Array.from(expected.labels));
+    for (let i = 0; i < expected.distances.length; i++) {
+      expect(actual.distances[i]).toBeCloseTo(expected.distances[i], 4);
+    }
+
+    sharded.dispose();
+    flat.dispose();
+  });
+
+  test('caller ids route to one shard for reconstruct and removal', async () => {
+    const index = new FaissShardedIndex({ type: 'FLAT_L2', dims, shards: 3 });
+    const ids = Array.from({ length: 20 }, (_, i) => 1000 + i * 7);
+    await index.add(data.subarray(0, 20 * dims), ids);
+
+    expect(Array.from(await index.reconstruct(1007))).toEqual(Array.from(data.subarray(dims, 2 * dims)));
+    expect(await index.removeIds([1000, 1007, 5])).toBe(2);
+    expect(index.getVectorCount()).toBe(18);
+
+    const results = await index.search(data.subarray(dims, 2 * dims), 1);
+    expect(results.labels[0]).not.toBe(1007n);
+
+    index.dispose();
+  });
+
+  test('round-trips through toBuffer and swaps a rebuilt shard', async () => {
+    const index = new FaissShardedIndex({ type: 'FLAT_L2', dims, shards: 2 });
+    await index.add(data.subarray(0, 50 * dims));
+
+    const restored = await FaissShardedIndex.fromBuffer(await index.toBuffer());
+    expect(restored).toBeInstanceOf(FaissShardedIndex);
+    expect(restored.getStats().shardSizes).toEqual(index.getStats().shardSizes);
+    const before = await index.searchBatch(queries, 5);
+    const after = await restored.searchBatch(queries, 5);
+    expect(Array.from(after.labels)).toEqual(Array.from(before.labels));
+
+    // Ids continue from the saved counter rather than restarting at 0
+    await restored.add(data.subarray(50 * dims, 51 * dims));
+    expect(restored.getStats().nextId).toBe(51);
+
+    const shard = await FaissIndex.fromBuffer(await restored.shardToBuffer(0));
+    expect(shard.getVectorCount()).toBe(restored.getStats().shardSizes[0]);
+    await restored.replaceShard(1, shard);
+    expect(restored.getStats().shardSizes[1]).toBe(shard.getVectorCount());
+
+    index.dispose();
+    restored.dispose();
+    shard.dispose();
+  });
+
+  test('replicas return the same results and all receive writes', async () => {
+    const replicated = new FaissShardedIndex({ type: 'FLAT_L2', dims, shards: 1, replicas: 3 });
+    const flat = new FaissIndex({ type: 'FLAT_L2', dims });
+    await replicated.add(data);
+    await flat.add(data);
+    expect(replicated.getStats().replicas).toBe(3);
+
+    const expected = await flat.searchBatch(queries, 5);
+    const results = await Promise.all(Array.from({ length: 6 }, () => replicated.searchBatch(queries, 5)));
+    for (const result of results) {
+      expect(Array.from(result.labels, Number)).toEqual(Array.from(expected.labels));
+    }
+
+    await replicated.removeIds([expected.labels[0]]);
+    const afterRemoval = await Promise.all(
+      Array.from({ length: 6 }, () => replicated.search(queries.subarray(0, dims), 1))
+    );
+    for (const result of afterRemoval) {
+      expect(result.labels[0]).not.toBe(BigInt(expected.labels[0]));
+    }
+
+    const restored = await FaissShardedIndex.fromBuffer(await replicated.toBuffer(), { replicas: 2 });
+    expect(restored.getStats().replicas).toBe(2);
+    expect(restored.getVectorCount()).toBe(199);
+
+    replicated.dispose();
+    restored.dispose();
+    flat.dispose();
+  });
+
+  test('validates shard counts and rejects unsupported operations', async () => {
+    expect(() => new FaissShardedIndex({ type: 'FLAT_L2', dims })).toThrow(ValidationError);
+    expect(() => new FaissShardedIndex({ type: 'FLAT_L2', dims, shards: 0 })).toThrow(ValidationError);
+    expect(() => new FaissShardedIndex({ type: 'FLAT_L2', dims, shards: 1, replicas: 0 })).toThrow(ValidationError);
+
+    const index = new FaissShardedIndex({ type: 'FLAT_L2', dims, shards: 2 });
+    await expect(index.rangeSearch(queries.subarray(0, dims), 1)).rejects.toThrow(UnsupportedOperationError);
+    expect(() => index.setSearchCoalescing(true)).toThrow(UnsupportedOperationError);
+    await expect(index.shardToBuffer(2)).rejects.toThrow(ValidationError);
+
+    const plain = new FaissIndex({ type: 'FLAT_L2', dims });
+    await expect(plain.mergeFrom(index)).rejects.toThrow(UnsupportedOperationError);
+    expect(() => plain._native.mergeFrom(index._native)).toThrow(/Expected FaissIndex/);
+    plain.dispose();
+
+    index.dispose();
+  });
+});
@@ -3,6 +3,12 @@ const {
   validateVectors,
   splitVectors,
   computeDistances,
+  pairwiseDistances,
+  knn,
+  hammingDistances,
+  hammingKnn,
+  FaissIndex,
+  FaissBinaryIndex,
 } = require('../../src/js');
 
 describe('Vector utilities', () => {
@@ -26,6 +32,31 @@ describe('Vector utilities', () => {
     expect(report.nonFinite[0].vectorIndex).toBe(0);
   });
 
+  test('validateVectors and normalizeVectors handle vector tails and zero vectors', () => {
+    const dims = 37;
+    const vectors = new Float32Array(dims * 4).map((_, i) => (i % 7) - 3);
+    vectors.fill(0, dims, 2 * dims);
+    vectors[2 * dims + 36] = Number.POSITIVE_INFINITY;
+    vectors[3 * dims] = Number.NaN;
+    vectors.fill(0, 3 * dims + 1, 4 * dims);
+
+    const report = validateVectors(vectors, dims);
+    expect(report.nonFinite).toEqual([
+      { vectorIndex: 2, componentIndex: 36, value: Number.POSITIVE_INFINITY },
+      { vectorIndex: 3, componentIndex: 0, value: Number.NaN },
+    ]);
+    expect(report.zeroNormIndices).toEqual([1, 3]);
+
+    expect(() => normalizeVectors(vectors, dims)).toThrow(
+      expect.objectContaining({ details: { vectorIndex: 2, componentIndex: 36, value: Number.POSITIVE_INFINITY } })
+    );
+
+    const normalized = normalizeVectors(vectors.subarray(0, 2 * dims), dims);
+    const norm = Math.hypot(...normalized.subarray(0, dims));
+    expect(norm).toBeCloseTo(1, 5);
+    expect(Array.from(normalized.subarray(dims)).every((value) => value === 0)).toBe(true);
+  });
+
   test('splitVectors returns chunked views', () => {
     const vectors = new Float32Array([
       1, 0, 0, 0,
@@ -49,4 +80,94 @@ describe('Vector utilities', () => {
     expect(l2[0]).toBeCloseTo(2, 5);
     expect(cosine[0]).toBeCloseTo(0, 5);
   });
+
+  test('pairwiseDistances returns the n x m matrix for every metric', async () => {
+    const dims = 5;
+    const left = new Float32Array(3 * dims).map((_, i) => Math.sin(i));
+    const right = new Float32Array(4 * dims).map((_, i) => Math.cos(i));
+    right.fill(0, 0, dims);
+
+    for (const metric of ['l2', 'ip', 'cosine']) {
+      const matrix = await pairwiseDistances(left, right, { dims, metric });
+      expect(matrix).toBeInstanceOf(Float32Array);
+      expect(matrix).toHaveLength(12);
+
+      for (let i = 0; i < 3; i++) {
+        const row = computeDistances(left.subarray(i * dims, (i + 1) * dims), right, { dims, metric });
+        for (let j = 0; j < 4; j++) {
+          expect(matrix[i * 4 + j]).toBeCloseTo(row[j], 4);
+        }
+      }
+    }
+
+    // Enough rows to take the BLAS path
+    const many = new Float32Array(64 * dims).map((_, i) => (i % 11) / 11);
+    const l2 = await pairwiseDistances(many, many, { dims });
+    expect(l2).toHaveLength(64 * 64);
+    expect(l2[5 * 64 + 5]).toBeCloseTo(0, 4);
+    expect(l2[1 * 64 + 2]).toBeCloseTo(computeDistances(many.subarray(5, 10), many.subarray(10, 15), { dims })[0], 4);
+
+    await expect(pairwiseDistances(left, right, { dims: 4 })).rejects.toThrow(/multiple/);
+    await expect(pairwiseDistances(left, right, { dims, metric: 'hamming' })).rejects.toThrow(/metric/);
+  });
+
+  test('knn matches a flat index searchBatch without building one', async () => {
+    const dims = 8;
+    const database = new Float32Array(50 * dims).map((_, i) => Math.sin(i * 0.37));
+    const queries = database.slice(3 * dims, 6 * dims);
+
+    const index = new FaissIndex({ type: 'FLAT_L2', dims });
+    await index.add(database);
+    const expected = await index.searchBatch(queries, 4);
+    index.dispose();
+
+    const result = await knn(queries, database, 4, { dims });
+    expect(result.nq).toBe(3);
+    expect(result.k).toBe(4);
+    expect(Array.from(result.labels)).toEqual(Array.from(expected.labels));
+    expect(Array.from(result.labels.filter((_, i) => i % 4 === 0))).toEqual([3, 4, 5]);
+    result.distances.forEach((value, i) => expect(value).toBeCloseTo(expected.distances[i], 4));
+
+    const ip = await knn(queries, database, 100, { dims, metric: 'ip', labelType: 'bigint' });
+    expect(ip.k).toBe(50);
+    expect(ip.labels).toBeInstanceOf(BigInt64Array);
+    expect(ip.distances[0]).toBeGreaterThanOrEqual(ip.distances[49]);
+
+    const cosine = await knn(queries, database, 1, { dims, metric: 'cosine' });
+    expect(Array.from(cosine.labels)).toEqual([3, 4, 5]);
+    cosine.distances.forEach((value) => expect(value).toBeCloseTo(1, 5));
+
+    await expect(knn(queries, new Float32Array(0), 1, { dims })).rejects.toThrow(/empty/);
+  });
+
+  test('hammingDistances and hammingKnn work on plain Uint8Array codes', async () => {
+    const dims = 24;
+    const database = new Uint8Array(20 * 3).map((_, i) => (i * 37) % 256);
+    const queries = database.slice(6, 12);
+
+    const matrix = await hammingDistances(queries, database, dims);
+    expect(matrix).toBeInstanceOf(Int32Array);
+    expect(matrix).toHaveLength(2 * 20);
+    expect(matrix[2]).toBe(0);
+    expect(matrix[20 + 3]).toBe(0);
+    expect(matrix[1]).toBe([0, 1, 2].reduce((bits, b) => {
+      let v = database[6 + b] ^ database[3 + b];
+      for (; v; v >>= 1) bits += v & 1;
+      return bits;
+    }, 0));
+
+    const index = new FaissBinaryIndex({ type: 'BINARY_FLAT', dims });
+    await index.add(database);
+    const expected = await index.searchBatch(queries, 3);
+    index.dispose();
+
+    const result = await hammingKnn(queries, database, 3, { dims });
+    expect(result).toMatchObject({ nq: 2, k: 3 });
+    expect(result.distances).toBeInstanceOf(Int32Array);
+    expect(Array.from(result.distances)).toEqual(Array.from(expected.distances));
+    expect([result.labels[0], result.labels[3]]).toEqual([2, 3]);
+
+    expect((await hammingKnn(queries, database, 50, { dims })).k).toBe(20);
+    await expect(hammingDistances(queries, database, 12)).rejects.toThrow(/divisible by 8/);
+  });
 });